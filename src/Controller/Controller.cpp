@@ -1,9 +1,9 @@
 #include "Controller.h"
 
 #include "Model/Media/AbstractMedia.h"
-#include "Model/Visitors/ScoreVisitor.h"
 #include "Model/Visitors/MediaValidator.h"
 #include "Model/Library/Manager.h"
+#include "Model/Library/BinarySnapshot.h"
 
 #include "View/Viewer/AudioViewer.h"
 #include "View/Viewer/VideoViewer.h"
@@ -15,6 +15,7 @@
 #include <QMessageBox>
 #include <QString>
 #include <QMap>
+#include <QThread>
 
 #include <stdexcept>
 #include <string>
@@ -27,9 +28,27 @@ namespace Controller {
 
 Controller::Controller(Model::Library::Manager* manager, QObject* parent)
     : QObject(parent),
-    manager(manager)
+    manager(manager),
+    ioThread(nullptr)
 {
     if (!manager) throw std::runtime_error("Manager is 'nullptr'");
+    manager->setLibraryObserver(this);
+}
+
+Controller::~Controller() {
+
+    // il thread secondario usa il manager e il logger del Controller
+    if (ioThread) {
+        ioThread->wait();
+        delete ioThread;
+    }
+    // anche la ricerca in corso usa il manager
+    if (liveSearch.thread) {
+        liveSearch.cancelled->store(true);
+        liveSearch.thread->wait();
+        delete liveSearch.thread;
+    }
+    manager->setLibraryObserver(nullptr);
 }
 
 
@@ -41,6 +60,8 @@ void Controller::initializeCommandSignals() {
     emit redoPossible(manager->canRedoCommand());
 }
 
+bool Controller::isLibraryIOBusy() const { return ioThread != nullptr; }
+
 bool Controller::managerIsEmpty() const {
 
     return(!manager || manager->isEmpty());
@@ -200,6 +221,31 @@ QMap<QString, QString> Controller::UnorderedMapToQMap(const std::unordered_map<s
 }
 
 
+// === OSSERVATORE (ILibraryObserver) ===
+
+// i risultati dell'ultima ricerca non possono piu' essere ristretti dopo una modifica della libreria
+
+void Controller::onMediaInserted(unsigned int ind, unsigned int id) {
+    liveSearch.lastResultsValid = false;
+    emit mediaInserted(ind, id);
+}
+
+void Controller::onMediaRemoved(unsigned int ind, unsigned int id) {
+    liveSearch.lastResultsValid = false;
+    emit mediaRemoved(ind, id);
+}
+
+void Controller::onMediaChanged(unsigned int ind, unsigned int id) {
+    liveSearch.lastResultsValid = false;
+    emit mediaChanged(ind, id);
+}
+
+void Controller::onMediaBatchChanged() {
+    liveSearch.lastResultsValid = false;
+    emit mediaBatchChanged();
+}
+
+
 // === OPERAZIONI INDICE (SLOT) ===
 
 bool Controller::onSetIndexRequest(int ind) {
@@ -251,12 +297,17 @@ bool Controller::onGoToLastIndexRequest() {
 
 void Controller::onEditMediaRequest(unsigned int ind, QMap<QString, QString> mediaEdits) {
 
+    if (isLibraryIOBusy()) {
+        emit editFailure(ind, "Library is being loaded or saved, try again later");
+        return;
+    }
     if (!manager || !validIndex(ind)) {
         emit editFailure(ind, "No media was found at index " + QString::number(ind));
         return;
     }
 
     std::unordered_map<std::string, std::string> edits = QMapToUnorderedMap(mediaEdits);
+    stopLiveSearch();
 
     try {
         bool edited = manager->editMediaAtIndex(ind, edits);
@@ -276,6 +327,12 @@ void Controller::onCreateMediaRequest(
     const std::string& type,
     const std::unordered_map<std::string, std::string>& attributes)
 {
+    if (isLibraryIOBusy()) {
+        emit createFailure("Library is being loaded or saved, try again later");
+        return;
+    }
+    stopLiveSearch();
+
     try {
 
         auto newMedia = manager->createNewMedia(type, attributes);
@@ -297,11 +354,14 @@ void Controller::onCreateMediaRequest(
 
 int Controller::onRemoveMediaAtIndexRequest(unsigned int ind) {
 
+    if (rejectWhileLibraryIO()) return false;
+
     if (!manager || !validIndex(ind)) {
         emit errorOccurred("Failed, as index " + QString::number(ind) + " is not valid");
         return false;
     }
 
+    stopLiveSearch();
     bool removed = manager->removeMediaAtIndex(ind);
     if (removed) emit removedMedia(ind);
     return removed;
@@ -312,7 +372,8 @@ int Controller::onRemoveMediaAtIndexRequest(unsigned int ind) {
 
 void Controller::onUndoRequest() {
 
-    if (!manager) return;
+    if (!manager || rejectWhileLibraryIO()) return;
+    stopLiveSearch();
     manager->undoCommand();
 
     QString info = QString::fromStdString(manager->getLastUndoInfo());
@@ -324,7 +385,8 @@ void Controller::onUndoRequest() {
 
 void Controller::onRedoRequest() {
 
-    if (!manager) return;
+    if (!manager || rejectWhileLibraryIO()) return;
+    stopLiveSearch();
     manager->redoCommand();
 
     QString info = QString::fromStdString(manager->getLastRedoInfo());
@@ -344,7 +406,8 @@ void Controller::onSearchRequest(Model::Library::SearchQuery query) {
         return;
     }
 
-    std::vector<unsigned int> results = manager->searchMedia(query);
+    // la ricerca viene suddivisa tra i core disponibili (per librerie piccole resta seriale)
+    std::vector<unsigned int> results = manager->searchMedia(query, static_cast<unsigned int>(QThread::idealThreadCount()));
     emit searchResults(results);
 }
 
@@ -355,19 +418,183 @@ void Controller::onSearchMediaByNameRequest(const QString& mediaName) {
     onSearchRequest(query);
 }
 
+void Controller::onLiveSearchRequest(const QString& mediaName) {
+
+    if (!manager) return;
+
+    liveSearch.pendingName = mediaName;
+    liveSearch.pending = !mediaName.isEmpty();
+
+    // la ricerca in corso e' superata: viene annullata, e la nuova parte al suo termine
+    if (liveSearch.thread) {
+        liveSearch.cancelled->store(true);
+        return;
+    }
+    if (liveSearch.pending) {
+        startLiveSearch();
+    }
+}
+
+void Controller::startLiveSearch() {
+
+    liveSearch.pending = false;
+    QString mediaName = liveSearch.pendingName;
+    std::string name = mediaName.toStdString();
+
+    Model::Library::SearchQuery query;
+    query.setMediaName(name);
+
+    // un nome che contiene quello cercato prima trova solo media gia' trovati: basta verificare i risultati precedenti
+    bool narrow = liveSearch.lastResultsValid && !liveSearch.lastName.empty() &&
+                  Model::Library::SearchQuery::checkPartialMatch(name, liveSearch.lastName);
+    std::vector<unsigned int> previousResults = narrow ? liveSearch.lastResults : std::vector<unsigned int>();
+
+    auto cancelled = std::make_shared<std::atomic<bool>>(false);
+    auto results = std::make_shared<std::vector<unsigned int>>();
+    unsigned int threadCount = static_cast<unsigned int>(QThread::idealThreadCount());
+    Model::Library::Manager* searchManager = manager;
+
+    QThread* thread = QThread::create([searchManager, query, narrow, previousResults, threadCount, cancelled, results]() {
+        *results = narrow ? searchManager->narrowSearch(query, previousResults, threadCount, cancelled.get())
+                          : searchManager->searchMedia(query, threadCount, cancelled.get());
+    });
+    liveSearch.thread = thread;
+    liveSearch.cancelled = cancelled;
+    liveSearch.runningName = mediaName;
+
+    // i risultati vengono letti solo dopo il segnale 'finished' (ricevuto nel thread della GUI)
+    connect(thread, &QThread::finished, this, [this, thread, cancelled, results, name]() {
+        thread->deleteLater();
+        if (liveSearch.thread == thread) {
+            liveSearch.thread = nullptr;
+        }
+        // una ricerca annullata ha risultati parziali, che vengono scartati
+        if (!cancelled->load()) {
+            liveSearch.lastName = name;
+            liveSearch.lastResults = *results;
+            liveSearch.lastResultsValid = true;
+            emit searchResults(*results);
+        }
+        if (liveSearch.pending && !liveSearch.thread) {
+            startLiveSearch();
+        }
+    });
+    thread->start();
+}
+
+void Controller::stopLiveSearch() {
+
+    if (!liveSearch.thread) return;
+
+    // se non e' gia' stata richiesta un'altra ricerca, quella annullata viene ripetuta dopo la modifica
+    if (!liveSearch.pending && !liveSearch.cancelled->load()) {
+        liveSearch.pendingName = liveSearch.runningName;
+        liveSearch.pending = true;
+    }
+    liveSearch.cancelled->store(true);
+    liveSearch.thread->wait();
+}
+
 
 // === JSON (SLOT) ===
 
 bool Controller::onSaveLibraryRequest(const QString& filename) {
 
-    if (!manager) return false;
-    return manager->saveContentsToFile(filename);
+    if (!manager || rejectWhileLibraryIO()) return false;
+
+    // i file con estensione dello snapshot binario usano il formato binario, gli altri il formato JSON
+    bool binary = Model::Library::BinarySnapshot::isSnapshotFile(filename.toStdString());
+
+    // in modalita' mappata la lettura dei media li materializza, e non e' protetta da accessi concorrenti: il salvataggio resta nel thread della GUI
+    if (manager->isContentsMapped()) {
+        bool saved = binary ? manager->saveContentsToBinary(filename) : manager->saveContentsToFile(filename);
+        emit librarySaved(saved, filename);
+        return true;
+    }
+
+    // durante il salvataggio la libreria viene solo letta (le richieste di modifica vengono rifiutate); i messaggi di log vengono conservati
+    // e passati al logger della libreria al termine. Il logger viene sostituito (e poi ripristinato) senza ricerche in corso, che lo usano
+    Model::Loggers::IMediaLogger* libraryLogger = manager->getLibraryLogger();
+    stopLiveSearch();
+    manager->setLibraryLogger(&ioLogger);
+
+    startLibraryIO([this, filename, binary]() {
+        if (binary) {
+            return manager->saveContentsToBinary(filename);
+        }
+        return manager->saveContentsToFile(filename, false, [this](std::uint64_t processed, std::uint64_t total) {
+            emit libraryIOProgress(static_cast<qint64>(processed), static_cast<qint64>(total));
+        });
+    }, [this, libraryLogger, filename](bool saved) {
+        stopLiveSearch();
+        manager->setLibraryLogger(libraryLogger);
+        emit librarySaved(saved, filename);
+    });
+    return true;
 }
 
 bool Controller::onLoadLibraryRequest(const QString& filename) {
 
-    if (!manager) return false;
-    return manager->loadContentsFromFile(filename);
+    if (!manager || rejectWhileLibraryIO()) return false;
+
+    // in modalita' mappata la consultazione dei media ne modifica il contatore degli identificatori, che il caricamento usa per creare i nuovi
+    // media: anche in questo caso l'operazione resta nel thread della GUI
+    if (manager->isContentsMapped()) {
+        stopLiveSearch();
+        liveSearch.lastResultsValid = false;
+        bool loaded = Model::Library::BinarySnapshot::isSnapshotFile(filename.toStdString())
+                          ? manager->loadContentsFromBinary(filename)
+                          : manager->loadContentsFromFile(filename, static_cast<unsigned int>(QThread::idealThreadCount()));
+        emit libraryLoaded(loaded, filename);
+        return true;
+    }
+
+    // la libreria viene caricata in un'istanza separata, con le stesse impostazioni di quella del manager: i contenuti di quest'ultima
+    // vengono sostituiti solo a caricamento concluso (nel thread della GUI), e fino ad allora restano consultabili
+    auto loaded = std::make_shared<Model::Library::Library>(&ioLogger);
+    loaded->setLibraryLogLevel(manager->getLogLevel());
+    loaded->setColumnSnapshotEnabled(manager->isColumnSnapshotEnabled());
+    bool binary = Model::Library::BinarySnapshot::isSnapshotFile(filename.toStdString());
+    unsigned int threadCount = static_cast<unsigned int>(QThread::idealThreadCount());
+
+    startLibraryIO([this, loaded, filename, binary, threadCount]() {
+        if (binary) {
+            return loaded->loadBinary(filename);
+        }
+        // la costruzione dei media viene suddivisa tra i core disponibili (per file piccoli resta seriale)
+        return loaded->loadFromFile(filename, threadCount, [this](std::uint64_t processed, std::uint64_t total) {
+            emit libraryIOProgress(static_cast<qint64>(processed), static_cast<qint64>(total));
+        });
+    }, [this, loaded, filename](bool success) {
+        if (success) {
+            stopLiveSearch();
+            liveSearch.lastResultsValid = false;
+            manager->replaceContents(*loaded);
+        }
+        emit libraryLoaded(success, filename);
+    });
+    return true;
+}
+
+void Controller::startLibraryIO(const std::function<bool()>& task, const std::function<void(bool)>& done) {
+
+    // il risultato viene scritto dal thread secondario e letto solo dopo il segnale 'finished' (ricevuto nel thread della GUI)
+    auto success = std::make_shared<bool>(false);
+    ioThread = QThread::create([task, success]() { *success = task(); });
+    connect(ioThread, &QThread::finished, this, [this, done, success]() {
+        ioThread->deleteLater();
+        ioThread = nullptr;
+        done(*success);
+        ioLogger.flushTo(manager->getLibraryLogger());
+    });
+    ioThread->start();
+}
+
+bool Controller::rejectWhileLibraryIO() {
+
+    if (!isLibraryIOBusy()) return false;
+    emit errorOccurred("Library is being loaded or saved, try again later");
+    return true;
 }
 
 
@@ -381,12 +608,10 @@ void Controller::onScoreRequested(unsigned int ind, QWidget* viewer) {
         return;
     }
 
-    Model::Visitors::ScoreVisitor scoring;
-    mediaPtr->accept(scoring);
-
-    float scoreValue = scoring.getScoreValue();
-    QString scoreLabel = QString::fromStdString(scoring.getScoreLabel());
-    QString scoreInfo = QString::fromStdString(scoring.getScoreInfo());
+    // lo score viene calcolato una sola volta e poi letto dalla cache della libreria
+    float scoreValue = manager->getMediaScoreAtIndex(ind);
+    QString scoreLabel = QString::fromStdString(manager->getMediaScoreLabelAtIndex(ind));
+    QString scoreInfo = QString::fromStdString(manager->getMediaScoreInfoAtIndex(ind));
 
     if (auto audioViewer = dynamic_cast<View::Viewer::AudioViewer*>(viewer)) {
         audioViewer->setScore(scoreValue, scoreLabel, scoreInfo);
@@ -2,16 +2,21 @@
 #define CONTROLLER_CONTROLLER_H
 
 #include "Model/Library/Manager.h"
+#include "Model/Library/ILibraryObserver.h"
 #include "Model/Library/SearchQuery.h"
+#include "Model/Loggers/IBufferLogger.h"
 
 #include <QObject>
 #include <QString>
 #include <QMap>
+#include <QThread>
 
 #include <string>
 #include <unordered_map>
 #include <vector>
 #include <memory>
+#include <functional>
+#include <atomic>
 
 /** @brief Controller
  *
@@ -23,11 +28,23 @@
  *
  *  Per avere un corretto funzionamento del sistema di segnali slot dovuto creare due metodi helper per la conversione tra QMap<QString,QString> e std::::unordered_map<std::string,std::string>.
  *
+ *  Caricamento e salvataggio della libreria vengono eseguiti su un thread secondario, per non bloccare la GUI: l'avanzamento viene notificato
+ *  con il segnale 'libraryIOProgress' e il risultato con 'libraryLoaded' / 'librarySaved'. Finche' l'operazione non e' conclusa le richieste
+ *  di modifica della libreria (creazione, modifica, rimozione, undo/redo) vengono rifiutate.
+ *
+ *  La ricerca "live" per nome (mentre l'utente scrive) viene eseguita su un thread secondario: una nuova richiesta annulla quella in corso, e se il
+ *  nome cercato contiene quello della ricerca precedente vengono verificati solo i risultati precedenti. Prima di ogni modifica della libreria
+ *  la ricerca in corso viene annullata e attesa, e poi ripetuta sui contenuti aggiornati.
+ *
+ *  Il Controller e' anche l'osservatore (ILibraryObserver) della libreria del manager: ogni media inserito, rimosso o modificato dai comandi
+ *  viene inoltrato alla vista con i segnali 'mediaInserted', 'mediaRemoved' e 'mediaChanged', in modo da aggiornare solo le righe interessate.
+ *  Le modifiche eseguite in blocco (un batch del manager, o il suo undo/redo) vengono notificate una sola volta al termine con il segnale 'mediaBatchChanged'.
+ *
  */
 
 namespace Controller {
 
-class Controller : public QObject {
+class Controller : public QObject, public Model::Library::ILibraryObserver {
 
     Q_OBJECT
 
@@ -43,6 +60,11 @@ public:
      */
     explicit Controller(Model::Library::Manager* manager, QObject* parent = nullptr);
 
+    /**
+     * @brief ~Controller : distruttore, attende la conclusione di un eventuale caricamento/salvataggio in corso
+     */
+    ~Controller() override;
+
 
     // === GENERALE ===
 
@@ -63,6 +85,12 @@ public:
      */
     void initializeCommandSignals();
 
+    /**
+     * @brief isLibraryIOBusy : verifica se e' in corso un caricamento o salvataggio della libreria
+     * @return bool : true se un'operazione e' in corso sul thread secondario, false altrimenti
+     */
+    bool isLibraryIOBusy() const;
+
 
     // === OPERAZIONI INDICE ===
 
@@ -190,6 +218,35 @@ public:
     QMap<QString, QString> UnorderedMapToQMap(const std::unordered_map<std::string, std::string>& attributeMapStd);
 
 
+    // === OSSERVATORE (ILibraryObserver) ===
+
+    /**
+     * @brief onMediaInserted : ridefinito da ILibraryObserver, emette 'mediaInserted'
+     * @param ind : posizione del media inserito
+     * @param id : identificatore univoco del media inserito
+     */
+    void onMediaInserted(unsigned int ind, unsigned int id) override;
+
+    /**
+     * @brief onMediaRemoved : ridefinito da ILibraryObserver, emette 'mediaRemoved'
+     * @param ind : posizione del media rimosso
+     * @param id : identificatore univoco del media rimosso
+     */
+    void onMediaRemoved(unsigned int ind, unsigned int id) override;
+
+    /**
+     * @brief onMediaChanged : ridefinito da ILibraryObserver, emette 'mediaChanged'
+     * @param ind : posizione del media modificato
+     * @param id : identificatore univoco del media modificato
+     */
+    void onMediaChanged(unsigned int ind, unsigned int id) override;
+
+    /**
+     * @brief onMediaBatchChanged : ridefinito da ILibraryObserver, emette 'mediaBatchChanged'
+     */
+    void onMediaBatchChanged() override;
+
+
     // === VIEWER WIDGET ===
 
     QWidget* createViewerForIndex(unsigned int ind, QWidget* parent);
@@ -263,6 +320,53 @@ signals:
      */
     void lastCommandInfo(const QString& info);
 
+    /**
+     * @brief libraryIOProgress : segnale emesso (dal thread secondario) durante un caricamento o salvataggio della libreria
+     * @param processed : quantita' gia' elaborata (byte letti per il caricamento, media scritti per il salvataggio)
+     * @param total : quantita' totale
+     */
+    void libraryIOProgress(qint64 processed, qint64 total);
+
+    /**
+     * @brief libraryLoaded : segnale emesso al termine di un caricamento della libreria (i contenuti sono gia' stati sostituiti)
+     * @param success : true se il caricamento ha avuto successo, false altrimenti
+     * @param filename : file da cui e' stata caricata la libreria
+     */
+    void libraryLoaded(bool success, const QString& filename);
+
+    /**
+     * @brief librarySaved : segnale emesso al termine di un salvataggio della libreria
+     * @param success : true se il salvataggio ha avuto successo, false altrimenti
+     * @param filename : file su cui e' stata salvata la libreria
+     */
+    void librarySaved(bool success, const QString& filename);
+
+    /**
+     * @brief mediaInserted : segnale emesso quando un media viene inserito in libreria (creazione, undo/redo)
+     * @param ind : posizione del media inserito
+     * @param id : identificatore univoco del media inserito
+     */
+    void mediaInserted(unsigned int ind, unsigned int id);
+
+    /**
+     * @brief mediaRemoved : segnale emesso quando un media viene tolto dalla libreria (rimozione, undo/redo), le posizioni successive scalano di uno
+     * @param ind : posizione del media rimosso
+     * @param id : identificatore univoco del media rimosso
+     */
+    void mediaRemoved(unsigned int ind, unsigned int id);
+
+    /**
+     * @brief mediaChanged : segnale emesso quando un media della libreria viene modificato
+     * @param ind : posizione del media modificato
+     * @param id : identificatore univoco del media modificato
+     */
+    void mediaChanged(unsigned int ind, unsigned int id);
+
+    /**
+     * @brief mediaBatchChanged : segnale emesso una sola volta al termine di un insieme di modifiche eseguite in blocco (le posizioni possono essere tutte cambiate)
+     */
+    void mediaBatchChanged();
+
 
 public slots:
 
@@ -350,16 +454,16 @@ public slots:
     // == JSON (SLOT) ===
 
     /**
-     * @brief onSaveLibraryRequest : gestisce richista di salvataggio della libreria a file (in formato JSON)
+     * @brief onSaveLibraryRequest : gestisce richista di salvataggio della libreria a file (in formato JSON), avviandolo su un thread secondario
      * @param filename : path del file a cui salvare la libreria
-     * @return bool : true se il salvataggio ha successo, false altrimenti
+     * @return bool : true se il salvataggio e' stato avviato, false altrimenti (il risultato viene notificato con 'librarySaved')
      */
     bool onSaveLibraryRequest(const QString& filename);
 
     /**
-     * @brief onLoadLibraryRequest : gestisce richiesta di caricamento libreria da file (in formato JSON)
+     * @brief onLoadLibraryRequest : gestisce richiesta di caricamento libreria da file (in formato JSON), avviandolo su un thread secondario
      * @param filename : path del file da cui caricare la libreria
-     * @return bool : true se il caricamento ha successo, false altrimenti
+     * @return bool : true se il caricamento e' stato avviato, false altrimenti (il risultato viene notificato con 'libraryLoaded')
      */
     bool onLoadLibraryRequest(const QString& filename);
 
@@ -379,6 +483,14 @@ public slots:
      */
     void onSearchMediaByNameRequest(const QString& mediaName);
 
+    /**
+     * @brief onLiveSearchRequest : gestisce richiesta di ricerca "live" per nome, eseguita su un thread secondario
+     * @param mediaName : nome del media da cercare (se vuoto la ricerca in corso viene solo annullata)
+     * @details annulla l'eventuale ricerca in corso; i risultati vengono emessi con il segnale 'searchResults' solo se la ricerca non e' stata
+     *          sostituita da una richiesta successiva
+     */
+    void onLiveSearchRequest(const QString& mediaName);
+
 
     // === CUSTOM WIDGETS (SLOT) ===
 
@@ -408,6 +520,46 @@ private:
 
     Model::Library::Manager* manager; // puntatore al Manager
 
+    QThread* ioThread;                  // thread del caricamento/salvataggio in corso ('nullptr' se nessuno)
+    Model::Loggers::IBufferLogger ioLogger;  // messaggi di log prodotti durante il caricamento/salvataggio
+
+    /** @brief LiveSearchState : stato della ricerca "live" per nome */
+    struct LiveSearchState {
+        QThread* thread = nullptr;                          // thread della ricerca in corso ('nullptr' se nessuna)
+        std::shared_ptr<std::atomic<bool>> cancelled;       // flag di annullamento della ricerca in corso
+        QString runningName;                                // nome cercato dalla ricerca in corso
+        QString pendingName;                                // nome da cercare al termine della ricerca in corso
+        bool pending = false;                               // true se 'pendingName' deve ancora essere cercato
+        std::string lastName;                               // nome cercato dall'ultima ricerca conclusa
+        std::vector<unsigned int> lastResults;              // risultati dell'ultima ricerca conclusa
+        bool lastResultsValid = false;                      // false se la libreria e' cambiata dopo l'ultima ricerca conclusa
+    };
+    LiveSearchState liveSearch;
+
+    /**
+     * @brief startLibraryIO : esegue un caricamento/salvataggio su un thread secondario
+     * @param task : operazione da eseguire sul thread secondario, restituisce true in caso di successo
+     * @param done : chiamata nel thread della GUI al termine dell'operazione, con il risultato di 'task'
+     */
+    void startLibraryIO(const std::function<bool()>& task, const std::function<void(bool)>& done);
+
+    /**
+     * @brief rejectWhileLibraryIO : verifica se una richiesta di modifica della libreria va rifiutata perche' e' in corso un caricamento/salvataggio
+     * @return bool : true se la richiesta va rifiutata (emettendo 'errorOccurred'), false altrimenti
+     */
+    bool rejectWhileLibraryIO();
+
+    /**
+     * @brief startLiveSearch : avvia sul thread secondario la ricerca "live" in attesa ('liveSearch.pendingName')
+     */
+    void startLiveSearch();
+
+    /**
+     * @brief stopLiveSearch : annulla e attende l'eventuale ricerca "live" in corso, prima di una modifica della libreria
+     * @details la ricerca annullata viene ripetuta al termine (sui contenuti aggiornati), se non e' gia' stata sostituita da un'altra richiesta
+     */
+    void stopLiveSearch();
+
 };
 
 }
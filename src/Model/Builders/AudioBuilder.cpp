@@ -4,7 +4,6 @@
 
 #include <string>
 #include <vector>
-#include <cstdlib>
 
 namespace Model {
 namespace Builders {
@@ -27,69 +26,69 @@ AudioBuilder::AudioBuilder(const Model::Media::Audio& audio)
 
 
 AudioBuilder& AudioBuilder::setPath(const std::string& path) {
-    editsToApply["path"] = path;
+    editsToApply.path = path;
     return *this;
 }
 AudioBuilder& AudioBuilder::setSize(float size) {
-    editsToApply["size"] = std::to_string(size);
+    editsToApply.size = size;
     return *this;
 }
 AudioBuilder& AudioBuilder::setName(const std::string& name) {
-    editsToApply["name"] = name;
+    editsToApply.name = name;
     return *this;
 }
 AudioBuilder& AudioBuilder::setUploader(const std::string& uploader) {
-    editsToApply["uploader"] = uploader;
+    editsToApply.uploader = uploader;
     return *this;
 }
 AudioBuilder& AudioBuilder::setFormat(const std::string& format) {
-    editsToApply["format"] = format;
+    editsToApply.format = format;
     return *this;
 }
 AudioBuilder& AudioBuilder::setRating(unsigned int rating) {
-    editsToApply["rating"] = std::to_string(rating);
+    editsToApply.rating = rating;
     return *this;
 }
 
 
 AudioBuilder& AudioBuilder::setArtist(const std::string& art) {
-    editsToApply["artist"] = art;
+    editsToApply.artist = art;
     return *this;
 }
 AudioBuilder& AudioBuilder::setGenre(const std::string& gnr) {
-    editsToApply["genre"] = gnr;
+    editsToApply.genre = gnr;
     return *this;
 }
 AudioBuilder& AudioBuilder::setAlbum(const std::string& alb) {
-    editsToApply["album"] = alb;
+    editsToApply.album = alb;
     return *this;
 }
 AudioBuilder& AudioBuilder::setReleaseYear(unsigned int year) {
-    editsToApply["releaseYear"] = std::to_string(year);
+    editsToApply.releaseYear = year;
     return *this;
 }
 AudioBuilder& AudioBuilder::setLengthInMinutes(unsigned int length) {
-    editsToApply["length"] = std::to_string(length);
+    editsToApply.length = length;
     return *this;
 }
 AudioBuilder& AudioBuilder::setBitRate(unsigned int br) {
-    editsToApply["bitrate"] = std::to_string(br);
+    editsToApply.bitrate = br;
     return *this;
 }
 AudioBuilder& AudioBuilder::setSampleRate(float sr) {
-    editsToApply["samplerate"] = std::to_string(sr);
+    editsToApply.samplerate = sr;
     return *this;
 }
 AudioBuilder& AudioBuilder::setBitDepth(unsigned int bd) {
-    editsToApply["bitdepth"] = std::to_string(bd);
+    editsToApply.bitdepth = bd;
     return *this;
 }
 AudioBuilder& AudioBuilder::setChannels(unsigned int ch) {
-    editsToApply["channels"] = std::to_string(ch);
+    editsToApply.channels = ch;
     return *this;
 }
 AudioBuilder& AudioBuilder::setCollaborators(const std::string& clb) {
-    editsToApply["collaborators"] = clb;
+    editsToApply.collaborators = clb;
     return *this;
 }
 
@@ -98,58 +97,41 @@ Media::Audio* AudioBuilder::applyEdits() const {
 
     Media::Audio* edited = audioPointer->clone();
 
-    if (editsToApply.find("path") != editsToApply.end()) {
-        edited->setFilePath(editsToApply.at("path"));
-    }
-    if (editsToApply.find("size") != editsToApply.end()) {
-        edited->setFileSize(std::stof(editsToApply.at("size")));
-    }
-    if (editsToApply.find("name") != editsToApply.end()) {
-        edited->setMediaName(editsToApply.at("name"));
-    }
-    if (editsToApply.find("uploader") != editsToApply.end()) {
-        edited->setMediaUploader(editsToApply.at("uploader"));
-    }
-    if (editsToApply.find("format") != editsToApply.end()) {
-        edited->setMediaFormat(editsToApply.at("format"));
-    }
-    if (editsToApply.find("rating") != editsToApply.end()) {
-        edited->setMediaRating(std::stoi(editsToApply.at("rating")));
-    }
+    applyCommonEdits(editsToApply, *edited);
 
-    if (editsToApply.find("artist") != editsToApply.end()) {
-        edited->setArtist(editsToApply.at("artist"));
+    if (editsToApply.artist) {
+        edited->setArtist(*editsToApply.artist);
     }
-    if (editsToApply.find("genre") != editsToApply.end()) {
-        edited->setGenre(editsToApply.at("genre"));
+    if (editsToApply.genre) {
+        edited->setGenre(*editsToApply.genre);
     }
-    if (editsToApply.find("album") != editsToApply.end()) {
-        edited->setAlbum(editsToApply.at("album"));
+    if (editsToApply.album) {
+        edited->setAlbum(*editsToApply.album);
     }
 
-    if (editsToApply.find("releaseYear") != editsToApply.end()) {
-        edited->setReleaseYear(std::stoi(editsToApply.at("releaseYear")));
+    if (editsToApply.releaseYear) {
+        edited->setReleaseYear(*editsToApply.releaseYear);
     }
-    if (editsToApply.find("length") != editsToApply.end()) {
-        edited->setMediaLength(std::stoi(editsToApply.at("length")));
+    if (editsToApply.length) {
+        edited->setMediaLength(*editsToApply.length);
     }
-    if (editsToApply.find("bitrate") != editsToApply.end()) {
-        edited->setBitRate(std::stoi(editsToApply.at("bitrate")));
+    if (editsToApply.bitrate) {
+        edited->setBitRate(*editsToApply.bitrate);
     }
 
-    if (editsToApply.find("samplerate") != editsToApply.end()) {
-        edited->setSampleRate(std::stof(editsToApply.at("samplerate")));
+    if (editsToApply.samplerate) {
+        edited->setSampleRate(*editsToApply.samplerate);
     }
 
-    if (editsToApply.find("bitdepth") != editsToApply.end()) {
-        edited->setBitDepth(std::stoi(editsToApply.at("bitdepth")));
+    if (editsToApply.bitdepth) {
+        edited->setBitDepth(*editsToApply.bitdepth);
     }
-    if (editsToApply.find("channels") != editsToApply.end()) {
-        edited->setAudioChannels(std::stoi(editsToApply.at("channels")));
+    if (editsToApply.channels) {
+        edited->setAudioChannels(*editsToApply.channels);
     }
 
-    if (editsToApply.find("collaborators") != editsToApply.end()) {
-        edited->setCollaborators(editsToApply.at("collaborators"));
+    if (editsToApply.collaborators) {
+        edited->setCollaborators(*editsToApply.collaborators);
     }
 
     return edited;
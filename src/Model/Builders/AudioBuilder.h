@@ -6,7 +6,7 @@
 
 #include <string>
 #include <vector>
-#include <unordered_map>
+#include <optional>
 #include <memory>
 
 /** @brief AudioBuilder
@@ -14,7 +14,7 @@
  *  AudioBuilder e' una sottoclasse concreta di IBuilder che implementa il design pattern "Builder" per i media di tipo Audio.
 
  *  AudioBuilder dispone di un costruttore di default, un costruttore di copia e i setter per i vari attributi specifici al tipo Audio.
- *  Contiene come campi dati privati uno smart pointer 'audioPointer' del tipo std::shared_ptr e una mappa 'editsToApply' delle modifiche da applicare.
+ *  Contiene come campi dati privati uno smart pointer 'audioPointer' del tipo std::shared_ptr e la struttura 'editsToApply' delle modifiche (tipizzate) da applicare.
  *  Il vettore costante statico 'AUDIO_ATTRIBUTES' contiene i nomi degli attributi per i media di tipo Audio.
  */
 
@@ -73,8 +73,22 @@ public:
 
 private:
 
-    std::shared_ptr<Model::Media::Audio> audioPointer;                 // smart pointer al media Audio
-    mutable std::unordered_map<std::string, std::string> editsToApply; // mappa di modifiche da effettuare
+    /** @brief AudioEdits : modifiche da applicare al media Audio, oltre a quelle comuni (un campo vuoto non viene modificato) */
+    struct AudioEdits : CommonEdits {
+        std::optional<std::string> artist;
+        std::optional<std::string> genre;
+        std::optional<std::string> album;
+        std::optional<unsigned int> releaseYear;
+        std::optional<unsigned int> length;
+        std::optional<unsigned int> bitrate;
+        std::optional<float> samplerate;
+        std::optional<unsigned int> bitdepth;
+        std::optional<unsigned int> channels;
+        std::optional<std::string> collaborators;
+    };
+
+    std::shared_ptr<Model::Media::Audio> audioPointer; // smart pointer al media Audio
+    AudioEdits editsToApply;                           // modifiche da effettuare
 
 
     /**
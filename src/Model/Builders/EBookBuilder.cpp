@@ -4,7 +4,6 @@
 
 #include <string>
 #include <vector>
-#include <cstdlib>
 
 namespace Model {
 namespace Builders {
@@ -27,65 +26,65 @@ EBookBuilder::EBookBuilder(const Model::Media::EBook& ebook)
 
 
 EBookBuilder& EBookBuilder::setPath(const std::string& path) {
-    editsToApply["path"] = path;
+    editsToApply.path = path;
     return *this;
 }
 EBookBuilder& EBookBuilder::setSize(float size) {
-    editsToApply["size"] = std::to_string(size);
+    editsToApply.size = size;
     return *this;
 }
 EBookBuilder& EBookBuilder::setName(const std::string& name) {
-    editsToApply["name"] = name;
+    editsToApply.name = name;
     return *this;
 }
 EBookBuilder& EBookBuilder::setUploader(const std::string& uploader) {
-    editsToApply["uploader"] = uploader;
+    editsToApply.uploader = uploader;
     return *this;
 }
 EBookBuilder& EBookBuilder::setFormat(const std::string& format) {
-    editsToApply["format"] = format;
+    editsToApply.format = format;
     return *this;
 }
 EBookBuilder& EBookBuilder::setRating(unsigned int rating) {
-    editsToApply["rating"] = std::to_string(rating);
+    editsToApply.rating = rating;
     return *this;
 }
 
 
 EBookBuilder& EBookBuilder::setAuthor(const std::string& auth) {
-    editsToApply["author"] = auth;
+    editsToApply.author = auth;
     return *this;
 }
 EBookBuilder& EBookBuilder::setPublisher(const std::string& pbl) {
-    editsToApply["publisher"] = pbl;
+    editsToApply.publisher = pbl;
     return *this;
 }
 EBookBuilder& EBookBuilder::setReleaseYear(unsigned int year) {
-    editsToApply["releaseYear"] = std::to_string(year);
+    editsToApply.releaseYear = year;
     return *this;
 }
 EBookBuilder& EBookBuilder::setISBN(const std::string& isbn) {
-    editsToApply["isbn"] = isbn;
+    editsToApply.isbn = isbn;
     return *this;
 }
 EBookBuilder& EBookBuilder::setLengthInPages(unsigned int length) {
-    editsToApply["length"] = std::to_string(length);
+    editsToApply.length = length;
     return *this;
 }
 EBookBuilder& EBookBuilder::setCategory(const std::string& ctg) {
-    editsToApply["category"] = ctg;
+    editsToApply.category = ctg;
     return *this;
 }
 EBookBuilder& EBookBuilder::setLanguage(const std::string& lang) {
-    editsToApply["language"] = lang;
+    editsToApply.language = lang;
     return *this;
 }
 EBookBuilder& EBookBuilder::setCoverImagePath(const std::string& cp) {
-    editsToApply["coverPath"] = cp;
+    editsToApply.coverPath = cp;
     return *this;
 }
 EBookBuilder& EBookBuilder::setHasImages(bool img) {
-    editsToApply["hasImages"] = (img ? "true" : "false");
+    editsToApply.hasImages = img;
     return *this;
 }
 
@@ -95,52 +94,34 @@ Media::EBook* EBookBuilder::applyEdits() const {
 
     Media::EBook* edited = ebookPointer->clone();
 
-    if (editsToApply.find("path") != editsToApply.end()) {
-        edited->setFilePath(editsToApply.at("path"));
-    }
-    if (editsToApply.find("size") != editsToApply.end()) {
-        edited->setFileSize(std::stof(editsToApply.at("size")));
-    }
-    if (editsToApply.find("name") != editsToApply.end()) {
-        edited->setMediaName(editsToApply.at("name"));
-    }
-    if (editsToApply.find("uploader") != editsToApply.end()) {
-        edited->setMediaUploader(editsToApply.at("uploader"));
-    }
-    if (editsToApply.find("format") != editsToApply.end()) {
-        edited->setMediaFormat(editsToApply.at("format"));
-    }
-    if (editsToApply.find("rating") != editsToApply.end()) {
-        edited->setMediaRating(std::stoi(editsToApply.at("rating")));
-    }
+    applyCommonEdits(editsToApply, *edited);
 
-    if (editsToApply.find("author") != editsToApply.end()) {
-        edited->setAuthor(editsToApply.at("author"));
+    if (editsToApply.author) {
+        edited->setAuthor(*editsToApply.author);
     }
-    if (editsToApply.find("publisher") != editsToApply.end()) {
-        edited->setPublisher(editsToApply.at("publisher"));
+    if (editsToApply.publisher) {
+        edited->setPublisher(*editsToApply.publisher);
     }
-    if (editsToApply.find("releaseYear") != editsToApply.end()) {
-        edited->setReleaseYear(std::stoi(editsToApply.at("releaseYear")));
+    if (editsToApply.releaseYear) {
+        edited->setReleaseYear(*editsToApply.releaseYear);
     }
-    if (editsToApply.find("isbn") != editsToApply.end()) {
-        edited->setISBN(editsToApply.at("isbn"));
+    if (editsToApply.isbn) {
+        edited->setISBN(*editsToApply.isbn);
     }
-    if (editsToApply.find("length") != editsToApply.end()) {
-        edited->setMediaLength(std::stoi(editsToApply.at("length")));
+    if (editsToApply.length) {
+        edited->setMediaLength(*editsToApply.length);
     }
-    if (editsToApply.find("category") != editsToApply.end()) {
-        edited->setCategory(editsToApply.at("category"));
+    if (editsToApply.category) {
+        edited->setCategory(*editsToApply.category);
     }
-    if (editsToApply.find("language") != editsToApply.end()) {
-        edited->setLanguage(editsToApply.at("language"));
+    if (editsToApply.language) {
+        edited->setLanguage(*editsToApply.language);
     }
-    if (editsToApply.find("coverPath") != editsToApply.end()) {
-        edited->setCoverImagePath(editsToApply.at("coverPath"));
+    if (editsToApply.coverPath) {
+        edited->setCoverImagePath(*editsToApply.coverPath);
     }
-    if (editsToApply.find("hasImages") != editsToApply.end()) {
-        bool img = (editsToApply.at("hasImages") == "true") ? true : false;
-        edited->setImages(img);
+    if (editsToApply.hasImages) {
+        edited->setImages(*editsToApply.hasImages);
     }
     return edited;
 }
@@ -6,7 +6,7 @@
 
 #include <string>
 #include <vector>
-#include <unordered_map>
+#include <optional>
 #include <memory>
 
 /** @brief EBookBuilder
@@ -14,7 +14,7 @@
  *  EBookBuilder e' una sottoclasse concreta di IBuilder che implementa il design pattern "Builder" per i media di tipo EBook.
 
  *  EBookBuilder dispone di un costruttore di default, un costruttore di copia e i setter per i vari attributi specifici al tipo Audio.
- *  Contiene come campi dati privati uno smart pointer 'ebookPointer' del tipo std::shared_ptr e una mappa 'editsToApply' delle modifiche da applicare.
+ *  Contiene come campi dati privati uno smart pointer 'ebookPointer' del tipo std::shared_ptr e la struttura 'editsToApply' delle modifiche (tipizzate) da applicare.
  *  Il vettore costante statico 'EBOOK_ATTRIBUTES' contiene i nomi degli attributi per i media di tipo Audio.
  */
 
@@ -75,8 +75,21 @@ public:
 
 private:
 
-    std::shared_ptr<Model::Media::EBook> ebookPointer;                 // smart pointer al media EBook
-    mutable std::unordered_map<std::string, std::string> editsToApply; // mappa di modifiche da effettuare
+    /** @brief EBookEdits : modifiche da applicare al media EBook, oltre a quelle comuni (un campo vuoto non viene modificato) */
+    struct EBookEdits : CommonEdits {
+        std::optional<std::string> author;
+        std::optional<std::string> publisher;
+        std::optional<unsigned int> releaseYear;
+        std::optional<std::string> isbn;
+        std::optional<unsigned int> length;
+        std::optional<std::string> category;
+        std::optional<std::string> language;
+        std::optional<std::string> coverPath;
+        std::optional<bool> hasImages;
+    };
+
+    std::shared_ptr<Model::Media::EBook> ebookPointer; // smart pointer al media EBook
+    EBookEdits editsToApply;                           // modifiche da effettuare
 
     /**
      * @brief applyEdits : applica le modifiche contenute in 'editsToApply' ad una copia del media EBook
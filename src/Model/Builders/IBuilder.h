@@ -4,6 +4,8 @@
 #include "Model/Media/AbstractMedia.h"
 
 #include <memory>
+#include <optional>
+#include <string>
 
 /** @brief IBuilder
  *
@@ -20,8 +22,9 @@
  *  Ciascun builder concreto definisce un vettore costante statico di stringhe, corrispondente ai nomi degli attributi del media.
  *  Questo vettore viene utilizzato anche per operazioni come validazione e persistenza dati, e anche per facilitare la creazione dei custom widgets dell'interfaccia grafica.
  *
- *  Le modifiche da applicare sono salvate in un'oggetto del tipo std::unordered_map<std::string, std::string>, contenente le coppie di attributi (nome, valore) del media.
- *  Questa e' solitamente marcata come 'mutable' in modo da poter essere utilizzata in metodi marcati 'const', come ad esempio 'buildMedia()'.
+ *  Le modifiche da applicare sono salvate con il loro tipo in una struttura 'editsToApply', con un campo std::optional per ciascun attributo del media
+ *  (un campo vuoto indica un attributo da non modificare). I setter salvano direttamente il valore e 'applyEdits' lo passa al setter corrispondente del media,
+ *  senza conversioni da/verso stringa. I campi comuni a tutti i media sono raccolti nella struttura 'CommonEdits', applicata da 'applyCommonEdits'.
  *
  *  Ciasun builder definisce il metodo 'applyEdits' che applica le modifiche su una copia temporanea del media, ottenuta tramite il costruttore polimorfo 'clone' (definito in AbstractFile).
  *  Le modifiche vengono poi "validate" utilizzando il visitor concreto Model::Visitors::MediaValidator. Se il media modificato risulta valido, viene restituito.
@@ -48,6 +51,32 @@ public:
      * @return std::shared_ptr<AbstractMedia> : smart pointer a AbstractMedia
      */
     virtual std::shared_ptr<Media::AbstractMedia> buildMedia() const = 0;
+
+protected:
+
+    /** @brief CommonEdits : modifiche (tipizzate) agli attributi comuni a tutti i media */
+    struct CommonEdits {
+        std::optional<std::string> path;
+        std::optional<float> size;
+        std::optional<std::string> name;
+        std::optional<std::string> uploader;
+        std::optional<std::string> format;
+        std::optional<unsigned int> rating;
+    };
+
+    /**
+     * @brief applyCommonEdits : applica ad un media le modifiche agli attributi comuni
+     * @param edits : modifiche da applicare
+     * @param media : media da modificare
+     */
+    static void applyCommonEdits(const CommonEdits& edits, Media::AbstractMedia& media) {
+        if (edits.path) media.setFilePath(*edits.path);
+        if (edits.size) media.setFileSize(*edits.size);
+        if (edits.name) media.setMediaName(*edits.name);
+        if (edits.uploader) media.setMediaUploader(*edits.uploader);
+        if (edits.format) media.setMediaFormat(*edits.format);
+        if (edits.rating) media.setMediaRating(*edits.rating);
+    }
 };
 
 }
@@ -4,7 +4,6 @@
 
 #include <string>
 #include <vector>
-#include <cstdlib>
 
 namespace Model {
 namespace Builders {
@@ -26,69 +25,69 @@ ImageBuilder::ImageBuilder(const Model::Media::Image& image)
 
 
 ImageBuilder& ImageBuilder::setPath(const std::string& path) {
-    editsToApply["path"] = path;
+    editsToApply.path = path;
     return *this;
 }
 ImageBuilder& ImageBuilder::setSize(float size) {
-    editsToApply["size"] = std::to_string(size);
+    editsToApply.size = size;
     return *this;
 }
 ImageBuilder& ImageBuilder::setName(const std::string& name) {
-    editsToApply["name"] = name;
+    editsToApply.name = name;
     return *this;
 }
 ImageBuilder& ImageBuilder::setUploader(const std::string& uploader) {
-    editsToApply["uploader"] = uploader;
+    editsToApply.uploader = uploader;
     return *this;
 }
 ImageBuilder& ImageBuilder::setFormat(const std::string& format) {
-    editsToApply["format"] = format;
+    editsToApply.format = format;
     return *this;
 }
 ImageBuilder& ImageBuilder::setRating(unsigned int rating) {
-    editsToApply["rating"] = std::to_string(rating);
+    editsToApply.rating = rating;
     return *this;
 }
 
 
 ImageBuilder& ImageBuilder::setDateCreated(const std::string& created) {
-    editsToApply["dateCreated"] = created;
+    editsToApply.dateCreated = created;
     return *this;
 }
 ImageBuilder& ImageBuilder::setCreator(const std::string& creator) {
-    editsToApply["imageCreator"] = creator;
+    editsToApply.imageCreator = creator;
     return *this;
 }
 ImageBuilder& ImageBuilder::setCategory(const std::string& category) {
-    editsToApply["imageCategory"] = category;
+    editsToApply.imageCategory = category;
     return *this;
 }
 ImageBuilder& ImageBuilder::setResolutionWidth(unsigned int resW) {
-    editsToApply["resolutionWidth"] = std::to_string(resW);
+    editsToApply.resolutionWidth = resW;
     return *this;
 }
 ImageBuilder& ImageBuilder::setResolutionHeight(unsigned int resH) {
-    editsToApply["resolutionHeight"] = std::to_string(resH);
+    editsToApply.resolutionHeight = resH;
     return *this;
 }
 ImageBuilder& ImageBuilder::setAspectRatioWidth(unsigned int aspW) {
-    editsToApply["aspectWidth"] = std::to_string(aspW);
+    editsToApply.aspectWidth = aspW;
     return *this;
 }
 ImageBuilder& ImageBuilder::setAspectRatioHeight(unsigned int aspH) {
-    editsToApply["aspectHeight"] = std::to_string(aspH);
+    editsToApply.aspectHeight = aspH;
     return *this;
 }
 ImageBuilder& ImageBuilder::setImageBitdepth(unsigned int bd) {
-    editsToApply["bitdepth"] = std::to_string(bd);
+    editsToApply.bitdepth = bd;
     return *this;
 }
 ImageBuilder& ImageBuilder::setCompression(bool cmpr) {
-    editsToApply["compressed"] = (cmpr ? "true" : "false");
+    editsToApply.compressed = cmpr;
     return *this;
 }
 ImageBuilder& ImageBuilder::setLocationTaken(const std::string& location) {
-    editsToApply["location"] = location;
+    editsToApply.location = location;
     return *this;
 }
 
@@ -96,55 +95,37 @@ Media::Image* ImageBuilder::applyEdits() const {
 
     Media::Image* edited = imagePointer->clone();
 
-    if (editsToApply.find("path") != editsToApply.end()) {
-        edited->setFilePath(editsToApply.at("path"));
-    }
-    if (editsToApply.find("size") != editsToApply.end()) {
-        edited->setFileSize(std::stof(editsToApply.at("size")));
-    }
-    if (editsToApply.find("name") != editsToApply.end()) {
-        edited->setMediaName(editsToApply.at("name"));
-    }
-    if (editsToApply.find("uploader") != editsToApply.end()) {
-        edited->setMediaUploader(editsToApply.at("uploader"));
-    }
-    if (editsToApply.find("format") != editsToApply.end()) {
-        edited->setMediaFormat(editsToApply.at("format"));
-    }
-    if (editsToApply.find("rating") != editsToApply.end()) {
-        edited->setMediaRating(std::stoi(editsToApply.at("rating")));
-    }
+    applyCommonEdits(editsToApply, *edited);
 
-    if (editsToApply.find("dateCreated") != editsToApply.end()) {
-        edited->setDateCreated(editsToApply.at("dateCreated"));
+    if (editsToApply.dateCreated) {
+        edited->setDateCreated(*editsToApply.dateCreated);
     }
-    if (editsToApply.find("imageCreator") != editsToApply.end()) {
-        edited->setImageCreator(editsToApply.at("imageCreator"));
+    if (editsToApply.imageCreator) {
+        edited->setImageCreator(*editsToApply.imageCreator);
     }
-    if (editsToApply.find("imageCategory") != editsToApply.end()) {
-        edited->setImageCategory(editsToApply.at("imageCategory"));
+    if (editsToApply.imageCategory) {
+        edited->setImageCategory(*editsToApply.imageCategory);
     }
-    if (editsToApply.find("resolutionWidth") != editsToApply.end()) {
-        edited->setResolution( { std::stoi(editsToApply.at("resolutionWidth")), edited->getResolution().second } );
+    if (editsToApply.resolutionWidth) {
+        edited->setResolution( { static_cast<int>(*editsToApply.resolutionWidth), edited->getResolution().second } );
     }
-    if (editsToApply.find("resolutionHeight") != editsToApply.end()) {
-        edited->setResolution( {edited->getResolution().first, std::stoi(editsToApply.at("resolutionHeight")) } );
+    if (editsToApply.resolutionHeight) {
+        edited->setResolution( { edited->getResolution().first, static_cast<int>(*editsToApply.resolutionHeight) } );
     }
-    if (editsToApply.find("aspectWidth") != editsToApply.end()) {
-        edited->setImageAspectRatio( { std::stoi(editsToApply.at("aspectWidth")), edited->getImageAspectRatio().second } );
+    if (editsToApply.aspectWidth) {
+        edited->setImageAspectRatio( { static_cast<int>(*editsToApply.aspectWidth), edited->getImageAspectRatio().second } );
     }
-    if (editsToApply.find("aspectHeight") != editsToApply.end()) {
-        edited->setImageAspectRatio( { edited->getImageAspectRatio().first, std::stoi(editsToApply.at("aspectHeight")) } );
+    if (editsToApply.aspectHeight) {
+        edited->setImageAspectRatio( { edited->getImageAspectRatio().first, static_cast<int>(*editsToApply.aspectHeight) } );
     }
-    if (editsToApply.find("bitdepth") != editsToApply.end()) {
-        edited->setImageBitDepth(std::stoi(editsToApply.at("bitdepth")));
+    if (editsToApply.bitdepth) {
+        edited->setImageBitDepth(*editsToApply.bitdepth);
     }
-    if (editsToApply.find("compressed") != editsToApply.end()) {
-        bool cmpr = (editsToApply.at("compressed") == "true") ? "true" : "false";
-        edited->setImageCompression(cmpr);
+    if (editsToApply.compressed) {
+        edited->setImageCompression(*editsToApply.compressed);
     }
-    if (editsToApply.find("location") != editsToApply.end()) {
-        edited->setImageLocationTaken(editsToApply.at("location"));
+    if (editsToApply.location) {
+        edited->setImageLocationTaken(*editsToApply.location);
     }
 
     return edited;
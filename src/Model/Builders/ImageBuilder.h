@@ -6,7 +6,7 @@
 
 #include <string>
 #include <vector>
-#include <unordered_map>
+#include <optional>
 #include <memory>
 
 
@@ -15,7 +15,7 @@
  *  ImageBuilder e' una sottoclasse concreta di IBuilder che implementa il design pattern "Builder" per i media di tipo Image.
 
  *  ImageBuilder dispone di un costruttore di default, un costruttore di copia e i setter per i vari attributi specifici al tipo Image.
- *  Contiene come campi dati privati uno smart pointer 'imagePointer' del tipo std::shared_ptr e una mappa 'editsToApply' delle modifiche da applicare.
+ *  Contiene come campi dati privati uno smart pointer 'imagePointer' del tipo std::shared_ptr e la struttura 'editsToApply' delle modifiche (tipizzate) da applicare.
  *  Il vettore costante statico 'IMAGE_ATTRIBUTES' contiene i nomi degli attributi per i media di tipo Image.
  */
 
@@ -73,8 +73,22 @@ public:
 
 private:
 
-    std::shared_ptr<Model::Media::Image> imagePointer;                 // smart pointer al media Image
-    mutable std::unordered_map<std::string, std::string> editsToApply; // mappa di modifiche da effettuare
+    /** @brief ImageEdits : modifiche da applicare al media Image, oltre a quelle comuni (un campo vuoto non viene modificato) */
+    struct ImageEdits : CommonEdits {
+        std::optional<std::string> dateCreated;
+        std::optional<std::string> imageCreator;
+        std::optional<std::string> imageCategory;
+        std::optional<unsigned int> resolutionWidth;
+        std::optional<unsigned int> resolutionHeight;
+        std::optional<unsigned int> aspectWidth;
+        std::optional<unsigned int> aspectHeight;
+        std::optional<unsigned int> bitdepth;
+        std::optional<bool> compressed;
+        std::optional<std::string> location;
+    };
+
+    std::shared_ptr<Model::Media::Image> imagePointer; // smart pointer al media Image
+    ImageEdits editsToApply;                           // modifiche da effettuare
 
     Media::Image* applyEdits() const;
 };
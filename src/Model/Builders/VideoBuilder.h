@@ -6,7 +6,7 @@
 
 #include <string>
 #include <vector>
-#include <unordered_map>
+#include <optional>
 #include <memory>
 
 
@@ -15,7 +15,7 @@
  *  VideoBuilder e' una sottoclasse concreta di IBuilder che implementa il design pattern "Builder" per i media di tipo Video.
 
  *  VideoBuilder dispone di un costruttore di default, un costruttore di copia e i setter per i vari attributi specifici al tipo Video.
- *  Contiene come campi dati privati uno smart pointer 'videoPointer' del tipo std::shared_ptr e una mappa 'editsToApply' delle modifiche da applicare.
+ *  Contiene come campi dati privati uno smart pointer 'videoPointer' del tipo std::shared_ptr e la struttura 'editsToApply' delle modifiche (tipizzate) da applicare.
  *  Il vettore costante statico 'VIDEO_ATTRIBUTES' contiene i nomi degli attributi per i media di tipo Video.
  */
 
@@ -76,8 +76,22 @@ public:
 
 private:
 
-    std::shared_ptr<Model::Media::Video> videoPointer;                 // smart pointer al media Video
-    mutable std::unordered_map<std::string, std::string> editsToApply; // mappa di modifiche da effettuare
+    /** @brief VideoEdits : modifiche da applicare al media Video, oltre a quelle comuni (un campo vuoto non viene modificato) */
+    struct VideoEdits : CommonEdits {
+        std::optional<std::string> director;
+        std::optional<std::string> genre;
+        std::optional<unsigned int> releaseYear;
+        std::optional<unsigned int> length;
+        std::optional<unsigned int> framerate;
+        std::optional<unsigned int> width;
+        std::optional<unsigned int> height;
+        std::optional<unsigned int> colordepth;
+        std::optional<std::string> subtitles;
+        std::optional<std::string> language;
+    };
+
+    std::shared_ptr<Model::Media::Video> videoPointer; // smart pointer al media Video
+    VideoEdits editsToApply;                           // modifiche da effettuare
 
 
     /**
@@ -0,0 +1,329 @@
+#include "BinarySnapshot.h"
+#include "Model/Media/Audio.h"
+#include "Model/Media/Video.h"
+#include "Model/Media/EBook.h"
+#include "Model/Media/Image.h"
+#include "Model/Visitors/SnapshotEncoder.h"
+#include "Model/Visitors/SnapshotDecoder.h"
+
+#include <cstring>
+#include <stdexcept>
+
+
+namespace Model {
+namespace Library {
+
+namespace {
+
+inline void appendU32(std::string& out, std::uint32_t value) {
+    char bytes[4] = { static_cast<char>(value & 0xFFu), static_cast<char>((value >> 8) & 0xFFu),
+                      static_cast<char>((value >> 16) & 0xFFu), static_cast<char>((value >> 24) & 0xFFu) };
+    out.append(bytes, 4);
+}
+
+std::shared_ptr<Media::AbstractMedia> createRecordMedia(BinarySnapshot::RecordType type) {
+
+    switch (type) {
+    case BinarySnapshot::RecordType::Audio: return std::make_shared<Media::Audio>();
+    case BinarySnapshot::RecordType::Video: return std::make_shared<Media::Video>();
+    case BinarySnapshot::RecordType::EBook: return std::make_shared<Media::EBook>();
+    case BinarySnapshot::RecordType::Image: return std::make_shared<Media::Image>();
+    }
+    return nullptr;
+}
+
+}
+
+const char BinarySnapshot::FILE_MAGIC[4] = { 'V', 'L', 'B', 'S' };
+const std::uint32_t BinarySnapshot::FORMAT_VERSION = 1;
+const std::string BinarySnapshot::FILE_EXTENSION = ".vlib";
+const std::size_t BinarySnapshot::FILE_HEADER_SIZE = 16;
+const std::size_t BinarySnapshot::RECORD_HEADER_SIZE = 5;
+
+
+// === RECORD WRITER ===
+
+void BinarySnapshot::RecordWriter::beginRecord(RecordType type) {
+
+    recordStart = records.size();
+    records.push_back(static_cast<char>(type));
+    appendU32(records, 0);
+}
+
+void BinarySnapshot::RecordWriter::endRecord() {
+
+    std::uint32_t length = static_cast<std::uint32_t>(records.size() - recordStart - RECORD_HEADER_SIZE);
+    for (unsigned int b = 0; b < 4; ++b) {
+        records[recordStart + 1 + b] = static_cast<char>((length >> (8 * b)) & 0xFFu);
+    }
+    ++recordCount;
+}
+
+void BinarySnapshot::RecordWriter::writeU8(std::uint8_t value) { records.push_back(static_cast<char>(value)); }
+
+void BinarySnapshot::RecordWriter::writeU32(std::uint32_t value) { appendU32(records, value); }
+
+void BinarySnapshot::RecordWriter::writeI32(std::int32_t value) { appendU32(records, static_cast<std::uint32_t>(value)); }
+
+void BinarySnapshot::RecordWriter::writeF32(float value) {
+
+    std::uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    appendU32(records, bits);
+}
+
+void BinarySnapshot::RecordWriter::writeString(const std::string& value) {
+
+    // ricerca prima dell'inserimento, per non allocare un nodo per le stringhe gia' presenti
+    auto found = stringIDs.find(value);
+    if (found == stringIDs.end()) {
+        found = stringIDs.emplace(value, static_cast<std::uint32_t>(strings.size())).first;
+        // le chiavi di unordered_map non vengono spostate, il puntatore resta valido
+        strings.push_back(&found->first);
+    }
+    appendU32(records, found->second);
+}
+
+unsigned int BinarySnapshot::RecordWriter::getRecordCount() const { return recordCount; }
+
+const std::vector<const std::string*>& BinarySnapshot::RecordWriter::getStrings() const { return strings; }
+
+const std::string& BinarySnapshot::RecordWriter::getRecordBytes() const { return records; }
+
+
+// === RECORD READER ===
+
+BinarySnapshot::RecordReader::RecordReader(const std::vector<std::string>& table, const char* data, std::size_t size)
+    : strings(&table),
+    fileData(nullptr),
+    stringOffsets(nullptr),
+    current(data),
+    end(data + size)
+{}
+
+BinarySnapshot::RecordReader::RecordReader(const char* mappedData, const std::vector<std::uint64_t>& offsets, const char* data, std::size_t size)
+    : strings(nullptr),
+    fileData(mappedData),
+    stringOffsets(&offsets),
+    current(data),
+    end(data + size)
+{}
+
+void BinarySnapshot::RecordReader::require(std::size_t bytes) const {
+
+    if (static_cast<std::size_t>(end - current) < bytes) {
+        throw std::runtime_error("Truncated snapshot record\n");
+    }
+}
+
+std::uint8_t BinarySnapshot::RecordReader::readU8() {
+
+    require(1);
+    return static_cast<std::uint8_t>(*current++);
+}
+
+std::uint32_t BinarySnapshot::RecordReader::readU32() {
+
+    require(4);
+    std::uint32_t value = loadU32(current);
+    current += 4;
+    return value;
+}
+
+std::int32_t BinarySnapshot::RecordReader::readI32() { return static_cast<std::int32_t>(readU32()); }
+
+float BinarySnapshot::RecordReader::readF32() {
+
+    std::uint32_t bits = readU32();
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+const std::string& BinarySnapshot::RecordReader::readString() {
+
+    std::uint32_t index = readStringIndex();
+    if (strings) {
+        return (*strings)[index];
+    }
+    // la lunghezza delle stringhe della tabella e' gia' stata verificata da 'indexSnapshot'
+    const char* entry = fileData + (*stringOffsets)[index];
+    mappedString.assign(entry + 4, loadU32(entry));
+    return mappedString;
+}
+
+std::uint32_t BinarySnapshot::RecordReader::readStringIndex() {
+
+    std::uint32_t index = readU32();
+    std::size_t tableSize = strings ? strings->size() : stringOffsets->size();
+    if (index >= tableSize) {
+        throw std::runtime_error("Invalid string index " + std::to_string(index) + " in snapshot record\n");
+    }
+    return index;
+}
+
+
+// === CODIFICA / DECODIFICA ===
+
+std::string BinarySnapshot::encode(const std::vector<std::shared_ptr<Media::AbstractMedia>>& media) {
+
+    RecordWriter writer;
+    Visitors::SnapshotEncoder encoder(writer);
+    for (const auto& m : media) {
+        if (m) {
+            m->accept(encoder);
+        }
+    }
+
+    // la tabella delle stringhe e' completa solo dopo aver codificato tutti i record, che vengono quindi scritti per ultimi
+    std::size_t tableSize = 0;
+    for (const std::string* s : writer.getStrings()) {
+        tableSize += 4 + s->size();
+    }
+
+    std::string out;
+    out.reserve(FILE_HEADER_SIZE + tableSize + writer.getRecordBytes().size());
+    out.append(FILE_MAGIC, 4);
+    appendU32(out, FORMAT_VERSION);
+    appendU32(out, static_cast<std::uint32_t>(writer.getStrings().size()));
+    appendU32(out, writer.getRecordCount());
+    for (const std::string* s : writer.getStrings()) {
+        appendU32(out, static_cast<std::uint32_t>(s->size()));
+        out.append(*s);
+    }
+    out.append(writer.getRecordBytes());
+    return out;
+}
+
+std::vector<std::shared_ptr<Media::AbstractMedia>> BinarySnapshot::decode(const char* data, std::size_t size, unsigned int& skippedRecords) {
+
+    skippedRecords = 0;
+    if (size < FILE_HEADER_SIZE || std::memcmp(data, FILE_MAGIC, 4) != 0) {
+        throw std::runtime_error("Not a library snapshot\n");
+    }
+    std::uint32_t version = loadU32(data + 4);
+    if (version != FORMAT_VERSION) {
+        throw std::runtime_error("Unsupported snapshot version " + std::to_string(version) + "\n");
+    }
+    std::uint32_t stringCount = loadU32(data + 8);
+    std::uint32_t recordCount = loadU32(data + 12);
+
+    const char* current = data + FILE_HEADER_SIZE;
+    const char* end = data + size;
+
+    // i conteggi dell'intestazione vengono verificati rispetto ai byte disponibili prima di riservare memoria (ogni stringa occupa almeno 4 byte)
+    if (stringCount > static_cast<std::size_t>(end - current) / 4) {
+        throw std::runtime_error("Invalid snapshot string count " + std::to_string(stringCount) + "\n");
+    }
+
+    // tabella delle stringhe
+    std::vector<std::string> strings;
+    strings.reserve(stringCount);
+    for (std::uint32_t i = 0; i < stringCount; ++i) {
+        if (end - current < 4) throw std::runtime_error("Truncated snapshot string table\n");
+        std::uint32_t length = loadU32(current);
+        current += 4;
+        if (static_cast<std::size_t>(end - current) < length) throw std::runtime_error("Truncated snapshot string table\n");
+        strings.emplace_back(current, length);
+        current += length;
+    }
+
+    // record (ogni record occupa almeno la propria intestazione)
+    if (recordCount > static_cast<std::size_t>(end - current) / RECORD_HEADER_SIZE) {
+        throw std::runtime_error("Invalid snapshot record count " + std::to_string(recordCount) + "\n");
+    }
+    std::vector<std::shared_ptr<Media::AbstractMedia>> media;
+    media.reserve(recordCount);
+    for (std::uint32_t i = 0; i < recordCount; ++i) {
+        if (static_cast<std::size_t>(end - current) < RECORD_HEADER_SIZE) throw std::runtime_error("Truncated snapshot record header\n");
+        std::uint8_t type = static_cast<std::uint8_t>(current[0]);
+        std::uint32_t length = loadU32(current + 1);
+        current += RECORD_HEADER_SIZE;
+        if (static_cast<std::size_t>(end - current) < length) throw std::runtime_error("Truncated snapshot record\n");
+
+        if (type <= static_cast<std::uint8_t>(RecordType::Image)) {
+            RecordReader reader(strings, current, length);
+            media.push_back(decodeRecord(static_cast<RecordType>(type), reader));
+        }
+        else {
+            ++skippedRecords;
+        }
+        current += length;
+    }
+    return media;
+}
+
+void BinarySnapshot::indexSnapshot(const char* data, std::size_t size, std::vector<std::uint64_t>& stringOffsets,
+                                   std::vector<std::uint64_t>& recordOffsets, unsigned int& skippedRecords) {
+
+    skippedRecords = 0;
+    stringOffsets.clear();
+    recordOffsets.clear();
+    if (size < FILE_HEADER_SIZE || std::memcmp(data, FILE_MAGIC, 4) != 0) {
+        throw std::runtime_error("Not a library snapshot\n");
+    }
+    std::uint32_t version = loadU32(data + 4);
+    if (version != FORMAT_VERSION) {
+        throw std::runtime_error("Unsupported snapshot version " + std::to_string(version) + "\n");
+    }
+    std::uint32_t stringCount = loadU32(data + 8);
+    std::uint32_t recordCount = loadU32(data + 12);
+
+    // vengono letti solo i prefissi di lunghezza, il contenuto di stringhe e record non viene toccato
+    std::size_t offset = FILE_HEADER_SIZE;
+    // come in 'decode', i conteggi dell'intestazione vengono limitati dai byte disponibili prima di riservare memoria
+    if (stringCount > (size - offset) / 4) {
+        throw std::runtime_error("Invalid snapshot string count " + std::to_string(stringCount) + "\n");
+    }
+    stringOffsets.reserve(stringCount);
+    for (std::uint32_t i = 0; i < stringCount; ++i) {
+        if (size - offset < 4) throw std::runtime_error("Truncated snapshot string table\n");
+        std::uint32_t length = loadU32(data + offset);
+        if (size - offset - 4 < length) throw std::runtime_error("Truncated snapshot string table\n");
+        stringOffsets.push_back(offset);
+        offset += 4 + length;
+    }
+
+    if (recordCount > (size - offset) / RECORD_HEADER_SIZE) {
+        throw std::runtime_error("Invalid snapshot record count " + std::to_string(recordCount) + "\n");
+    }
+    recordOffsets.reserve(recordCount);
+    for (std::uint32_t i = 0; i < recordCount; ++i) {
+        if (size - offset < RECORD_HEADER_SIZE) throw std::runtime_error("Truncated snapshot record header\n");
+        std::uint8_t type = static_cast<std::uint8_t>(data[offset]);
+        std::uint32_t length = loadU32(data + offset + 1);
+        if (size - offset - RECORD_HEADER_SIZE < length) throw std::runtime_error("Truncated snapshot record\n");
+
+        if (type <= static_cast<std::uint8_t>(RecordType::Image)) {
+            recordOffsets.push_back(offset);
+        }
+        else {
+            ++skippedRecords;
+        }
+        offset += RECORD_HEADER_SIZE + length;
+    }
+}
+
+std::shared_ptr<Media::AbstractMedia> BinarySnapshot::decodeRecord(RecordType type, RecordReader& reader) {
+
+    auto media = createRecordMedia(type);
+    Visitors::SnapshotDecoder decoder(reader);
+    media->accept(decoder);
+    return media;
+}
+
+std::uint32_t BinarySnapshot::loadU32(const char* data) {
+
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(data);
+    return static_cast<std::uint32_t>(bytes[0]) | (static_cast<std::uint32_t>(bytes[1]) << 8) |
+           (static_cast<std::uint32_t>(bytes[2]) << 16) | (static_cast<std::uint32_t>(bytes[3]) << 24);
+}
+
+bool BinarySnapshot::isSnapshotFile(const std::string& filename) {
+
+    return filename.size() >= FILE_EXTENSION.size() &&
+           filename.compare(filename.size() - FILE_EXTENSION.size(), FILE_EXTENSION.size(), FILE_EXTENSION) == 0;
+}
+
+}
+}
@@ -0,0 +1,188 @@
+#ifndef MODEL_LIBRARY_BINARY_SNAPSHOT_H
+#define MODEL_LIBRARY_BINARY_SNAPSHOT_H
+
+#include "Model/Media/AbstractMedia.h"
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <cstddef>
+#include <unordered_map>
+
+/** @brief BinarySnapshot
+ *
+ *  BinarySnapshot implementa un formato binario compatto e versionato per il salvataggio/caricamento della libreria, alternativo al formato JSON
+ *  (che resta il formato di interscambio). Il formato evita la costruzione di un albero JSON intermedio: in lettura ogni record viene decodificato
+ *  direttamente nel media corrispondente.
+ *
+ *  Struttura del file (interi little-endian, float IEEE-754 a 32 bit):
+ *  - intestazione : magic "VLBS" (4 byte), versione (u32), numero di stringhe (u32), numero di record (u32)
+ *  - tabella delle stringhe : per ogni stringa distinta, lunghezza (u32) seguita dai byte UTF-8
+ *  - record : per ogni media, tipo (u8, RecordType), lunghezza del contenuto (u32) e contenuto
+ *
+ *  Nei record le stringhe sono salvate come indice (u32) nella tabella delle stringhe, in modo che valori ripetuti (formati, generi, ...)
+ *  vengano salvati una sola volta. L'ordine dei campi di ciascun tipo e' definito dai visitor SnapshotEncoder e SnapshotDecoder.
+ *  Grazie alla lunghezza esplicita, i record di tipo sconosciuto vengono saltati e i byte in eccesso alla fine di un record vengono ignorati.
+ *
+ *  Come per il caricamento da JSON, ad ogni media caricato viene assegnato un nuovo identificatore univoco, e il contatore degli identificatori
+ *  viene portato almeno al valore dell'identificatore salvato.
+ *
+ *  Oltre alla decodifica completa, 'indexSnapshot' permette di calcolare solo le posizioni di stringhe e record, usate da MappedSnapshot
+ *  per leggere i record direttamente da un file mappato in memoria.
+ */
+
+namespace Model {
+namespace Library {
+
+class BinarySnapshot {
+
+public:
+
+    // === COSTANTI STATICHE ===
+
+    static const char FILE_MAGIC[4];              // "VLBS"
+    static const std::uint32_t FORMAT_VERSION;    // versione corrente del formato
+    static const std::string FILE_EXTENSION;      // estensione dei file snapshot (".vlib")
+    static const std::size_t FILE_HEADER_SIZE;    // lunghezza dell'intestazione del file
+    static const std::size_t RECORD_HEADER_SIZE;  // lunghezza dell'intestazione di un record (tipo e lunghezza)
+
+    /** @brief RecordType : tipo di media di un record */
+    enum class RecordType : std::uint8_t { Audio = 0, Video, EBook, Image };
+
+
+    /** @brief RecordWriter : scrittura dei record, con costruzione della tabella delle stringhe */
+    class RecordWriter {
+
+    public:
+
+        /** @brief beginRecord : inizia un nuovo record del tipo indicato */
+        void beginRecord(RecordType type);
+        /** @brief endRecord : chiude il record corrente, scrivendone la lunghezza */
+        void endRecord();
+
+        void writeU8(std::uint8_t value);
+        void writeU32(std::uint32_t value);
+        void writeI32(std::int32_t value);
+        void writeF32(float value);
+        /** @brief writeString : scrive l'indice della stringa nella tabella (aggiungendola se non presente) */
+        void writeString(const std::string& value);
+
+        unsigned int getRecordCount() const;
+        const std::vector<const std::string*>& getStrings() const;
+        const std::string& getRecordBytes() const;
+
+    private:
+
+        std::string records;                                        // record codificati
+        std::size_t recordStart = 0;                                // posizione dell'intestazione del record corrente
+        unsigned int recordCount = 0;                               // numero di record completati
+        std::unordered_map<std::string, std::uint32_t> stringIDs;   // stringa -> indice nella tabella
+        std::vector<const std::string*> strings;                    // tabella delle stringhe, in ordine di indice
+    };
+
+
+    /** @brief RecordReader : lettura del contenuto di un record, con verifica dei limiti */
+    class RecordReader {
+
+    public:
+
+        /**
+         * @brief RecordReader : costruttore
+         * @param table : tabella delle stringhe del file
+         * @param data : inizio del contenuto del record
+         * @param size : lunghezza del contenuto
+         */
+        RecordReader(const std::vector<std::string>& table, const char* data, std::size_t size);
+
+        /**
+         * @brief RecordReader : costruttore per un file mappato in memoria, le stringhe vengono lette direttamente dalla tabella nel file
+         * @param fileData : inizio del file
+         * @param offsets : posizioni (nel file) delle stringhe della tabella, come calcolate da 'indexSnapshot'
+         * @param data : inizio del contenuto del record
+         * @param size : lunghezza del contenuto
+         */
+        RecordReader(const char* fileData, const std::vector<std::uint64_t>& offsets, const char* data, std::size_t size);
+
+        // i metodi di lettura lanciano std::runtime_error se il record e' troncato o l'indice di una stringa non e' valido
+        std::uint8_t readU8();
+        std::uint32_t readU32();
+        std::int32_t readI32();
+        float readF32();
+        /** @brief readString : legge una stringa (il riferimento resta valido fino alla lettura successiva) */
+        const std::string& readString();
+        /** @brief readStringIndex : legge l'indice di una stringa nella tabella, senza leggerne il contenuto */
+        std::uint32_t readStringIndex();
+
+    private:
+
+        const std::vector<std::string>* strings;        // tabella delle stringhe decodificata, oppure 'nullptr'
+        const char* fileData;                           // file mappato (se 'strings' e' 'nullptr')
+        const std::vector<std::uint64_t>* stringOffsets; // posizioni delle stringhe nel file mappato
+        std::string mappedString;                       // ultima stringa letta dal file mappato
+        const char* current;
+        const char* end;
+
+        void require(std::size_t bytes) const;
+    };
+
+
+    // === CODIFICA / DECODIFICA ===
+
+    /**
+     * @brief encode : codifica i media nel formato snapshot
+     * @param media : media da salvare, nell'ordine della libreria
+     * @return std::string : contenuto binario del file
+     */
+    static std::string encode(const std::vector<std::shared_ptr<Media::AbstractMedia>>& media);
+
+    /**
+     * @brief decode : decodifica il contenuto di un file snapshot
+     * @param data : contenuto del file
+     * @param size : lunghezza del contenuto
+     * @param skippedRecords : numero di record di tipo sconosciuto saltati
+     * @return std::vector : media decodificati, nell'ordine del file (non ancora validati)
+     * @throws std::runtime_error : se il contenuto non e' uno snapshot valido (magic, versione, conteggi dell'intestazione) o e' troncato
+     */
+    static std::vector<std::shared_ptr<Media::AbstractMedia>> decode(const char* data, std::size_t size, unsigned int& skippedRecords);
+
+    /**
+     * @brief indexSnapshot : verifica la struttura di un file snapshot e calcola le posizioni di stringhe e record, senza decodificarli
+     * @param data : contenuto del file
+     * @param size : lunghezza del contenuto
+     * @param stringOffsets : posizioni delle stringhe della tabella (della loro lunghezza)
+     * @param recordOffsets : posizioni dei record di tipo noto (della loro intestazione)
+     * @param skippedRecords : numero di record di tipo sconosciuto saltati
+     * @throws std::runtime_error : se il contenuto non e' uno snapshot valido (magic, versione, conteggi dell'intestazione) o e' troncato
+     */
+    static void indexSnapshot(const char* data, std::size_t size, std::vector<std::uint64_t>& stringOffsets,
+                              std::vector<std::uint64_t>& recordOffsets, unsigned int& skippedRecords);
+
+    /**
+     * @brief decodeRecord : decodifica il contenuto di un record in un nuovo media del tipo indicato
+     * @param type : tipo del record
+     * @param reader : lettore posizionato all'inizio del contenuto del record
+     * @return std::shared_ptr<AbstractMedia> : media decodificato
+     * @throws std::runtime_error : se il record e' troncato
+     */
+    static std::shared_ptr<Media::AbstractMedia> decodeRecord(RecordType type, RecordReader& reader);
+
+    /**
+     * @brief loadU32 : legge un intero little-endian a 32 bit
+     * @param data : primo byte dell'intero
+     * @return std::uint32_t : valore letto
+     */
+    static std::uint32_t loadU32(const char* data);
+
+    /**
+     * @brief isSnapshotFile : verifica se un nome di file ha l'estensione dei file snapshot
+     * @param filename : nome del file
+     * @return bool : true se il nome termina con FILE_EXTENSION
+     */
+    static bool isSnapshotFile(const std::string& filename);
+};
+
+}
+}
+
+#endif // MODEL_LIBRARY_BINARY_SNAPSHOT_H
@@ -0,0 +1,186 @@
+#include "BatchCommand.h"
+#include "InsertCommand.h"
+#include "EditCommand.h"
+#include "RemoveCommand.h"
+#include "Model/Visitors/MediaValidator.h"
+
+#include <unordered_set>
+#include <string>
+
+namespace Model {
+namespace Library {
+namespace Command {
+
+BatchCommand::BatchCommand(Library* lib)
+    : libraryPtr(lib),
+    executed(false)
+{}
+
+
+// === OPERAZIONI ===
+
+void BatchCommand::addInsert(const std::shared_ptr<Media::AbstractMedia>& media) {
+    pendingOperations.push_back({ OperationType::Insert, media ? media->getUniqueID() : 0, media, {} });
+}
+
+void BatchCommand::addEdit(unsigned int id, const std::unordered_map<std::string, std::string>& mediaEdits) {
+    pendingOperations.push_back({ OperationType::Edit, id, nullptr, mediaEdits });
+}
+
+void BatchCommand::addRemove(unsigned int id) {
+    pendingOperations.push_back({ OperationType::Remove, id, nullptr, {} });
+}
+
+unsigned int BatchCommand::getOperationCount() const {
+    return static_cast<unsigned int>(executed || !commands.empty() ? commands.size() : pendingOperations.size());
+}
+
+void BatchCommand::validate() const {
+
+    if (!libraryPtr) return;
+
+    // media inseriti o rimossi dalle operazioni precedenti del batch
+    std::unordered_set<unsigned int> insertedIDs;
+    std::unordered_set<unsigned int> removedIDs;
+    auto exists = [&](unsigned int id) {
+        if (removedIDs.count(id)) return false;
+        if (insertedIDs.count(id)) return true;
+        return libraryPtr->getMediaIndexByID(id) < libraryPtr->getLibrarySize();
+    };
+
+    std::string errorMessage;
+    for (std::size_t i = 0; i < pendingOperations.size(); ++i) {
+
+        const Operation& operation = pendingOperations[i];
+        std::string prefix = "Operation " + std::to_string(i) + ": ";
+
+        switch (operation.type) {
+
+        case OperationType::Insert:
+            if (!operation.media) {
+                errorMessage += prefix + "Media to insert is not valid.\n";
+                break;
+            }
+            if (exists(operation.id)) {
+                errorMessage += prefix + "Media with ID=" + std::to_string(operation.id) + " is already in the library.\n";
+                break;
+            }
+            try {
+                Visitors::MediaValidator validator;
+                operation.media->accept(validator);
+            }
+            catch (const Visitors::MediaValidatorException& e) {
+                errorMessage += prefix + std::string(e.what());
+            }
+            removedIDs.erase(operation.id);
+            insertedIDs.insert(operation.id);
+            break;
+
+        case OperationType::Edit:
+            if (!exists(operation.id)) {
+                errorMessage += prefix + "No media with ID=" + std::to_string(operation.id) + " to edit.\n";
+            }
+            break;
+
+        case OperationType::Remove:
+            if (!exists(operation.id)) {
+                errorMessage += prefix + "No media with ID=" + std::to_string(operation.id) + " to remove.\n";
+                break;
+            }
+            insertedIDs.erase(operation.id);
+            removedIDs.insert(operation.id);
+            break;
+        }
+    }
+
+    if (!errorMessage.empty()) {
+        throw Visitors::MediaValidatorException(errorMessage);
+    }
+}
+
+
+// === RIDEFINIZIONE IAbstractCommand ===
+
+void BatchCommand::execute() {
+
+    if (!libraryPtr || executed) return;
+
+    libraryPtr->beginBatchUpdate();
+    bool firstExecution = commands.empty();
+    std::size_t done = 0;
+    try {
+        if (firstExecution) {
+            // i comandi vengono creati uno alla volta, ciascuno sullo stato lasciato dai precedenti
+            commands.reserve(pendingOperations.size());
+            for (const Operation& operation : pendingOperations) {
+                commands.push_back(createCommand(operation));
+                commands.back()->execute();
+                ++done;
+            }
+        }
+        else {
+            for (; done < commands.size(); ++done) {
+                commands[done]->execute();
+            }
+        }
+    }
+    catch (...) {
+        // annulla le operazioni gia' eseguite: la libreria torna allo stato precedente al batch
+        while (done > 0) {
+            commands[--done]->undo();
+        }
+        if (firstExecution) commands.clear();
+        libraryPtr->endBatchUpdate();
+        throw;
+    }
+
+    // dopo la prima esecuzione le operazioni sono conservate solo nei comandi
+    pendingOperations.clear();
+    pendingOperations.shrink_to_fit();
+    executed = true;
+    libraryPtr->endBatchUpdate();
+}
+
+void BatchCommand::undo() {
+
+    if (libraryPtr && executed) {
+        libraryPtr->beginBatchUpdate();
+        for (auto it = commands.rbegin(); it != commands.rend(); ++it) {
+            (*it)->undo();
+        }
+        executed = false;
+        libraryPtr->endBatchUpdate();
+    }
+}
+
+std::string BatchCommand::getCommandInfo() const {
+
+    return "Batch of " + std::to_string(getOperationCount()) + " operations";
+}
+
+std::size_t BatchCommand::getMemoryUsage() const {
+
+    std::size_t memory = sizeof(*this) + commands.capacity() * sizeof(std::shared_ptr<IAbstractCommand>) +
+                         pendingOperations.capacity() * sizeof(Operation);
+    for (const auto& command : commands) {
+        memory += command->getMemoryUsage();
+    }
+    return memory;
+}
+
+std::shared_ptr<IAbstractCommand> BatchCommand::createCommand(const Operation& operation) const {
+
+    switch (operation.type) {
+    case OperationType::Insert:
+        return std::make_shared<InsertCommand>(libraryPtr, operation.media);
+    case OperationType::Edit:
+        return std::make_shared<EditCommand>(libraryPtr, operation.id, operation.edits);
+    case OperationType::Remove:
+        return std::make_shared<RemoveCommand>(libraryPtr, operation.id);
+    }
+    return nullptr;
+}
+
+}
+}
+}
@@ -0,0 +1,136 @@
+#ifndef MODEL_LIBRARY_BATCH_COMMAND_H
+#define MODEL_LIBRARY_BATCH_COMMAND_H
+
+#include "IAbstractCommand.h"
+#include "Model/Library/Library.h"
+#include "Model/Media/AbstractMedia.h"
+
+#include <unordered_map>
+#include <string>
+#include <vector>
+#include <memory>
+
+/** @brief BatchCommand
+ *
+ *  BatchCommand e' una sottoclasse concreta che deriva pubblicamente da IAbstractCommand.
+ *  Implementa il design pattern "Command" (nella variante composita) per eseguire un insieme di inserimenti, modifiche e rimozioni come un'unica transazione,
+ *  annullabile e ripristinabile in un solo passo.
+ *
+ *  Le operazioni vengono accodate con 'addInsert', 'addEdit' e 'addRemove', facendo riferimento ai media tramite il loro identificatore univoco
+ *  (le posizioni cambiano durante l'esecuzione). Prima dell'esecuzione, 'validate' verifica tutte le operazioni insieme, senza modificare la libreria:
+ *  i media da inserire devono essere validi e con identificatore non presente, i media da modificare o rimuovere devono esistere al momento dell'operazione.
+ *
+ *  Il metodo 'execute' crea ed esegue in ordine un comando concreto (InsertCommand, EditCommand, RemoveCommand) per ciascuna operazione. Se un'operazione fallisce,
+ *  quelle gia' eseguite vengono annullate in ordine inverso e l'eccezione viene propagata: la libreria torna allo stato precedente al batch.
+ *  Il metodo 'undo' annulla tutti i comandi in ordine inverso, un nuovo 'execute' (Redo) li riesegue nell'ordine originale.
+ *
+ *  Esecuzione e annullamento avvengono all'interno di un aggiornamento in blocco della libreria ('beginBatchUpdate'/'endBatchUpdate'): l'osservatore riceve
+ *  un'unica notifica al termine, e i messaggi informativi delle singole operazioni non vengono registrati.
+ */
+
+
+namespace Model {
+namespace Library {
+namespace Command {
+
+class BatchCommand : public IAbstractCommand {
+
+public:
+
+    /**
+     * @brief BatchCommand : costruttore, crea un batch vuoto
+     * @param lib : puntatore alla libreria
+     */
+    explicit BatchCommand(Library* lib);
+
+
+    // === OPERAZIONI ===
+
+    /**
+     * @brief addInsert : accoda l'inserimento di un media (in fondo alla libreria)
+     * @param media : smart pointer al media da inserire
+     */
+    void addInsert(const std::shared_ptr<Media::AbstractMedia>& media);
+
+    /**
+     * @brief addEdit : accoda la modifica di un media
+     * @param id : identificatore univoco del media da modificare
+     * @param mediaEdits : mappa di modifiche
+     */
+    void addEdit(unsigned int id, const std::unordered_map<std::string, std::string>& mediaEdits);
+
+    /**
+     * @brief addRemove : accoda la rimozione di un media
+     * @param id : identificatore univoco del media da rimuovere
+     */
+    void addRemove(unsigned int id);
+
+    /**
+     * @brief getOperationCount : restituisce il numero di operazioni del batch
+     * @return unsigned int : numero di operazioni
+     */
+    unsigned int getOperationCount() const;
+
+    /**
+     * @brief validate : verifica tutte le operazioni accodate rispetto allo stato attuale della libreria, senza modificarla
+     * @throws MediaValidatorException con la lista di tutti gli errori trovati, se almeno un'operazione non e' valida
+     */
+    void validate() const;
+
+
+    // === RIDEFINIZIONE IAbstractCommand ===
+
+    /**
+     * @brief execute : ridefinizione metodo virtuale puro ereditato da IAbstractCommand, esegue tutte le operazioni del batch in ordine
+     * @throws MediaValidatorException se un'operazione fallisce (le operazioni gia' eseguite vengono annullate)
+     */
+    void execute() override;
+
+    /**
+     * @brief undo : ridefinizione metodo virtuale puro ereditato da IAbstractCommand, annulla tutte le operazioni del batch in ordine inverso
+     */
+    void undo() override;
+
+    /**
+     * @brief getCommandInfo : ridefinizione metodo virtuale puro ereditato da IAbstractCommand, restituisce dettagli sul batch
+     * @return std::string : dettagli sul batch
+     */
+    std::string getCommandInfo() const override;
+
+    /**
+     * @brief getMemoryUsage : ridefinizione metodo virtuale puro ereditato da IAbstractCommand, stima la memoria trattenuta dal batch
+     * @return std::size_t : memoria stimata (in byte) del batch e di tutti i suoi comandi
+     */
+    std::size_t getMemoryUsage() const override;
+
+private:
+
+    /** @brief OperationType : tipo di un'operazione accodata */
+    enum class OperationType { Insert, Edit, Remove };
+
+    /** @brief Operation : operazione accodata, non ancora eseguita */
+    struct Operation {
+        OperationType type;                                     // tipo di operazione
+        unsigned int id;                                        // identificatore univoco del media
+        std::shared_ptr<Media::AbstractMedia> media;            // media da inserire (Insert)
+        std::unordered_map<std::string, std::string> edits;     // modifiche da effettuare (Edit)
+    };
+
+    Library* libraryPtr;                                        // puntatore alla libreria
+    std::vector<Operation> pendingOperations;                   // operazioni accodate (svuotato dopo la prima esecuzione)
+    std::vector<std::shared_ptr<IAbstractCommand>> commands;    // comandi eseguiti, in ordine di esecuzione
+    bool executed;                                              // indica se il batch e' stato eseguito oppure no
+
+    /**
+     * @brief createCommand : crea il comando concreto di un'operazione (subito prima di eseguirlo)
+     * @param operation : operazione accodata
+     * @return std::shared_ptr<IAbstractCommand> : comando concreto
+     */
+    std::shared_ptr<IAbstractCommand> createCommand(const Operation& operation) const;
+};
+
+}
+}
+}
+
+#endif // MODEL_LIBRARY_BATCH_COMMAND_H
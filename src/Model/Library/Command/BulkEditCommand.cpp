@@ -0,0 +1,101 @@
+#include "BulkEditCommand.h"
+
+namespace Model {
+namespace Library {
+namespace Command {
+
+BulkEditCommand::BulkEditCommand(
+    Library* lib,
+    std::vector<unsigned int> ids,
+    const std::unordered_map<std::string, std::string>& mediaEdits,
+    unsigned int threadCount)
+    : libraryPtr(lib),
+    mediaIDs(std::move(ids)),
+    edits(mediaEdits),
+    threads(threadCount),
+    firstExecution(true),
+    edited(false)
+{}
+
+
+// === GETTER ===
+
+const std::vector<std::pair<unsigned int, std::string>>& BulkEditCommand::getFailures() const { return failures; }
+
+unsigned int BulkEditCommand::getEditedCount() const {
+    return firstExecution ? 0 : static_cast<unsigned int>(mediaIDs.size());
+}
+
+
+// === RIDEFINIZIONE IAbstractCommand ===
+
+void BulkEditCommand::execute() {
+
+    if (!libraryPtr || edited) return;
+
+    if (!firstExecution) {
+        // Redo: i media modificati sono tornati ai valori precedenti, le stesse modifiche hanno quindi lo stesso esito
+        libraryPtr->editLibraryMediaByIDs(mediaIDs, { edits }, threads);
+        edited = true;
+        return;
+    }
+
+    std::vector<std::unordered_map<std::string, std::string>> previous;
+    std::vector<std::string> errors = libraryPtr->editLibraryMediaByIDs(mediaIDs, { edits }, threads, &previous);
+
+    // vengono conservati solo i media effettivamente modificati, con i rispettivi valori precedenti
+    std::vector<unsigned int> editedIDs;
+    for (std::size_t i = 0; i < mediaIDs.size(); ++i) {
+        if (!errors[i].empty()) {
+            failures.emplace_back(mediaIDs[i], errors[i]);
+        }
+        else if (!previous[i].empty()) {
+            editedIDs.push_back(mediaIDs[i]);
+            previousValues.push_back(std::move(previous[i]));
+        }
+    }
+    mediaIDs = std::move(editedIDs);
+    previousValues.shrink_to_fit();
+    firstExecution = false;
+    edited = true;
+}
+
+void BulkEditCommand::undo() {
+
+    if (libraryPtr && edited) {
+        libraryPtr->editLibraryMediaByIDs(mediaIDs, previousValues, threads);
+        edited = false;
+    }
+}
+
+std::string BulkEditCommand::getCommandInfo() const {
+
+    return "Edited " + std::to_string(mediaIDs.size()) + " media";
+}
+
+std::size_t BulkEditCommand::getMemoryUsage() const {
+
+    std::size_t memory = sizeof(*this) + mediaIDs.capacity() * sizeof(unsigned int) + mapMemoryUsage(edits) +
+                         previousValues.capacity() * sizeof(std::unordered_map<std::string, std::string>);
+    for (const auto& values : previousValues) {
+        memory += mapMemoryUsage(values);
+    }
+    for (const auto& failure : failures) {
+        memory += sizeof(failure) + failure.second.size();
+    }
+    return memory;
+}
+
+std::size_t BulkEditCommand::mapMemoryUsage(const std::unordered_map<std::string, std::string>& values) {
+
+    std::size_t memory = 0;
+    for (const auto& value : values) {
+        // nodo della mappa (con il puntatore del bucket) e contenuto delle stringhe
+        memory += sizeof(value) + 2 * sizeof(void*) + value.first.size() + value.second.size();
+    }
+    return memory;
+}
+
+}
+}
+}
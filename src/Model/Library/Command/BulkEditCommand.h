@@ -0,0 +1,105 @@
+#ifndef MODEL_LIBRARY_BULK_EDIT_COMMAND_H
+#define MODEL_LIBRARY_BULK_EDIT_COMMAND_H
+
+#include "IAbstractCommand.h"
+#include "Model/Library/Library.h"
+
+#include <unordered_map>
+#include <string>
+#include <vector>
+#include <utility>
+
+/** @brief BulkEditCommand
+ *
+ *  BulkEditCommand e' una sottoclasse concreta che deriva pubblicamente da IAbstractCommand.
+ *  Implementa il design pattern "Command" per applicare la stessa mappa di modifiche a un insieme di media (ad esempio i risultati di una ricerca)
+ *  come un'unica operazione annullabile.
+ *
+ *  Le modifiche vengono applicate in parallelo con 'Library::editLibraryMediaByIDs'. Un media la cui modifica fallisce resta invariato e viene
+ *  riportato, con il relativo messaggio d'errore, in 'getFailures': gli altri media vengono modificati comunque.
+ *  Come EditCommand, per ogni media modificato viene salvato solo il valore precedente dei campi effettivamente cambiati; il metodo 'undo'
+ *  riapplica questi valori (anch'esso in parallelo), un nuovo 'execute' (Redo) riapplica le modifiche ai soli media modificati la prima volta.
+ */
+
+
+namespace Model {
+namespace Library {
+namespace Command {
+
+class BulkEditCommand : public IAbstractCommand {
+
+public:
+
+    /**
+     * @brief BulkEditCommand : costruttore
+     * @param lib : puntatore alla libreria
+     * @param ids : identificatori univoci dei media da modificare
+     * @param mediaEdits : mappa di modifiche, applicata a ciascun media
+     * @param threadCount : numero massimo di thread da utilizzare per le modifiche (1 per la modifica seriale)
+     */
+    BulkEditCommand(Library* lib, std::vector<unsigned int> ids, const std::unordered_map<std::string, std::string>& mediaEdits, unsigned int threadCount = 1);
+
+
+    // === GETTER ===
+
+    /**
+     * @brief getFailures : restituisce i media la cui modifica e' fallita alla prima esecuzione
+     * @return const std::vector& : coppie (identificatore univoco, messaggio d'errore), nell'ordine degli identificatori
+     */
+    const std::vector<std::pair<unsigned int, std::string>>& getFailures() const;
+
+    /**
+     * @brief getEditedCount : restituisce il numero di media effettivamente modificati alla prima esecuzione
+     * @return unsigned int : numero di media modificati
+     */
+    unsigned int getEditedCount() const;
+
+
+    // === RIDEFINIZIONE IAbstractCommand ===
+
+    /**
+     * @brief execute : ridefinizione metodo virtuale puro ereditato da IAbstractCommand, modifica i media
+     */
+    void execute() override;
+
+    /**
+     * @brief undo : ridefinizione metodo virtuale puro ereditato da IAbstractCommand, ripristina i valori precedenti dei media modificati
+     */
+    void undo() override;
+
+    /**
+     * @brief getCommandInfo : ridefinizione metodo virtuale puro ereditato da IAbstractCommand, restituisce dettagli sulla modifica
+     * @return std::string : dettagli sulla modifica
+     */
+    std::string getCommandInfo() const override;
+
+    /**
+     * @brief getMemoryUsage : ridefinizione metodo virtuale puro ereditato da IAbstractCommand, stima la memoria trattenuta dal comando
+     * @return std::size_t : memoria stimata (in byte) degli identificatori, delle modifiche e dei valori precedenti
+     */
+    std::size_t getMemoryUsage() const override;
+
+private:
+
+    Library* libraryPtr;                                                            // puntatore alla libreria
+    std::vector<unsigned int> mediaIDs;                                             // media da modificare (dopo la prima esecuzione: solo quelli modificati)
+    std::unordered_map<std::string, std::string> edits;                             // modifiche da effettuare
+    std::vector<std::unordered_map<std::string, std::string>> previousValues;       // valori precedenti dei campi cambiati, uno per media modificato
+    std::vector<std::pair<unsigned int, std::string>> failures;                     // media non modificati, con il messaggio d'errore
+    unsigned int threads;                                                           // numero massimo di thread
+    bool firstExecution;                                                            // indica se il comando non e' ancora stato eseguito
+    bool edited;                                                                    // indica se le modifiche sono attualmente applicate
+
+    /**
+     * @brief mapMemoryUsage : stima la memoria di una mappa di modifiche (nodi e contenuto delle stringhe)
+     * @param values : mappa di modifiche
+     * @return std::size_t : memoria stimata (in byte)
+     */
+    static std::size_t mapMemoryUsage(const std::unordered_map<std::string, std::string>& values);
+};
+
+}
+}
+}
+
+#endif // MODEL_LIBRARY_BULK_EDIT_COMMAND_H
@@ -0,0 +1,73 @@
+#include "BulkRemoveCommand.h"
+#include "Model/Visitors/AttributeReader.h"
+
+namespace Model {
+namespace Library {
+namespace Command {
+
+BulkRemoveCommand::BulkRemoveCommand(
+    Library* lib,
+    std::vector<unsigned int> ids)
+    : libraryPtr(lib),
+    mediaIDs(std::move(ids)),
+    removedMemory(0),
+    firstExecution(true),
+    removed(false)
+{}
+
+
+// === GETTER ===
+
+unsigned int BulkRemoveCommand::getRemovedCount() const { return static_cast<unsigned int>(removedMedia.size()); }
+
+
+// === RIDEFINIZIONE IAbstractCommand ===
+
+void BulkRemoveCommand::execute() {
+
+    if (!libraryPtr || removed) return;
+
+    if (!firstExecution) {
+        // Redo: i media sono stati reinseriti nelle posizioni originali, per cui vengono rimossi gli stessi media dalle stesse posizioni
+        libraryPtr->removeLibraryMediaByIDs(mediaIDs);
+        removed = true;
+        return;
+    }
+
+    libraryPtr->removeLibraryMediaByIDs(mediaIDs, &removedMedia);
+    mediaIDs.clear();
+    mediaIDs.reserve(removedMedia.size());
+    for (const auto& positioned : removedMedia) {
+        mediaIDs.push_back(positioned.second->getUniqueID());
+        removedMemory += Visitors::AttributeReader::estimateMemoryUsage(*positioned.second);
+    }
+    firstExecution = false;
+    removed = true;
+}
+
+void BulkRemoveCommand::undo() {
+
+    if (libraryPtr && removed) {
+        libraryPtr->restoreLibraryMediaAtPositions(removedMedia);
+        removed = false;
+    }
+}
+
+std::string BulkRemoveCommand::getCommandInfo() const {
+
+    return "Removed " + std::to_string(removedMedia.size()) + " media";
+}
+
+std::size_t BulkRemoveCommand::getMemoryUsage() const {
+
+    // finche' i media sono in libreria la memoria e' condivisa con la libreria
+    std::size_t memory = sizeof(*this) + mediaIDs.capacity() * sizeof(unsigned int) + removedMedia.capacity() * sizeof(Library::PositionedMedia);
+    if (removed) {
+        memory += removedMemory;
+    }
+    return memory;
+}
+
+}
+}
+}
@@ -0,0 +1,85 @@
+#ifndef MODEL_LIBRARY_BULK_REMOVE_COMMAND_H
+#define MODEL_LIBRARY_BULK_REMOVE_COMMAND_H
+
+#include "IAbstractCommand.h"
+#include "Model/Library/Library.h"
+
+#include <string>
+#include <vector>
+#include <cstddef>
+
+/** @brief BulkRemoveCommand
+ *
+ *  BulkRemoveCommand e' una sottoclasse concreta che deriva pubblicamente da IAbstractCommand.
+ *  Implementa il design pattern "Command" per rimuovere un insieme di media (ad esempio i risultati di una ricerca) come un'unica operazione annullabile.
+ *
+ *  La rimozione utilizza 'Library::removeLibraryMediaByIDs', che compatta la libreria in un solo passaggio invece di una cancellazione per ogni media.
+ *  Come RemoveCommand, i media rimossi vengono trattenuti (non copiati) insieme alla loro posizione: il metodo 'undo' li reinserisce tutti
+ *  nelle posizioni originali con 'Library::restoreLibraryMediaAtPositions', anch'esso in un solo passaggio e senza validarli di nuovo.
+ */
+
+
+namespace Model {
+namespace Library {
+namespace Command {
+
+class BulkRemoveCommand : public IAbstractCommand {
+
+public:
+
+    /**
+     * @brief BulkRemoveCommand : costruttore
+     * @param lib : puntatore alla libreria
+     * @param ids : identificatori univoci dei media da rimuovere
+     */
+    BulkRemoveCommand(Library* lib, std::vector<unsigned int> ids);
+
+
+    // === GETTER ===
+
+    /**
+     * @brief getRemovedCount : restituisce il numero di media rimossi dalla prima esecuzione
+     * @return unsigned int : numero di media rimossi
+     */
+    unsigned int getRemovedCount() const;
+
+
+    // === RIDEFINIZIONE IAbstractCommand ===
+
+    /**
+     * @brief execute : ridefinizione metodo virtuale puro ereditato da IAbstractCommand, rimuove i media
+     */
+    void execute() override;
+
+    /**
+     * @brief undo : ridefinizione metodo virtuale puro ereditato da IAbstractCommand, reinserisce i media rimossi nelle posizioni originali
+     */
+    void undo() override;
+
+    /**
+     * @brief getCommandInfo : ridefinizione metodo virtuale puro ereditato da IAbstractCommand, restituisce dettagli sulla rimozione
+     * @return std::string : dettagli sulla rimozione
+     */
+    std::string getCommandInfo() const override;
+
+    /**
+     * @brief getMemoryUsage : ridefinizione metodo virtuale puro ereditato da IAbstractCommand, stima la memoria trattenuta dal comando
+     * @return std::size_t : memoria stimata (in byte), che comprende i media rimossi solo finche' non sono in libreria
+     */
+    std::size_t getMemoryUsage() const override;
+
+private:
+
+    Library* libraryPtr;                                    // puntatore alla libreria
+    std::vector<unsigned int> mediaIDs;                     // media da rimuovere (dopo la prima esecuzione: solo quelli rimossi)
+    std::vector<Library::PositionedMedia> removedMedia;     // media rimossi, con la posizione prima della rimozione
+    std::size_t removedMemory;                              // memoria stimata dei media rimossi (calcolata una sola volta)
+    bool firstExecution;                                    // indica se il comando non e' ancora stato eseguito
+    bool removed;                                           // indica se i media sono attualmente rimossi
+};
+
+}
+}
+}
+
+#endif // MODEL_LIBRARY_BULK_REMOVE_COMMAND_H
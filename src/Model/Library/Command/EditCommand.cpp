@@ -1,7 +1,9 @@
 #include "EditCommand.h"
 #include "Model/Visitors/MediaValidator.h"
+#include "Model/Visitors/AttributeReader.h"
 
 #include <string>
+#include <vector>
 
 namespace Model {
 namespace Library {
@@ -13,15 +15,18 @@ EditCommand::EditCommand(
     const std::unordered_map<std::string, std::string>& mediaEdits)
     : libraryPtr(lib),
     editedID(id),
-    edits(mediaEdits),
     edited(false)
 {
+    // i valori precedenti vengono letti solo in 'execute', subito prima della modifica
+    for (const auto& edit : mediaEdits) {
+        fieldDeltas[edit.first].newValue = edit.second;
+    }
+
     if (libraryPtr) {
         // fetch del media
         auto media = libraryPtr->getMediaByID(editedID);
         if (media) {
-            // trasferisce ownership del media gestito ad una copia del media originale
-            originalMedia.reset(dynamic_cast<Media::AbstractMedia*>(media->clone()));
+            mediaName = media->getMediaName();
         }
     }
 }
@@ -29,35 +34,88 @@ EditCommand::EditCommand(
 void EditCommand::execute() {
 
     if (libraryPtr && !edited) {
+
+        auto media = libraryPtr->getMediaByID(editedID);
+        if (!media) return;
+
+        // legge il valore attuale dei soli attributi da modificare
+        std::vector<std::string> names;
+        names.reserve(fieldDeltas.size());
+        for (const auto& field : fieldDeltas) {
+            names.push_back(field.first);
+        }
+        Visitors::AttributeReader reader(names);
+        media->accept(reader);
+        const auto& currentValues = reader.getValues();
+
+        // mantiene solo i campi del media che cambiano davvero (gli altri non verrebbero comunque modificati)
+        for (auto it = fieldDeltas.begin(); it != fieldDeltas.end(); ) {
+            auto current = currentValues.find(it->first);
+            if (current == currentValues.end() || current->second == it->second.newValue) {
+                it = fieldDeltas.erase(it);
+            }
+            else {
+                it->second.oldValue = current->second;
+                ++it;
+            }
+        }
+
         try {
             // tenta la modifica
-            edited = libraryPtr->editLibraryMediaByID(editedID, edits);
+            edited = applyValues(true);
         }
         catch (const Visitors::MediaValidatorException& e) {
             throw Visitors::MediaValidatorException(std::string(e.what()));
         }
+
+        // un valore non interpretabile (ad esempio un numero o una data non validi) fa fallire la modifica senza eccezioni di validazione:
+        // viene segnalato allo stesso modo, in modo che il chiamante (ad esempio BatchCommand) non consideri la modifica riuscita
+        if (!edited) {
+            throw Visitors::MediaValidatorException("Could not edit media with ID=" + std::to_string(editedID) + ", one or more values are not valid.\n");
+        }
     }
 }
 
 void EditCommand::undo() {
 
     if (libraryPtr && edited) {
-        // rimuovi media modificato
-        libraryPtr->removeLibraryMediaByID(editedID);
-        // reinserisci il media originale salvato precedetemente
-        libraryPtr->insertLibraryMedia(originalMedia);
+        // ripristina sul media i valori precedenti dei campi modificati
+        applyValues(false);
         edited = false;
     }
 }
 
 std::string EditCommand::getCommandInfo() const {
 
-    if (originalMedia) {
-        return "Edited media '" + originalMedia->getMediaName() + "' with ID=" + std::to_string(editedID);
+    if (!mediaName.empty()) {
+        return "Edited media '" + mediaName + "' with ID=" + std::to_string(editedID);
     }
     else return "";
 }
 
+std::size_t EditCommand::getMemoryUsage() const {
+
+    std::size_t memory = sizeof(*this) + mediaName.size();
+    for (const auto& field : fieldDeltas) {
+        // nodo della mappa (con il puntatore del bucket) e contenuto delle stringhe
+        memory += sizeof(field) + 2 * sizeof(void*);
+        memory += field.first.size() + field.second.oldValue.size() + field.second.newValue.size();
+    }
+    return memory;
+}
+
+bool EditCommand::applyValues(bool newValues) {
+
+    // nessun campo cambia: il media e' gia' nello stato richiesto
+    if (fieldDeltas.empty()) return true;
+
+    std::unordered_map<std::string, std::string> values;
+    for (const auto& field : fieldDeltas) {
+        values.emplace(field.first, newValues ? field.second.newValue : field.second.oldValue);
+    }
+    return libraryPtr->editLibraryMediaByID(editedID, values);
+}
+
 
 }
 }
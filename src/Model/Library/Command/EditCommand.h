@@ -6,7 +6,7 @@
 #include "Model/Media/AbstractMedia.h"
 
 #include <unordered_map>
-#include <memory>
+#include <string>
 
 /** @brief EditCommand - REDO COMMENT
  *
@@ -14,8 +14,9 @@
  *  Implementa il design pattern "Command" per implementare l'operazione di modifica di un media della libreria.
  *
  *  EditCommand e' astratta in quanto va a ridefinire i due metodi virtuali puri 'execute' e 'undo' ereditati da IAbstractCommand.
- *  Il metodo 'execute' viene ridefinito per eseguire la modifica di un media, mantenendo una copia del media originale prima di applicare le modifiche.
- *  Il metodo 'undo' viene ridefinito per ripristinare il media appena modificato al suo stato originale. Questo e' fatto rimuovendo il media modificato e poi inserendo la copia dell'originale.
+ *  Il metodo 'execute' viene ridefinito per eseguire la modifica di un media. Prima di applicare le modifiche, salva il valore attuale dei soli attributi modificati
+ *  (letti con il visitor Model::Visitors::AttributeReader): il comando mantiene quindi solo le coppie (valore precedente, valore nuovo) dei campi cambiati, e non una copia del media.
+ *  Il metodo 'undo' viene ridefinito per ripristinare il media appena modificato al suo stato originale, riapplicando i valori precedenti sul media stesso (che resta nella sua posizione).
  *  Il metodo 'getCommandInfo' viene ridefinito per mostrare dettagli sull'ultima operazione di modifica effettuata oppure l'ultimo annullamento di modifica effettuata.
  *
  */
@@ -54,13 +55,32 @@ public:
      */
     std::string getCommandInfo() const override;
 
+    /**
+     * @brief getMemoryUsage : ridefinizione metodo virtuale puro ereditato da IAbstractCommand, stima la memoria trattenuta dal comando
+     * @return std::size_t : memoria stimata (in byte) del comando e dei valori dei campi modificati
+     */
+    std::size_t getMemoryUsage() const override;
+
 private:
 
+    /** @brief FieldDelta : valore precedente e nuovo valore di un attributo modificato */
+    struct FieldDelta {
+        std::string oldValue;   // valore prima della modifica (letto in 'execute')
+        std::string newValue;   // valore dopo la modifica
+    };
+
     Library* libraryPtr;                                            // puntatore alla libreria multimediale
     unsigned int editedID;                                          // identificatore del media da modificare
-    std::unordered_map<std::string, std::string> edits;             // mappa di coppie (nome/valore) delle modifiche
-    std::shared_ptr<Media::AbstractMedia> originalMedia;            // smart pointer con copia del media originale
+    std::unordered_map<std::string, FieldDelta> fieldDeltas;        // nome attributo -> valori precedente/nuovo dei campi modificati
+    std::string mediaName;                                          // nome del media prima della modifica
     bool edited;                                                    // indica se il media e' stato modificato oppure no
+
+    /**
+     * @brief applyValues : applica al media i valori precedenti o nuovi di tutti i campi modificati
+     * @param newValues : true per applicare i nuovi valori, false per ripristinare quelli precedenti
+     * @return bool : true se la modifica ha avuto successo
+     */
+    bool applyValues(bool newValues);
 };
 
 }
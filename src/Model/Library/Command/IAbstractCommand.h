@@ -2,6 +2,7 @@
 #define MODEL_LIBRARY_I_ABSTRACT_COMMAND_H
 
 #include <string>
+#include <cstddef>
 
 /** @brief IAbstractCommand - REDO COMMENT
  *
@@ -12,6 +13,7 @@
  *  IAbstractCommand e' astratta in quanto dispone dei due metodi virtuali puri 'execute' e 'undo' che vengono ridefiniti per implementare le operazioni Undo e Redo
  *  nel caso di inserimento, rimozione o modifica di un media in libreria.
  *  Inoltre, ho aggiunto il metodo virtuale puro 'getCommandInfo' che viene ridefinito per restituire una breve descrizione sull'ultima operazione Undo/Redo disponibile.
+ *  Il metodo virtuale puro 'getMemoryUsage' restituisce una stima della memoria trattenuta dal comando, utilizzata dal Manager per limitare la memoria della cronologia Undo/Redo.
  *
  */
 
@@ -35,6 +37,9 @@ public:
 
     /** @brief getCommandInfo : metodo virtuale puro, ridefinito per ottenere una descrizione dell'ultima operazione Undo/Redo disponibile */
     virtual std::string getCommandInfo() const = 0;
+
+    /** @brief getMemoryUsage : metodo virtuale puro, ridefinito per stimare la memoria (in byte) trattenuta dal comando nel suo stato attuale */
+    virtual std::size_t getMemoryUsage() const = 0;
 };
 
 }
@@ -1,4 +1,5 @@
 #include "InsertCommand.h"
+#include "Model/Visitors/AttributeReader.h"
 
 namespace Model {
 namespace Library {
@@ -15,9 +16,8 @@ InsertCommand::InsertCommand(
 void InsertCommand::execute() {
 
     if (libraryPtr && mediaPtr && !inserted) {
-        // inserisci media
-        libraryPtr->insertLibraryMedia(mediaPtr);
-        inserted = true;
+        // inserisci media in fondo (un media non valido non viene inserito)
+        inserted = libraryPtr->insertLibraryMediaAt(mediaPtr, libraryPtr->getLibrarySize());
     }
 }
 
@@ -39,6 +39,16 @@ std::string InsertCommand::getCommandInfo() const {
 
 }
 
+std::size_t InsertCommand::getMemoryUsage() const {
+
+    // finche' il media e' in libreria la memoria e' condivisa con la libreria
+    std::size_t memory = sizeof(*this);
+    if (mediaPtr && !inserted) {
+        memory += Visitors::AttributeReader::estimateMemoryUsage(*mediaPtr);
+    }
+    return memory;
+}
+
 
 }
 }
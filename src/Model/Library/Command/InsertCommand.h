@@ -51,6 +51,12 @@ public:
      */
     std::string getCommandInfo() const override;
 
+    /**
+     * @brief getMemoryUsage : ridefinizione metodo virtuale puro ereditato da IAbstractCommand, stima la memoria trattenuta dal comando
+     * @return std::size_t : memoria stimata (in byte), che comprende il media solo se non e' in libreria (inserimento annullato)
+     */
+    std::size_t getMemoryUsage() const override;
+
 private:
 
     Library* libraryPtr;                                      // puntatore alla libreria
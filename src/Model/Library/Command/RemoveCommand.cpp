@@ -1,4 +1,5 @@
 #include "RemoveCommand.h"
+#include "Model/Visitors/AttributeReader.h"
 
 namespace Model {
 namespace Library {
@@ -9,22 +10,20 @@ RemoveCommand::RemoveCommand(
     unsigned int id)
     : libraryPtr(lib),
     removedID(id),
+    removedIndex(0),
     removed(false)
 {
     if (libraryPtr) {
-        // fetch del media
-        auto media = libraryPtr->getMediaByID(removedID);
-        if (media) {
-            // crea un backup del media da rimuovere
-            backupMedia.reset(dynamic_cast<Media::AbstractMedia*>(media->clone()));
-        }
+        // fetch del media da rimuovere (viene trattenuto, non copiato)
+        backupMedia = libraryPtr->getMediaByID(removedID);
     }
 }
 
 void RemoveCommand::execute() {
 
     if (libraryPtr && !removed) {
-        // rimuovi il media
+        // salva la posizione e rimuovi il media
+        removedIndex = libraryPtr->getMediaIndexByID(removedID);
         removed = libraryPtr->removeLibraryMediaByID(removedID);
     }
 }
@@ -32,8 +31,8 @@ void RemoveCommand::execute() {
 void RemoveCommand::undo() {
 
     if (libraryPtr && removed && backupMedia) {
-        // reinserisci backup del media rimosso
-        libraryPtr->insertLibraryMedia(backupMedia);
+        // reinserisci il media rimosso nella sua posizione originale (il media e' gia' stato validato al primo inserimento)
+        libraryPtr->restoreLibraryMediaAt(backupMedia, removedIndex);
         removed = false;
     }
 }
@@ -47,6 +46,16 @@ std::string RemoveCommand::getCommandInfo() const {
 
 }
 
+std::size_t RemoveCommand::getMemoryUsage() const {
+
+    // finche' il media e' in libreria la memoria e' condivisa con la libreria
+    std::size_t memory = sizeof(*this);
+    if (backupMedia && removed) {
+        memory += Visitors::AttributeReader::estimateMemoryUsage(*backupMedia);
+    }
+    return memory;
+}
+
 }
 }
 }
@@ -13,8 +13,11 @@
  *  Implementa il design pattern "Command" per implementate l'operazione di rimozione di un media della libreria.
  *
  *  RemoveCommand e' astratta in quanto va a ridefinire i due metodi virtuali puri 'execute' e 'undo' ereditati da IAbstractCommand,
- *  Il metodo 'execute' viene ridefinito per effettuare la rimozione di un media, salvandone una copia mediante il metodo polimorfo 'clone'.
- *  Il metodo 'undo' viene ridefinito per reinserire nuovamente in libreria il media appena rimosso utilizzando la copia salvata.
+ *  Il metodo 'execute' viene ridefinito per effettuare la rimozione di un media. Il comando mantiene lo smart pointer al media rimosso (lo stesso oggetto che era in libreria),
+ *  senza farne una copia: dopo la rimozione nessun altro puo' modificarlo, quindi resta identico fino all'eventuale annullamento.
+ *  Il metodo 'undo' viene ridefinito per reinserire nuovamente in libreria il media appena rimosso, nella posizione che occupava prima della rimozione
+ *  (l'ordine della libreria e le posizioni degli altri media tornano quindi quelli precedenti alla rimozione). Il media, identico a quello rimosso,
+ *  viene reinserito con 'Library::restoreLibraryMediaAt' senza essere validato di nuovo.
  *  Il metodo 'getCommandInfo' viene ridefinito per mostrare dettagli sull'ultimo media rimosso oppure reinserito.
  *
  */
@@ -51,11 +54,18 @@ public:
      */
     std::string getCommandInfo() const override;
 
+    /**
+     * @brief getMemoryUsage : ridefinizione metodo virtuale puro ereditato da IAbstractCommand, stima la memoria trattenuta dal comando
+     * @return std::size_t : memoria stimata (in byte), che comprende il media solo mentre e' rimosso dalla libreria
+     */
+    std::size_t getMemoryUsage() const override;
+
 private:
 
     Library* libraryPtr;                                         // puntatore alla libreria
     unsigned int removedID;                                      // identificatore del media
-    std::shared_ptr<Media::AbstractMedia> backupMedia;           // copia del media rimosso
+    unsigned int removedIndex;                                   // posizione del media prima della rimozione
+    std::shared_ptr<Media::AbstractMedia> backupMedia;           // media rimosso
     bool removed;                                                // indica se il media e' stato rimosso oppure no
 };
 
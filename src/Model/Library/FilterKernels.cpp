@@ -0,0 +1,232 @@
+#include "FilterKernels.h"
+
+#include <vector>
+#include <cstdint>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define FILTER_KERNELS_SSE2
+#endif
+
+
+namespace Model {
+namespace Library {
+
+namespace {
+
+// === IMPLEMENTAZIONE SCALARE ===
+
+/**
+ * @brief selectRangeScalar : kernel scalare senza salti, usato per le righe finali e in assenza di istruzioni SIMD
+ * @param first : prima riga da valutare (multiplo di 64)
+ */
+template <typename T>
+void selectRangeScalar(const T* values, unsigned int first, unsigned int rows, T min, T max, std::uint64_t* words) {
+
+    for (unsigned int base = first; base < rows; base += 64) {
+        unsigned int end = rows - base < 64 ? rows - base : 64;
+        std::uint64_t word = 0;
+        for (unsigned int b = 0; b < end; ++b) {
+            T v = values[base + b];
+            word |= static_cast<std::uint64_t>(!(v < min) & !(v > max)) << b;
+        }
+        words[base / 64] = word;
+    }
+}
+
+
+// === IMPLEMENTAZIONE SIMD ===
+
+#if defined(__AVX2__)
+
+// 8 righe per istruzione, 8 blocchi per parola
+inline unsigned int rangeMask(const unsigned int* v, __m256i minBiased, __m256i maxBiased) {
+    const __m256i bias = _mm256_set1_epi32(static_cast<int>(0x80000000u));
+    __m256i x = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(v)), bias);
+    __m256i out = _mm256_or_si256(_mm256_cmpgt_epi32(minBiased, x), _mm256_cmpgt_epi32(x, maxBiased));
+    return static_cast<unsigned int>(~_mm256_movemask_ps(_mm256_castsi256_ps(out))) & 0xFFu;
+}
+inline unsigned int rangeMask(const int* v, __m256i minV, __m256i maxV) {
+    __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(v));
+    __m256i out = _mm256_or_si256(_mm256_cmpgt_epi32(minV, x), _mm256_cmpgt_epi32(x, maxV));
+    return static_cast<unsigned int>(~_mm256_movemask_ps(_mm256_castsi256_ps(out))) & 0xFFu;
+}
+inline unsigned int rangeMask(const float* v, __m256 minV, __m256 maxV) {
+    __m256 x = _mm256_loadu_ps(v);
+    __m256 out = _mm256_or_ps(_mm256_cmp_ps(x, minV, _CMP_LT_OQ), _mm256_cmp_ps(x, maxV, _CMP_GT_OQ));
+    return static_cast<unsigned int>(~_mm256_movemask_ps(out)) & 0xFFu;
+}
+
+template <typename T, typename V>
+void selectRangeSimd(const T* values, unsigned int rows, V minV, V maxV, std::uint64_t* words) {
+
+    unsigned int fullWords = rows / 64;
+    for (unsigned int w = 0; w < fullWords; ++w) {
+        const T* block = values + w * 64;
+        std::uint64_t word = 0;
+        for (unsigned int b = 0; b < 8; ++b) {
+            word |= static_cast<std::uint64_t>(rangeMask(block + b * 8, minV, maxV)) << (b * 8);
+        }
+        words[w] = word;
+    }
+}
+
+#elif defined(FILTER_KERNELS_SSE2)
+
+// 4 righe per istruzione, 16 blocchi per parola
+inline unsigned int rangeMask(const unsigned int* v, __m128i minBiased, __m128i maxBiased) {
+    const __m128i bias = _mm_set1_epi32(static_cast<int>(0x80000000u));
+    __m128i x = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(v)), bias);
+    __m128i out = _mm_or_si128(_mm_cmplt_epi32(x, minBiased), _mm_cmpgt_epi32(x, maxBiased));
+    return static_cast<unsigned int>(~_mm_movemask_ps(_mm_castsi128_ps(out))) & 0xFu;
+}
+inline unsigned int rangeMask(const int* v, __m128i minV, __m128i maxV) {
+    __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(v));
+    __m128i out = _mm_or_si128(_mm_cmplt_epi32(x, minV), _mm_cmpgt_epi32(x, maxV));
+    return static_cast<unsigned int>(~_mm_movemask_ps(_mm_castsi128_ps(out))) & 0xFu;
+}
+inline unsigned int rangeMask(const float* v, __m128 minV, __m128 maxV) {
+    __m128 x = _mm_loadu_ps(v);
+    __m128 out = _mm_or_ps(_mm_cmplt_ps(x, minV), _mm_cmpgt_ps(x, maxV));
+    return static_cast<unsigned int>(~_mm_movemask_ps(out)) & 0xFu;
+}
+
+template <typename T, typename V>
+void selectRangeSimd(const T* values, unsigned int rows, V minV, V maxV, std::uint64_t* words) {
+
+    unsigned int fullWords = rows / 64;
+    for (unsigned int w = 0; w < fullWords; ++w) {
+        const T* block = values + w * 64;
+        std::uint64_t word = 0;
+        for (unsigned int b = 0; b < 16; ++b) {
+            word |= static_cast<std::uint64_t>(rangeMask(block + b * 4, minV, maxV)) << (b * 4);
+        }
+        words[w] = word;
+    }
+}
+
+#endif
+
+inline unsigned int countTrailingZeros(std::uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned int>(__builtin_ctzll(word));
+#else
+    unsigned int n = 0;
+    while (!(word & 1u)) { word >>= 1; ++n; }
+    return n;
+#endif
+}
+
+inline unsigned int countBits(std::uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned int>(__builtin_popcountll(word));
+#else
+    unsigned int n = 0;
+    while (word) { word &= word - 1; ++n; }
+    return n;
+#endif
+}
+
+}
+
+
+// === BITMAP ===
+
+unsigned int FilterKernels::bitmapWords(unsigned int rows) { return (rows + 63) / 64; }
+
+void FilterKernels::andBitmaps(Bitmap& dst, const Bitmap& src) {
+
+    for (unsigned int w = 0; w < dst.size() && w < src.size(); ++w) {
+        dst[w] &= src[w];
+    }
+}
+
+void FilterKernels::orBitmaps(Bitmap& dst, const Bitmap& src) {
+
+    for (unsigned int w = 0; w < dst.size() && w < src.size(); ++w) {
+        dst[w] |= src[w];
+    }
+}
+
+void FilterKernels::collectPositions(const Bitmap& bits, std::vector<unsigned int>& positions) {
+
+    for (unsigned int w = 0; w < bits.size(); ++w) {
+        std::uint64_t word = bits[w];
+        while (word) {
+            positions.push_back(w * 64 + countTrailingZeros(word));
+            word &= word - 1;
+        }
+    }
+}
+
+unsigned int FilterKernels::countSelected(const Bitmap& bits) {
+
+    unsigned int count = 0;
+    for (std::uint64_t word : bits) {
+        count += countBits(word);
+    }
+    return count;
+}
+
+
+// === KERNEL ===
+
+void FilterKernels::selectRange(const unsigned int* values, unsigned int rows, unsigned int min, unsigned int max, Bitmap& bits) {
+
+    bits.assign(bitmapWords(rows), 0);
+    unsigned int first = 0;
+#if defined(__AVX2__)
+    selectRangeSimd(values, rows, _mm256_set1_epi32(static_cast<int>(min ^ 0x80000000u)), _mm256_set1_epi32(static_cast<int>(max ^ 0x80000000u)), bits.data());
+    first = rows / 64 * 64;
+#elif defined(FILTER_KERNELS_SSE2)
+    selectRangeSimd(values, rows, _mm_set1_epi32(static_cast<int>(min ^ 0x80000000u)), _mm_set1_epi32(static_cast<int>(max ^ 0x80000000u)), bits.data());
+    first = rows / 64 * 64;
+#endif
+    selectRangeScalar(values, first, rows, min, max, bits.data());
+}
+
+void FilterKernels::selectRange(const int* values, unsigned int rows, int min, int max, Bitmap& bits) {
+
+    bits.assign(bitmapWords(rows), 0);
+    unsigned int first = 0;
+#if defined(__AVX2__)
+    selectRangeSimd(values, rows, _mm256_set1_epi32(min), _mm256_set1_epi32(max), bits.data());
+    first = rows / 64 * 64;
+#elif defined(FILTER_KERNELS_SSE2)
+    selectRangeSimd(values, rows, _mm_set1_epi32(min), _mm_set1_epi32(max), bits.data());
+    first = rows / 64 * 64;
+#endif
+    selectRangeScalar(values, first, rows, min, max, bits.data());
+}
+
+void FilterKernels::selectRange(const float* values, unsigned int rows, float min, float max, Bitmap& bits) {
+
+    bits.assign(bitmapWords(rows), 0);
+    unsigned int first = 0;
+#if defined(__AVX2__)
+    selectRangeSimd(values, rows, _mm256_set1_ps(min), _mm256_set1_ps(max), bits.data());
+    first = rows / 64 * 64;
+#elif defined(FILTER_KERNELS_SSE2)
+    selectRangeSimd(values, rows, _mm_set1_ps(min), _mm_set1_ps(max), bits.data());
+    first = rows / 64 * 64;
+#endif
+    selectRangeScalar(values, first, rows, min, max, bits.data());
+}
+
+void FilterKernels::selectTags(const std::uint8_t* tags, unsigned int rows, std::uint8_t tagMask, Bitmap& bits) {
+
+    bits.assign(bitmapWords(rows), 0);
+    for (unsigned int base = 0; base < rows; base += 64) {
+        unsigned int end = rows - base < 64 ? rows - base : 64;
+        std::uint64_t word = 0;
+        for (unsigned int b = 0; b < end; ++b) {
+            word |= static_cast<std::uint64_t>((tagMask >> (tags[base + b] & 7u)) & 1u) << b;
+        }
+        bits[base / 64] = word;
+    }
+}
+
+}
+}
@@ -0,0 +1,90 @@
+#ifndef MODEL_LIBRARY_FILTER_KERNELS_H
+#define MODEL_LIBRARY_FILTER_KERNELS_H
+
+#include <vector>
+#include <cstdint>
+
+/** @brief FilterKernels
+ *
+ *  FilterKernels raccoglie i "kernel" utilizzati per valutare i filtri numerici della ricerca sulle colonne di MediaColumns.
+ *
+ *  Ogni kernel scorre una colonna contigua e produce una bitmap di selezione: il bit 'i' (bit 'i % 64' della parola 'i / 64') vale 1 se la riga
+ *  'i' soddisfa il predicato. Le bitmap di piu' predicati vengono poi combinate con AND/OR parola per parola.
+ *
+ *  I kernel sugli intervalli sono vettorizzati con AVX2 (8 righe per istruzione) oppure SSE2 (4 righe), in base alle istruzioni disponibili
+ *  in compilazione ('__AVX2__' / '__SSE2__'); in assenza di entrambe viene usata un'implementazione scalare senza salti.
+ *  Tutte le implementazioni valutano il predicato come '!(v < min) && !(v > max)', lo stesso confronto usato da SearchVisitor.
+ *
+ *  I bit oltre l'ultima riga valgono sempre 0.
+ */
+
+namespace Model {
+namespace Library {
+
+class FilterKernels {
+
+public:
+
+    using Bitmap = std::vector<std::uint64_t>;
+
+
+    // === BITMAP ===
+
+    /**
+     * @brief bitmapWords : numero di parole a 64 bit necessarie per una bitmap di 'rows' righe
+     * @param rows : numero di righe
+     * @return unsigned int : numero di parole
+     */
+    static unsigned int bitmapWords(unsigned int rows);
+
+    /**
+     * @brief andBitmaps : interseca una bitmap con un'altra (dst = dst AND src)
+     */
+    static void andBitmaps(Bitmap& dst, const Bitmap& src);
+
+    /**
+     * @brief orBitmaps : unisce una bitmap con un'altra (dst = dst OR src)
+     */
+    static void orBitmaps(Bitmap& dst, const Bitmap& src);
+
+    /**
+     * @brief collectPositions : converte una bitmap nelle posizioni (crescenti) dei bit impostati
+     * @param bits : bitmap di selezione
+     * @param positions : vettore in cui aggiungere le posizioni
+     */
+    static void collectPositions(const Bitmap& bits, std::vector<unsigned int>& positions);
+
+    /**
+     * @brief countSelected : conta le righe selezionate di una bitmap
+     */
+    static unsigned int countSelected(const Bitmap& bits);
+
+
+    // === KERNEL ===
+
+    /**
+     * @brief selectRange : seleziona le righe di una colonna con valore nell'intervallo [min, max]
+     * @param values : colonna di valori
+     * @param rows : numero di righe
+     * @param min : estremo inferiore (incluso)
+     * @param max : estremo superiore (incluso)
+     * @param bits : bitmap risultato (ridimensionata a 'bitmapWords(rows)')
+     */
+    static void selectRange(const unsigned int* values, unsigned int rows, unsigned int min, unsigned int max, Bitmap& bits);
+    static void selectRange(const int* values, unsigned int rows, int min, int max, Bitmap& bits);
+    static void selectRange(const float* values, unsigned int rows, float min, float max, Bitmap& bits);
+
+    /**
+     * @brief selectTags : seleziona le righe il cui tag (0-7) appartiene ad una maschera
+     * @param tags : colonna di tag
+     * @param rows : numero di righe
+     * @param tagMask : maschera dei tag ammessi (bit 't' per il tag 't')
+     * @param bits : bitmap risultato (ridimensionata a 'bitmapWords(rows)')
+     */
+    static void selectTags(const std::uint8_t* tags, unsigned int rows, std::uint8_t tagMask, Bitmap& bits);
+};
+
+}
+}
+
+#endif // MODEL_LIBRARY_FILTER_KERNELS_H
@@ -0,0 +1,59 @@
+#ifndef MODEL_LIBRARY_I_LIBRARY_OBSERVER_H
+#define MODEL_LIBRARY_I_LIBRARY_OBSERVER_H
+
+/** @brief ILibraryObserver
+ *
+ *  ILibraryObserver rappresenta l'interfaccia base astratta per ricevere notifiche puntuali delle modifiche ai media della libreria.
+ *  Un osservatore viene associato alla libreria (analogamente al logger) e viene notificato da Library dopo ogni inserimento, rimozione o modifica
+ *  riuscita, cioe' durante l'esecuzione (e l'annullamento) dei comandi del Manager. In questo modo chi mostra i media puo' aggiornare solo la posizione
+ *  interessata, invece di ricostruire tutta la lista.
+ *
+ *  Le operazioni che sostituiscono tutto il contenuto della libreria (caricamento, svuotamento) non vengono notificate media per media.
+ *  Anche le modifiche effettuate durante un aggiornamento in blocco (ad esempio un BatchCommand) non vengono notificate singolarmente:
+ *  al termine dell'aggiornamento viene inviata un'unica notifica 'onMediaBatchChanged'.
+ *
+ */
+
+namespace Model {
+namespace Library {
+
+class ILibraryObserver {
+public:
+
+    /**
+     * @brief ~ILibraryObserver : distruttore virtuale di ILibraryObserver
+     */
+    virtual ~ILibraryObserver() = default;
+
+    /**
+     * @brief onMediaInserted : virtuale puro, notifica l'inserimento di un media
+     * @param ind : posizione del media inserito
+     * @param id : identificatore univoco del media inserito
+     */
+    virtual void onMediaInserted(unsigned int ind, unsigned int id) = 0;
+
+    /**
+     * @brief onMediaRemoved : virtuale puro, notifica la rimozione di un media (le posizioni successive scalano di uno)
+     * @param ind : posizione del media rimosso
+     * @param id : identificatore univoco del media rimosso
+     */
+    virtual void onMediaRemoved(unsigned int ind, unsigned int id) = 0;
+
+    /**
+     * @brief onMediaChanged : virtuale puro, notifica la modifica di un media (la sua posizione non cambia)
+     * @param ind : posizione del media modificato
+     * @param id : identificatore univoco del media modificato
+     */
+    virtual void onMediaChanged(unsigned int ind, unsigned int id) = 0;
+
+    /**
+     * @brief onMediaBatchChanged : virtuale puro, notifica la fine di un aggiornamento in blocco che ha inserito, rimosso o modificato uno o piu' media
+     *                              (le posizioni possono essere cambiate in modo arbitrario)
+     */
+    virtual void onMediaBatchChanged() = 0;
+};
+
+}
+}
+
+#endif // MODEL_LIBRARY_I_LIBRARY_OBSERVER_H
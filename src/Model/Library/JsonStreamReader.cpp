@@ -0,0 +1,490 @@
+#include "JsonStreamReader.h"
+
+#include <cmath>
+#include <climits>
+#include <locale>
+#include <sstream>
+#include <stdexcept>
+
+
+namespace Model {
+namespace Library {
+
+namespace {
+
+// carattere sostitutivo per i surrogati UTF-16 isolati
+const std::uint32_t REPLACEMENT_CHARACTER = 0xFFFD;
+
+// cifre oltre le quali un intero non viene piu' convertito in modo esatto con l'aritmetica intera
+const std::size_t MAX_EXACT_INTEGER_DIGITS = 15;
+
+void appendUtf8(std::string& out, std::uint32_t codePoint) {
+
+    if (codePoint < 0x80) {
+        out.push_back(static_cast<char>(codePoint));
+    }
+    else if (codePoint < 0x800) {
+        out.push_back(static_cast<char>(0xC0 | (codePoint >> 6)));
+        out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    }
+    else if (codePoint < 0x10000) {
+        out.push_back(static_cast<char>(0xE0 | (codePoint >> 12)));
+        out.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    }
+    else {
+        out.push_back(static_cast<char>(0xF0 | (codePoint >> 18)));
+        out.push_back(static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    }
+}
+
+inline bool isDigit(int c) { return c >= '0' && c <= '9'; }
+
+}
+
+const unsigned int JsonStreamReader::MAX_NESTING_DEPTH = 1024;
+const std::size_t JsonStreamReader::DEFAULT_BUFFER_SIZE = 64 * 1024;
+
+
+// === COSTRUTTORE ===
+
+JsonStreamReader::JsonStreamReader(QIODevice& dev, std::size_t bufferSize)
+    : device(dev),
+    buffer(bufferSize > 0 ? bufferSize : DEFAULT_BUFFER_SIZE),
+    position(0),
+    filled(0),
+    consumed(0)
+{}
+
+
+// === LETTURA ===
+
+void JsonStreamReader::skipByteOrderMark() {
+
+    if (peekChar() != 0xEF) return;
+    getChar();
+    if (getChar() != 0xBB || getChar() != 0xBF) {
+        fail("Illegal value");
+    }
+}
+
+JsonStreamReader::ValueType JsonStreamReader::peekValueType() {
+
+    skipWhitespace();
+    int c = peekChar();
+    switch (c) {
+    case '{': return ValueType::Object;
+    case '[': return ValueType::Array;
+    case '"': return ValueType::String;
+    case 't':
+    case 'f': return ValueType::Bool;
+    case 'n': return ValueType::Null;
+    default:
+        if (c == '-' || isDigit(c)) return ValueType::Number;
+        fail(c < 0 ? "Unexpected end of document" : "Illegal value");
+    }
+}
+
+void JsonStreamReader::beginObject() {
+
+    skipWhitespace();
+    expectChar('{');
+    openContainer();
+}
+
+bool JsonStreamReader::nextObjectKey(std::string& key) {
+
+    skipWhitespace();
+    if (peekChar() == '}') {
+        getChar();
+        closeContainer();
+        return false;
+    }
+    if (firstMember.back()) {
+        firstMember.back() = false;
+    }
+    else {
+        expectChar(',');
+    }
+    readString(key);
+    skipWhitespace();
+    expectChar(':');
+    return true;
+}
+
+void JsonStreamReader::beginArray() {
+
+    skipWhitespace();
+    expectChar('[');
+    openContainer();
+}
+
+bool JsonStreamReader::nextArrayValue() {
+
+    skipWhitespace();
+    if (peekChar() == ']') {
+        getChar();
+        closeContainer();
+        return false;
+    }
+    if (firstMember.back()) {
+        firstMember.back() = false;
+    }
+    else {
+        expectChar(',');
+    }
+    return true;
+}
+
+void JsonStreamReader::readString(std::string& value) {
+
+    value.clear();
+    skipWhitespace();
+    expectChar('"');
+
+    for (;;) {
+        if (position == filled && !fillBuffer()) {
+            fail("Unterminated string");
+        }
+        // i tratti senza caratteri speciali vengono copiati in blocco
+        std::size_t start = position;
+        while (position < filled) {
+            unsigned char c = static_cast<unsigned char>(buffer[position]);
+            if (c == '"' || c == '\\' || c >= 0x80) break;
+            ++position;
+        }
+        value.append(buffer.data() + start, position - start);
+        if (position == filled) continue;
+
+        unsigned char c = static_cast<unsigned char>(buffer[position++]);
+        if (c == '"') return;
+        if (c == '\\') readEscape(value);
+        else readUtf8Sequence(c, value);
+    }
+}
+
+double JsonStreamReader::readNumber() {
+
+    skipWhitespace();
+    numberText.clear();
+    bool integer = true;
+
+    if (peekChar() == '-') numberText.push_back(static_cast<char>(getChar()));
+    if (peekChar() == '0') {
+        numberText.push_back(static_cast<char>(getChar()));
+    }
+    else if (isDigit(peekChar())) {
+        while (isDigit(peekChar())) numberText.push_back(static_cast<char>(getChar()));
+    }
+    else {
+        fail("Illegal number");
+    }
+    if (peekChar() == '.') {
+        integer = false;
+        numberText.push_back(static_cast<char>(getChar()));
+        if (!isDigit(peekChar())) fail("Illegal number");
+        while (isDigit(peekChar())) numberText.push_back(static_cast<char>(getChar()));
+    }
+    if (peekChar() == 'e' || peekChar() == 'E') {
+        integer = false;
+        numberText.push_back(static_cast<char>(getChar()));
+        if (peekChar() == '+' || peekChar() == '-') numberText.push_back(static_cast<char>(getChar()));
+        if (!isDigit(peekChar())) fail("Illegal number");
+        while (isDigit(peekChar())) numberText.push_back(static_cast<char>(getChar()));
+    }
+
+    // interi brevi (il caso comune) convertiti in modo esatto senza passare dagli stream
+    bool negative = numberText[0] == '-';
+    if (integer && numberText.size() - (negative ? 1 : 0) <= MAX_EXACT_INTEGER_DIGITS) {
+        long long value = 0;
+        for (std::size_t i = negative ? 1 : 0; i < numberText.size(); ++i) {
+            value = value * 10 + (numberText[i] - '0');
+        }
+        return negative ? -static_cast<double>(value) : static_cast<double>(value);
+    }
+
+    // conversione indipendente dalla localizzazione corrente (il separatore decimale e' sempre '.')
+    std::istringstream stream(numberText);
+    stream.imbue(std::locale::classic());
+    double value = 0.0;
+    stream >> value;
+    if (stream.fail() || !std::isfinite(value)) {
+        fail("Illegal number");
+    }
+    return value;
+}
+
+bool JsonStreamReader::readBool() {
+
+    skipWhitespace();
+    if (peekChar() == 't') {
+        readLiteral("true");
+        return true;
+    }
+    readLiteral("false");
+    return false;
+}
+
+void JsonStreamReader::readNull() {
+
+    skipWhitespace();
+    readLiteral("null");
+}
+
+void JsonStreamReader::skipValue() {
+
+    switch (peekValueType()) {
+    case ValueType::Object:
+        beginObject();
+        while (nextObjectKey(skippedText)) {
+            skipValue();
+        }
+        break;
+    case ValueType::Array:
+        beginArray();
+        while (nextArrayValue()) {
+            skipValue();
+        }
+        break;
+    case ValueType::String: readString(skippedText); break;
+    case ValueType::Number: readNumber(); break;
+    case ValueType::Bool: readBool(); break;
+    case ValueType::Null: readNull(); break;
+    }
+}
+
+void JsonStreamReader::expectEnd() {
+
+    skipWhitespace();
+    if (peekChar() >= 0) {
+        fail("Garbage at the end of the document");
+    }
+}
+
+std::uint64_t JsonStreamReader::getOffset() const { return consumed + position; }
+
+
+// === METODI AUSILIARI ===
+
+bool JsonStreamReader::fillBuffer() {
+
+    consumed += filled;
+    position = 0;
+    filled = 0;
+    qint64 bytes = device.read(buffer.data(), static_cast<qint64>(buffer.size()));
+    if (bytes <= 0) return false;
+    filled = static_cast<std::size_t>(bytes);
+    return true;
+}
+
+int JsonStreamReader::peekChar() {
+
+    if (position == filled && !fillBuffer()) return -1;
+    return static_cast<unsigned char>(buffer[position]);
+}
+
+int JsonStreamReader::getChar() {
+
+    if (position == filled && !fillBuffer()) return -1;
+    return static_cast<unsigned char>(buffer[position++]);
+}
+
+void JsonStreamReader::skipWhitespace() {
+
+    for (;;) {
+        int c = peekChar();
+        if (c != ' ' && c != '\t' && c != '\n' && c != '\r') return;
+        ++position;
+    }
+}
+
+void JsonStreamReader::expectChar(char expected) {
+
+    int c = getChar();
+    if (c != static_cast<unsigned char>(expected)) {
+        fail(c < 0 ? "Unexpected end of document" : std::string("Expected '") + expected + "'");
+    }
+}
+
+void JsonStreamReader::readLiteral(const char* literal) {
+
+    for (const char* c = literal; *c; ++c) {
+        if (getChar() != *c) fail("Illegal value");
+    }
+}
+
+void JsonStreamReader::readEscape(std::string& value) {
+
+    int c = getChar();
+    switch (c) {
+    case '"': value.push_back('"'); return;
+    case '\\': value.push_back('\\'); return;
+    case '/': value.push_back('/'); return;
+    case 'b': value.push_back('\b'); return;
+    case 'f': value.push_back('\f'); return;
+    case 'n': value.push_back('\n'); return;
+    case 'r': value.push_back('\r'); return;
+    case 't': value.push_back('\t'); return;
+    case 'u': break;
+    default: fail("Illegal escape sequence");
+    }
+
+    std::uint32_t unit = readHex4();
+    for (;;) {
+        if (unit < 0xD800 || unit > 0xDFFF) {
+            appendUtf8(value, unit);
+            return;
+        }
+        // un surrogato basso isolato, o un surrogato alto non seguito da '\u', non e' un carattere valido
+        if (unit >= 0xDC00 || peekChar() != '\\') {
+            appendUtf8(value, REPLACEMENT_CHARACTER);
+            return;
+        }
+        getChar();
+        if (peekChar() != 'u') {
+            appendUtf8(value, REPLACEMENT_CHARACTER);
+            readEscape(value);
+            return;
+        }
+        getChar();
+        std::uint32_t low = readHex4();
+        if (low >= 0xDC00 && low <= 0xDFFF) {
+            appendUtf8(value, 0x10000 + ((unit - 0xD800) << 10) + (low - 0xDC00));
+            return;
+        }
+        appendUtf8(value, REPLACEMENT_CHARACTER);
+        unit = low;
+    }
+}
+
+void JsonStreamReader::readUtf8Sequence(unsigned char lead, std::string& value) {
+
+    unsigned int length;
+    std::uint32_t codePoint;
+    std::uint32_t minimum;
+    if (lead >= 0xC2 && lead <= 0xDF) { length = 2; codePoint = lead & 0x1F; minimum = 0x80; }
+    else if (lead >= 0xE0 && lead <= 0xEF) { length = 3; codePoint = lead & 0x0F; minimum = 0x800; }
+    else if (lead >= 0xF0 && lead <= 0xF4) { length = 4; codePoint = lead & 0x07; minimum = 0x10000; }
+    else fail("Illegal UTF-8 string");
+
+    value.push_back(static_cast<char>(lead));
+    for (unsigned int i = 1; i < length; ++i) {
+        int c = getChar();
+        if (c < 0 || (c & 0xC0) != 0x80) fail("Illegal UTF-8 string");
+        codePoint = (codePoint << 6) | (c & 0x3F);
+        value.push_back(static_cast<char>(c));
+    }
+    // forme non minime, surrogati e valori oltre U+10FFFF non sono UTF-8 valido
+    if (codePoint < minimum || codePoint > 0x10FFFF || (codePoint >= 0xD800 && codePoint <= 0xDFFF)) {
+        fail("Illegal UTF-8 string");
+    }
+}
+
+std::uint32_t JsonStreamReader::readHex4() {
+
+    std::uint32_t unit = 0;
+    for (unsigned int i = 0; i < 4; ++i) {
+        int c = getChar();
+        unit <<= 4;
+        if (isDigit(c)) unit |= static_cast<std::uint32_t>(c - '0');
+        else if (c >= 'a' && c <= 'f') unit |= static_cast<std::uint32_t>(c - 'a' + 10);
+        else if (c >= 'A' && c <= 'F') unit |= static_cast<std::uint32_t>(c - 'A' + 10);
+        else fail("Illegal escape sequence");
+    }
+    return unit;
+}
+
+void JsonStreamReader::openContainer() {
+
+    if (firstMember.size() >= MAX_NESTING_DEPTH) {
+        fail("Too deeply nested document");
+    }
+    firstMember.push_back(true);
+}
+
+void JsonStreamReader::closeContainer() { firstMember.pop_back(); }
+
+void JsonStreamReader::fail(const std::string& error) const {
+
+    throw std::runtime_error("JSON parse error at offset " + std::to_string(getOffset()) + ": " + error + "\n");
+}
+
+
+// === JSON RECORD ===
+
+void JsonRecord::readFrom(JsonStreamReader& reader) {
+
+    clear();
+    reader.beginObject();
+    while (reader.nextObjectKey(key)) {
+        Field& field = fields[key];
+        field.generation = generation;
+        field.type = reader.peekValueType();
+        switch (field.type) {
+        case JsonStreamReader::ValueType::String: reader.readString(field.text); break;
+        case JsonStreamReader::ValueType::Number: field.number = reader.readNumber(); break;
+        case JsonStreamReader::ValueType::Bool: field.flag = reader.readBool(); break;
+        case JsonStreamReader::ValueType::Null: reader.readNull(); break;
+        default: reader.skipValue(); break;
+        }
+    }
+}
+
+void JsonRecord::clear() {
+
+    // i campi con generazione diversa da quella corrente non fanno parte del record
+    if (++generation == 0) {
+        fields.clear();
+        generation = 1;
+    }
+}
+
+bool JsonRecord::isString(const std::string& name) const { return findField(name, JsonStreamReader::ValueType::String) != nullptr; }
+
+bool JsonRecord::isDouble(const std::string& name) const { return findField(name, JsonStreamReader::ValueType::Number) != nullptr; }
+
+bool JsonRecord::isBool(const std::string& name) const { return findField(name, JsonStreamReader::ValueType::Bool) != nullptr; }
+
+std::string JsonRecord::toString(const std::string& name) const {
+
+    const Field* field = findField(name, JsonStreamReader::ValueType::String);
+    return field ? field->text : std::string();
+}
+
+double JsonRecord::toDouble(const std::string& name) const {
+
+    const Field* field = findField(name, JsonStreamReader::ValueType::Number);
+    return field ? field->number : 0.0;
+}
+
+int JsonRecord::toInt(const std::string& name) const {
+
+    // come QJsonValue::toInt : solo numeri interi nel range di int, altrimenti 0
+    const Field* field = findField(name, JsonStreamReader::ValueType::Number);
+    if (!field) return 0;
+    double value = field->number;
+    if (value < static_cast<double>(INT_MIN) || value > static_cast<double>(INT_MAX) || std::floor(value) != value) {
+        return 0;
+    }
+    return static_cast<int>(value);
+}
+
+bool JsonRecord::toBool(const std::string& name) const {
+
+    const Field* field = findField(name, JsonStreamReader::ValueType::Bool);
+    return field ? field->flag : false;
+}
+
+const JsonRecord::Field* JsonRecord::findField(const std::string& name, JsonStreamReader::ValueType type) const {
+
+    auto found = fields.find(name);
+    if (found == fields.end() || found->second.generation != generation || found->second.type != type) {
+        return nullptr;
+    }
+    return &found->second;
+}
+
+}
+}
@@ -0,0 +1,178 @@
+#ifndef MODEL_LIBRARY_JSON_STREAM_READER_H
+#define MODEL_LIBRARY_JSON_STREAM_READER_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <unordered_map>
+
+#include <QIODevice>
+
+/** @brief JsonStreamReader
+ *
+ *  JsonStreamReader implementa una lettura incrementale ("pull") di un documento JSON da un QIODevice, senza costruire un QJsonDocument.
+ *  Il dispositivo viene letto a blocchi in un buffer di dimensione fissa, e i valori vengono letti uno alla volta dal chiamante, che decide
+ *  come interpretarli (ad esempio costruendo direttamente un media) oppure li salta. La memoria usata non dipende dalla dimensione del documento.
+ *
+ *  La sintassi accettata e' quella di QJsonDocument::fromJson: JSON standard (RFC 8259), BOM UTF-8 iniziale opzionale, stringhe in UTF-8 valido
+ *  (i caratteri di controllo sono ammessi), numeri finiti e al piu' MAX_NESTING_DEPTH livelli di annidamento.
+ *  Ogni errore di sintassi solleva un'eccezione std::runtime_error con la posizione (in byte) dell'errore.
+ *
+ *  Esempio di lettura di un oggetto:
+ *      reader.beginObject();
+ *      while (reader.nextObjectKey(key)) { ... lettura (o skipValue) del valore associato a 'key' ... }
+ */
+
+namespace Model {
+namespace Library {
+
+class JsonStreamReader {
+
+public:
+
+    // === COSTANTI STATICHE ===
+
+    static const unsigned int MAX_NESTING_DEPTH;     // livelli massimi di annidamento (come QJsonDocument)
+    static const std::size_t DEFAULT_BUFFER_SIZE;    // dimensione di default del buffer di lettura
+
+    /** @brief ValueType : tipo del prossimo valore */
+    enum class ValueType { Object, Array, String, Number, Bool, Null };
+
+
+    // === COSTRUTTORE ===
+
+    /**
+     * @brief JsonStreamReader : costruttore
+     * @param device : dispositivo (gia' aperto in lettura) da cui leggere il documento
+     * @param bufferSize : dimensione del buffer di lettura
+     */
+    explicit JsonStreamReader(QIODevice& device, std::size_t bufferSize = DEFAULT_BUFFER_SIZE);
+
+
+    // === LETTURA ===
+
+    /** @brief skipByteOrderMark : salta il BOM UTF-8, se presente all'inizio del documento */
+    void skipByteOrderMark();
+
+    /**
+     * @brief peekValueType : restituisce il tipo del prossimo valore, senza leggerlo
+     * @return ValueType : tipo del valore
+     */
+    ValueType peekValueType();
+
+    /** @brief beginObject : legge l'inizio di un oggetto */
+    void beginObject();
+
+    /**
+     * @brief nextObjectKey : legge la chiave del prossimo membro dell'oggetto corrente (il valore va letto subito dopo)
+     * @param key : chiave letta
+     * @return bool : true se e' stata letta una chiave, false se l'oggetto e' terminato
+     */
+    bool nextObjectKey(std::string& key);
+
+    /** @brief beginArray : legge l'inizio di un array */
+    void beginArray();
+
+    /**
+     * @brief nextArrayValue : verifica se l'array corrente ha un altro elemento (da leggere subito dopo)
+     * @return bool : true se segue un elemento, false se l'array e' terminato
+     */
+    bool nextArrayValue();
+
+    void readString(std::string& value);
+    double readNumber();
+    bool readBool();
+    void readNull();
+
+    /** @brief skipValue : legge e scarta il prossimo valore (oggetti e array compresi, verificandone la sintassi) */
+    void skipValue();
+
+    /** @brief expectEnd : verifica che il documento sia terminato (sono ammessi solo spazi) */
+    void expectEnd();
+
+    /** @brief getOffset : posizione (in byte) della lettura nel documento */
+    std::uint64_t getOffset() const;
+
+
+private:
+
+    QIODevice& device;
+    std::vector<char> buffer;          // blocco letto dal dispositivo
+    std::size_t position;              // prossimo byte da leggere nel buffer
+    std::size_t filled;                // byte validi nel buffer
+    std::uint64_t consumed;            // byte dei blocchi precedenti
+    std::vector<bool> firstMember;     // per ogni oggetto/array aperto, true se non e' ancora stato letto alcun elemento
+    std::string numberText;            // testo dell'ultimo numero letto
+    std::string skippedText;           // stringhe lette da 'skipValue'
+
+    bool fillBuffer();
+    int peekChar();
+    int getChar();
+    void skipWhitespace();
+    void expectChar(char expected);
+    void readLiteral(const char* literal);
+    void readEscape(std::string& value);
+    void readUtf8Sequence(unsigned char lead, std::string& value);
+    std::uint32_t readHex4();
+    void openContainer();
+    void closeContainer();
+    [[noreturn]] void fail(const std::string& error) const;
+};
+
+
+/** @brief JsonRecord
+ *
+ *  JsonRecord raccoglie i membri di un oggetto JSON "piatto" (ad esempio un media), letti da un JsonStreamReader.
+ *  Per i valori di tipo oggetto o array viene registrato solo il tipo. In caso di chiavi duplicate vale l'ultima, come in QJsonObject.
+ *  I campi vengono riutilizzati da un record al successivo, per non allocare memoria per ogni record.
+ *
+ *  I metodi di lettura hanno la stessa semantica dei corrispondenti metodi di QJsonValue usati da 'fromJson' dei media.
+ */
+class JsonRecord {
+
+public:
+
+    /**
+     * @brief readFrom : legge un oggetto (sostituendo i campi del record precedente)
+     * @param reader : reader posizionato all'inizio dell'oggetto
+     */
+    void readFrom(JsonStreamReader& reader);
+
+    /** @brief clear : svuota il record */
+    void clear();
+
+    bool isString(const std::string& key) const;
+    bool isDouble(const std::string& key) const;
+    bool isBool(const std::string& key) const;
+
+    /** @brief toString : valore testuale, stringa vuota se il campo non e' una stringa */
+    std::string toString(const std::string& key) const;
+    /** @brief toDouble : valore numerico, 0 se il campo non e' un numero */
+    double toDouble(const std::string& key) const;
+    /** @brief toInt : valore intero, 0 se il campo non e' un numero intero rappresentabile come int */
+    int toInt(const std::string& key) const;
+    /** @brief toBool : valore booleano, false se il campo non e' un booleano */
+    bool toBool(const std::string& key) const;
+
+private:
+
+    struct Field {
+        JsonStreamReader::ValueType type = JsonStreamReader::ValueType::Null;
+        std::string text;
+        double number = 0.0;
+        bool flag = false;
+        unsigned int generation = 0;    // record a cui appartiene il valore
+    };
+
+    std::unordered_map<std::string, Field> fields;
+    unsigned int generation = 1;        // record corrente
+    std::string key;
+
+    const Field* findField(const std::string& name, JsonStreamReader::ValueType type) const;
+};
+
+}
+}
+
+#endif // MODEL_LIBRARY_JSON_STREAM_READER_H
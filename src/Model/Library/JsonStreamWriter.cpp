@@ -0,0 +1,237 @@
+#include "JsonStreamWriter.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <charconv>
+
+
+namespace Model {
+namespace Library {
+
+namespace {
+
+const char HEX_DIGITS[] = "0123456789abcdef";
+
+// sequenza UTF-8 di U+FFFD
+const char REPLACEMENT_CHARACTER[] = "\xEF\xBF\xBD";
+
+/**
+ * @brief utf8SequenceLength : lunghezza della sequenza UTF-8 valida che inizia in una posizione
+ * @return std::size_t : numero di byte della sequenza, 0 se la sequenza non e' valida
+ */
+std::size_t utf8SequenceLength(const char* value, std::size_t size, std::size_t pos) {
+
+    unsigned char lead = static_cast<unsigned char>(value[pos]);
+    std::size_t length;
+    std::uint32_t codePoint;
+    std::uint32_t minimum;
+    if (lead >= 0xC2 && lead <= 0xDF) { length = 2; codePoint = lead & 0x1F; minimum = 0x80; }
+    else if (lead >= 0xE0 && lead <= 0xEF) { length = 3; codePoint = lead & 0x0F; minimum = 0x800; }
+    else if (lead >= 0xF0 && lead <= 0xF4) { length = 4; codePoint = lead & 0x07; minimum = 0x10000; }
+    else return 0;
+
+    if (size - pos < length) return 0;
+    for (std::size_t i = 1; i < length; ++i) {
+        unsigned char c = static_cast<unsigned char>(value[pos + i]);
+        if ((c & 0xC0) != 0x80) return 0;
+        codePoint = (codePoint << 6) | (c & 0x3F);
+    }
+    if (codePoint < minimum || codePoint > 0x10FFFF || (codePoint >= 0xD800 && codePoint <= 0xDFFF)) return 0;
+    return length;
+}
+
+}
+
+const std::size_t JsonStreamWriter::DEFAULT_BUFFER_SIZE = 64 * 1024;
+
+
+// === COSTRUTTORE ===
+
+JsonStreamWriter::JsonStreamWriter(QIODevice& dev, bool compact, std::size_t bufferSize)
+    : device(dev),
+    compactFormat(compact),
+    flushThreshold(bufferSize > 0 ? bufferSize : DEFAULT_BUFFER_SIZE),
+    afterKey(false),
+    writeFailed(false)
+{
+    // margine per il valore che supera la soglia, in modo da non riallocare il buffer
+    buffer.reserve(flushThreshold + 256);
+}
+
+
+// === SCRITTURA ===
+
+void JsonStreamWriter::beginObject() { openContainer('{'); }
+
+void JsonStreamWriter::endObject() { closeContainer('}'); }
+
+void JsonStreamWriter::beginArray() { openContainer('['); }
+
+void JsonStreamWriter::endArray() { closeContainer(']'); }
+
+void JsonStreamWriter::writeKey(const char* key) {
+
+    beginValue();
+    buffer.push_back('"');
+    appendEscaped(key, std::strlen(key));
+    buffer.append(compactFormat ? "\":" : "\": ");
+    afterKey = true;
+}
+
+void JsonStreamWriter::writeString(const std::string& value) {
+
+    beginValue();
+    buffer.push_back('"');
+    appendEscaped(value.data(), value.size());
+    buffer.push_back('"');
+    flushBuffer();
+}
+
+void JsonStreamWriter::writeInt(long long value) {
+
+    beginValue();
+    char digits[24];
+    auto result = std::to_chars(digits, digits + sizeof(digits), value);
+    buffer.append(digits, result.ptr);
+    flushBuffer();
+}
+
+void JsonStreamWriter::writeDouble(double value) {
+
+    beginValue();
+    if (!std::isfinite(value)) {
+        // come QJsonDocument (RFC 4627, sezione 2.4)
+        buffer.append("null");
+    }
+    else {
+        // rappresentazione piu' breve che rilegge lo stesso valore (come QLocale::FloatingPointShortest con formato 'g')
+        char digits[32];
+        auto result = std::to_chars(digits, digits + sizeof(digits), value, std::chars_format::general);
+        buffer.append(digits, result.ptr);
+    }
+    flushBuffer();
+}
+
+void JsonStreamWriter::writeBool(bool value) {
+
+    beginValue();
+    buffer.append(value ? "true" : "false");
+    flushBuffer();
+}
+
+bool JsonStreamWriter::finish() {
+
+    if (!compactFormat) {
+        buffer.push_back('\n');
+    }
+    if (!buffer.empty() && !writeFailed) {
+        writeFailed = device.write(buffer.data(), static_cast<qint64>(buffer.size())) != static_cast<qint64>(buffer.size());
+    }
+    buffer.clear();
+    return !writeFailed;
+}
+
+
+// === METODI AUSILIARI ===
+
+void JsonStreamWriter::beginValue() {
+
+    if (afterKey) {
+        afterKey = false;
+        return;
+    }
+    if (firstMember.empty()) return;
+
+    if (firstMember.back()) {
+        firstMember.back() = false;
+    }
+    else {
+        buffer.push_back(',');
+    }
+    if (!compactFormat) {
+        buffer.push_back('\n');
+        appendIndent();
+    }
+}
+
+void JsonStreamWriter::openContainer(char open) {
+
+    beginValue();
+    buffer.push_back(open);
+    firstMember.push_back(true);
+}
+
+void JsonStreamWriter::closeContainer(char close) {
+
+    firstMember.pop_back();
+    if (!compactFormat) {
+        buffer.push_back('\n');
+        appendIndent();
+    }
+    buffer.push_back(close);
+    flushBuffer();
+}
+
+void JsonStreamWriter::appendIndent() { buffer.append(4 * firstMember.size(), ' '); }
+
+void JsonStreamWriter::appendEscaped(const char* value, std::size_t size) {
+
+    std::size_t pos = 0;
+    while (pos < size) {
+
+        // i tratti senza caratteri da sostituire vengono copiati in blocco
+        std::size_t start = pos;
+        while (pos < size) {
+            unsigned char c = static_cast<unsigned char>(value[pos]);
+            if (c < 0x20 || c == '"' || c == '\\' || c >= 0x80) break;
+            ++pos;
+        }
+        buffer.append(value + start, pos - start);
+        if (pos == size) break;
+
+        unsigned char c = static_cast<unsigned char>(value[pos]);
+        if (c >= 0x80) {
+            std::size_t length = utf8SequenceLength(value, size, pos);
+            if (length > 0) {
+                buffer.append(value + pos, length);
+                pos += length;
+            }
+            else {
+                buffer.append(REPLACEMENT_CHARACTER);
+                ++pos;
+            }
+            continue;
+        }
+
+        buffer.push_back('\\');
+        switch (c) {
+        case '"': buffer.push_back('"'); break;
+        case '\\': buffer.push_back('\\'); break;
+        case '\b': buffer.push_back('b'); break;
+        case '\f': buffer.push_back('f'); break;
+        case '\n': buffer.push_back('n'); break;
+        case '\r': buffer.push_back('r'); break;
+        case '\t': buffer.push_back('t'); break;
+        default:
+            buffer.append("u00");
+            buffer.push_back(HEX_DIGITS[c >> 4]);
+            buffer.push_back(HEX_DIGITS[c & 0xF]);
+            break;
+        }
+        ++pos;
+    }
+}
+
+void JsonStreamWriter::flushBuffer() {
+
+    if (buffer.size() < flushThreshold) return;
+    // dopo un errore il contenuto viene scartato, il documento e' comunque incompleto
+    if (!writeFailed) {
+        writeFailed = device.write(buffer.data(), static_cast<qint64>(buffer.size())) != static_cast<qint64>(buffer.size());
+    }
+    buffer.clear();
+}
+
+}
+}
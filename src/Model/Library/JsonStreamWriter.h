@@ -0,0 +1,93 @@
+#ifndef MODEL_LIBRARY_JSON_STREAM_WRITER_H
+#define MODEL_LIBRARY_JSON_STREAM_WRITER_H
+
+#include <string>
+#include <vector>
+#include <cstddef>
+
+#include <QIODevice>
+
+/** @brief JsonStreamWriter
+ *
+ *  JsonStreamWriter scrive un documento JSON su un QIODevice un valore alla volta, senza costruire QJsonObject, QJsonArray o QJsonDocument.
+ *  Il testo viene accumulato in un buffer di dimensione fissa, che viene scritto sul dispositivo ogni volta che si riempie: la memoria usata
+ *  non dipende quindi dalla dimensione del documento.
+ *
+ *  Il formato prodotto e' lo stesso di QJsonDocument::toJson: indentato di quattro spazi per livello (Indented), oppure senza spazi (Compact).
+ *  Le stringhe vengono scritte in UTF-8 (le sequenze non valide sono sostituite con U+FFFD, come in QString::fromStdString), i numeri non
+ *  finiti come 'null'. L'ordine delle chiavi di un oggetto e' quello di scrittura.
+ *
+ *  Gli errori di scrittura del dispositivo non sollevano eccezioni, ma vengono segnalati da 'finish'.
+ */
+
+namespace Model {
+namespace Library {
+
+class JsonStreamWriter {
+
+public:
+
+    // === COSTANTI STATICHE ===
+
+    static const std::size_t DEFAULT_BUFFER_SIZE;    // dimensione di default del buffer di scrittura
+
+
+    // === COSTRUTTORE ===
+
+    /**
+     * @brief JsonStreamWriter : costruttore
+     * @param device : dispositivo (gia' aperto in scrittura) su cui scrivere il documento
+     * @param compact : true per il formato compatto, false per il formato indentato
+     * @param bufferSize : dimensione del buffer di scrittura
+     */
+    explicit JsonStreamWriter(QIODevice& device, bool compact = false, std::size_t bufferSize = DEFAULT_BUFFER_SIZE);
+
+
+    // === SCRITTURA ===
+
+    void beginObject();
+    void endObject();
+    void beginArray();
+    void endArray();
+
+    /**
+     * @brief writeKey : scrive la chiave del prossimo membro dell'oggetto corrente (il valore va scritto subito dopo)
+     * @param key : chiave
+     */
+    void writeKey(const char* key);
+
+    void writeString(const std::string& value);
+    void writeInt(long long value);
+    void writeDouble(double value);
+    void writeBool(bool value);
+
+    /**
+     * @brief finish : termina il documento e scrive sul dispositivo il contenuto rimasto nel buffer
+     * @return bool : true se tutte le scritture sul dispositivo hanno avuto successo, false altrimenti
+     */
+    bool finish();
+
+
+private:
+
+    QIODevice& device;
+    bool compactFormat;
+    std::size_t flushThreshold;          // dimensione oltre la quale il buffer viene scritto sul dispositivo
+    std::string buffer;                  // testo non ancora scritto
+    std::vector<bool> firstMember;       // per ogni oggetto/array aperto, true se non e' ancora stato scritto alcun elemento
+    bool afterKey;                       // true se il prossimo valore segue una chiave
+    bool writeFailed;
+
+    /** @brief beginValue : scrive separatore e indentazione che precedono un valore */
+    void beginValue();
+    void openContainer(char open);
+    void closeContainer(char close);
+    void appendIndent();
+    void appendEscaped(const char* value, std::size_t size);
+    void flushBuffer();
+};
+
+}
+}
+
+#endif // MODEL_LIBRARY_JSON_STREAM_WRITER_H
@@ -6,16 +6,28 @@
 #include "Model/Visitors/MediaEditor.h"
 #include "Model/Visitors/SearchVisitor.h"
 #include "Model/Visitors/ScoreVisitor.h"
+#include "Model/Visitors/JsonRecordDecoder.h"
+#include "Model/Visitors/JsonRecordEncoder.h"
+#include "Model/Visitors/AttributeReader.h"
 #include "Model/Library/MediaFactory.h"
+#include "Model/Library/BinarySnapshot.h"
+#include "Model/Library/JsonStreamReader.h"
+#include "Model/Library/JsonStreamWriter.h"
 
 #include <string>
 #include <vector>
+#include <algorithm>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <unordered_set>
 
 #include <QString>
 #include <QJsonObject>
 #include <QJsonDocument>
 #include <QJsonArray>
 #include <QFile>
+#include <QSaveFile>
 
 
 namespace Model {
@@ -26,7 +38,12 @@ namespace Library {
 
 Library::Library(Loggers::IMediaLogger* logger)
     : libraryLogger(logger),
-    logLevel(Model::Loggers::LogLevel::Info)
+    logLevel(Model::Loggers::LogLevel::Info),
+    libraryObserver(nullptr),
+    batchUpdateDepth(0),
+    batchUpdateChanged(false),
+    batchSavedLogLevel(Model::Loggers::LogLevel::Info),
+    columnSnapshotEnabled(false)
 {}
 
 
@@ -49,10 +66,55 @@ Loggers::LogLevel Library::getLibraryLogLevel() const { return logLevel; }
 
 Loggers::IMediaLogger* Library::getLibraryLogger() const { return libraryLogger; }
 
+
+// === OSSERVATORE ===
+
+void Library::setLibraryObserver(ILibraryObserver* observer) { libraryObserver = observer; }
+
+ILibraryObserver* Library::getLibraryObserver() const { return libraryObserver; }
+
+void Library::beginBatchUpdate() {
+
+    if (batchUpdateDepth++ == 0) {
+        batchUpdateChanged = false;
+        // i messaggi informativi di ogni singola operazione vengono sospesi, gli errori restano visibili
+        batchSavedLogLevel = logLevel;
+        if (static_cast<int>(logLevel) > static_cast<int>(Loggers::LogLevel::Error)) {
+            logLevel = Loggers::LogLevel::Error;
+        }
+    }
+}
+
+void Library::endBatchUpdate() {
+
+    if (batchUpdateDepth == 0 || --batchUpdateDepth > 0) return;
+
+    logLevel = batchSavedLogLevel;
+    if (batchUpdateChanged && libraryObserver) {
+        libraryObserver->onMediaBatchChanged();
+    }
+    batchUpdateChanged = false;
+}
+
+bool Library::isBatchUpdating() const { return batchUpdateDepth > 0; }
+
+void Library::notifyBatchChanged() {
+
+    if (batchUpdateDepth > 0) {
+        batchUpdateChanged = true;
+    }
+    else if (libraryObserver) {
+        libraryObserver->onMediaBatchChanged();
+    }
+}
+
 void Library::logLibraryMessage(const std::string& msg, Loggers::LogLevel lvl) const {
 
     // log del messaggio se logger impostato e livello di severita' piu' alto
     if (libraryLogger && static_cast<int>(logLevel) >= static_cast<int>(lvl)) {
+        // la ricerca puo' essere eseguita su un thread secondario mentre la GUI usa la libreria: i messaggi vengono serializzati
+        static std::mutex logMutex;
+        std::lock_guard<std::mutex> lock(logMutex);
         libraryLogger->logMessage(msg);
     }
 }
@@ -60,9 +122,9 @@ void Library::logLibraryMessage(const std::string& msg, Loggers::LogLevel lvl) c
 
 // === HELPER ===
 
-bool Library::libraryIsEmpty() const { return libraryMedia.empty();  }
+bool Library::libraryIsEmpty() const { return getLibrarySize() == 0;  }
 
-unsigned int Library::getLibrarySize() const { return libraryMedia.size(); }
+unsigned int Library::getLibrarySize() const { return mappedSnapshot ? mappedSnapshot->getRecordCount() : libraryMedia.size(); }
 
 const std::vector<std::shared_ptr<Media::AbstractMedia>>& Library::getAllLibraryMedia() const {
 
@@ -73,38 +135,183 @@ const std::vector<std::shared_ptr<Media::AbstractMedia>>& Library::getAllLibrary
 
 }
 
+std::shared_ptr<Media::AbstractMedia> Library::getMediaAtIndex(unsigned int ind) const {
+
+    if (ind >= getLibrarySize()) {
+        return nullptr;
+    }
+    if (!mappedSnapshot) {
+        return libraryMedia[ind];
+    }
+    try {
+        return mappedSnapshot->getMediaAt(ind);
+    }
+    catch (const std::runtime_error& e) {
+        logLibraryMessage("[LIBRARY - GET MEDIA AT] Could not read mapped media at index " + std::to_string(ind) + ": " + std::string(e.what()), Loggers::LogLevel::Error);
+        return nullptr;
+    }
+}
+
 
 // === INSERIMENTO ===
 
 void Library::insertLibraryMedia(const std::shared_ptr<Media::AbstractMedia> media) {
 
+    insertLibraryMediaAt(media, getLibrarySize());
+}
+
+bool Library::insertLibraryMediaAt(const std::shared_ptr<Media::AbstractMedia> media, unsigned int pos) {
+
     if (!media) {
         logLibraryMessage("[LIBRARY - INSERT MEDIA] Media is not valid.\n", Loggers::LogLevel::Debug);
-        return;
+        return false;
+    }
+
+    try {
+        Visitors::MediaValidator validator;
+        media->accept(validator);
+    }
+    catch (const Visitors::MediaValidatorException& e) {
+        logLibraryMessage("[LIBRARY - INSERT MEDIA] Could not add media '" + media->getMediaName() + "' with ID=" +
+            std::to_string(media->getUniqueID()) + ": " + std::string(e.what()), Loggers::LogLevel::Error);
+        return false;
+    }
+    return restoreLibraryMediaAt(media, pos);
+}
+
+bool Library::restoreLibraryMediaAt(const std::shared_ptr<Media::AbstractMedia> media, unsigned int pos) {
+
+    if (!media) {
+        logLibraryMessage("[LIBRARY - INSERT MEDIA] Media is not valid.\n", Loggers::LogLevel::Debug);
+        return false;
     }
+    detachMappedSnapshot();
 
     if (checkDuplicateID(media->getUniqueID())) {
         logLibraryMessage("LIBRARY - INSERT MEDIA] Inserting duplicate ID media.\n", Loggers::LogLevel::Error);
-        return;
+        return false;
     }
 
     try {
 
-        Visitors::MediaValidator validator;
-        media->accept(validator);
-        libraryMedia.push_back(media);
+        bool append = pos >= libraryMedia.size();
+        if (append) {
+            pos = static_cast<unsigned int>(libraryMedia.size());
+            libraryMedia.push_back(media);
+            mediaIndexByID[media->getUniqueID()] = pos;
+        }
+        else {
+            libraryMedia.insert(libraryMedia.begin() + pos, media);
+            // il media inserito e quelli successivi cambiano posizione
+            updateMediaIndexFrom(pos);
+        }
+        searchIndex.insertMedia(*media);
+        if (columnSnapshotEnabled) {
+            mediaColumns.insertRow(pos, *media);
+        }
+        if (isJournalAttached()) {
+            if (append) LibraryJournal::appendInsert(journal.pendingRecords, media);
+            else LibraryJournal::appendInsertAt(journal.pendingRecords, pos, media);
+        }
+        if (batchUpdateDepth > 0) {
+            batchUpdateChanged = true;
+        }
+        else if (libraryObserver) {
+            libraryObserver->onMediaInserted(pos, media->getUniqueID());
+        }
         logLibraryMessage("[LIBRARY - INSERT MEDIA] Inserted media '" + media->getMediaName() + "' with ID=" +
             std::to_string(media->getUniqueID()) + " successfully!\n", Loggers::LogLevel::Info);
-
-    }
-    catch (const Visitors::MediaValidatorException& e) {
-        logLibraryMessage("[LIBRARY - INSERT MEDIA] Could not add media '" + media->getMediaName() + "' with ID=" +
-            std::to_string(media->getUniqueID()) + ": " + std::string(e.what()), Loggers::LogLevel::Error);
+        return true;
     }
     catch (const std::runtime_error& e) {
         logLibraryMessage("[LIBRARY - INSERT MEDIA] Could not insert media '" + media->getMediaName() + "' with ID=" +
             std::to_string(media->getUniqueID()) + ": " + std::string(e.what()), Loggers::LogLevel::Error);
     }
+    return false;
+}
+
+bool Library::insertLibraryMediaAtPositions(const std::vector<PositionedMedia>& media) {
+
+    // tutti i media vengono validati prima di modificare la libreria
+    for (const auto& positioned : media) {
+        if (!positioned.second) continue;
+        try {
+            Visitors::MediaValidator validator;
+            positioned.second->accept(validator);
+        }
+        catch (const Visitors::MediaValidatorException& e) {
+            logLibraryMessage("[LIBRARY - INSERT MEDIA] Could not insert " + std::to_string(media.size()) + " media: " + std::string(e.what()), Loggers::LogLevel::Error);
+            return false;
+        }
+    }
+    return restoreLibraryMediaAtPositions(media);
+}
+
+bool Library::restoreLibraryMediaAtPositions(const std::vector<PositionedMedia>& media) {
+
+    if (media.empty()) return true;
+    detachMappedSnapshot();
+
+    // posizioni e identificatori vengono verificati prima di modificare la libreria
+    const std::size_t newSize = libraryMedia.size() + media.size();
+    std::unordered_set<unsigned int> insertedIDs;
+    insertedIDs.reserve(media.size());
+    for (std::size_t i = 0; i < media.size(); ++i) {
+        const auto& positioned = media[i];
+        std::string error;
+        if (!positioned.second) {
+            error = "media is not valid.\n";
+        }
+        else if (positioned.first >= newSize || (i > 0 && positioned.first <= media[i - 1].first)) {
+            error = "position " + std::to_string(positioned.first) + " is not valid.\n";
+        }
+        else if (checkDuplicateID(positioned.second->getUniqueID()) || !insertedIDs.insert(positioned.second->getUniqueID()).second) {
+            error = "duplicate ID=" + std::to_string(positioned.second->getUniqueID()) + ".\n";
+        }
+        if (!error.empty()) {
+            logLibraryMessage("[LIBRARY - INSERT MEDIA] Could not insert " + std::to_string(media.size()) + " media: " + error, Loggers::LogLevel::Error);
+            return false;
+        }
+    }
+
+    // i media esistenti vengono spostati dal fondo, ciascuno una sola volta, lasciando spazio ai nuovi
+    std::size_t source = libraryMedia.size();
+    libraryMedia.resize(newSize);
+    for (std::size_t target = newSize, next = media.size(); next > 0; ) {
+        --target;
+        if (target == media[next - 1].first) {
+            libraryMedia[target] = media[--next].second;
+        }
+        else {
+            libraryMedia[target] = std::move(libraryMedia[--source]);
+        }
+    }
+    updateMediaIndexFrom(media.front().first);
+
+    std::vector<const Media::AbstractMedia*> inserted;
+    std::vector<unsigned int> positions;
+    inserted.reserve(media.size());
+    positions.reserve(media.size());
+    for (const auto& positioned : media) {
+        inserted.push_back(positioned.second.get());
+        positions.push_back(positioned.first);
+    }
+    searchIndex.insertMultipleMedia(inserted);
+    if (columnSnapshotEnabled) {
+        mediaColumns.insertRows(positions, inserted);
+    }
+    if (isJournalAttached()) {
+        std::vector<std::shared_ptr<Media::AbstractMedia>> encoded;
+        encoded.reserve(media.size());
+        for (const auto& positioned : media) {
+            encoded.push_back(positioned.second);
+        }
+        LibraryJournal::appendInsertMultipleAt(journal.pendingRecords, std::vector<std::uint32_t>(positions.begin(), positions.end()), encoded);
+    }
+    notifyBatchChanged();
+
+    logLibraryMessage("[LIBRARY - INSERT MEDIA] Inserted " + std::to_string(media.size()) + " media successfully!\n", Loggers::LogLevel::Info);
+    return true;
 }
 
 
@@ -116,29 +323,154 @@ bool Library::removeLibraryMediaByID(unsigned int id) {
         logLibraryMessage("[LIBRARY - REMOVE MEDIA] Library is empty\n", Loggers::LogLevel::Debug);
         return false;
     }
-
-    for (auto it = libraryMedia.begin(); it != libraryMedia.end(); ++it) {
-        if (*it && (*it)->getUniqueID() == id) {
-            std::string removed = (*it)->getMediaName();
-            libraryMedia.erase(it);
-            logLibraryMessage("[LIBRARY - REMOVE MEDIA] Successfully removed media '" + removed + "' with ID=" +
-                std::to_string(id) + "\n", Loggers::LogLevel::Info);
-            return true;
+    detachMappedSnapshot();
+
+    auto found = mediaIndexByID.find(id);
+    if (found != mediaIndexByID.end()) {
+
+        unsigned int pos = found->second;
+        std::string removed = libraryMedia[pos]->getMediaName();
+        searchIndex.removeMedia(*libraryMedia[pos]);
+        libraryMedia.erase(libraryMedia.begin() + pos);
+        mediaIndexByID.erase(found);
+        scoreCache.erase(id);
+        if (columnSnapshotEnabled) {
+            mediaColumns.eraseRow(pos);
         }
+        // le posizioni successive a quella rimossa scalano di uno
+        updateMediaIndexFrom(pos);
+        if (isJournalAttached()) {
+            LibraryJournal::appendRemove(journal.pendingRecords, pos);
+        }
+        if (batchUpdateDepth > 0) {
+            batchUpdateChanged = true;
+        }
+        else if (libraryObserver) {
+            libraryObserver->onMediaRemoved(pos, id);
+        }
+        logLibraryMessage("[LIBRARY - REMOVE MEDIA] Successfully removed media '" + removed + "' with ID=" +
+            std::to_string(id) + "\n", Loggers::LogLevel::Info);
+        return true;
     }
     logLibraryMessage("[LIBRARY - REMOVE MEDIA] Could not remove media with ID=" +
         std::to_string(id) + " from library\n", Loggers::LogLevel::Error);
     return false;
 }
 
+unsigned int Library::removeLibraryMediaByIDs(const std::vector<unsigned int>& ids, std::vector<PositionedMedia>* removed) {
+
+    if (removed) {
+        removed->clear();
+    }
+    if (libraryIsEmpty() || ids.empty()) {
+        logLibraryMessage("[LIBRARY - REMOVE MEDIA] Library is empty or no media to remove\n", Loggers::LogLevel::Debug);
+        return 0;
+    }
+    detachMappedSnapshot();
+
+    // posizioni dei media da rimuovere, senza ripetizioni e in ordine crescente
+    std::vector<unsigned int> positions;
+    positions.reserve(ids.size());
+    for (unsigned int id : ids) {
+        auto found = mediaIndexByID.find(id);
+        if (found != mediaIndexByID.end()) {
+            positions.push_back(found->second);
+        }
+    }
+    std::sort(positions.begin(), positions.end());
+    positions.erase(std::unique(positions.begin(), positions.end()), positions.end());
+    if (positions.size() < ids.size()) {
+        logLibraryMessage("[LIBRARY - REMOVE MEDIA] Ignored " + std::to_string(ids.size() - positions.size()) + " missing or repeated IDs\n",
+            Loggers::LogLevel::Debug);
+    }
+    if (positions.empty()) return 0;
+
+    // l'indice di ricerca viene aggiornato prima di compattare, con una sola passata su ogni posting list interessata
+    std::vector<const Media::AbstractMedia*> removedMedia;
+    removedMedia.reserve(positions.size());
+    for (unsigned int pos : positions) {
+        const auto& media = libraryMedia[pos];
+        removedMedia.push_back(media.get());
+        mediaIndexByID.erase(media->getUniqueID());
+        scoreCache.erase(media->getUniqueID());
+        if (removed) {
+            removed->emplace_back(pos, media);
+        }
+    }
+    searchIndex.removeMultipleMedia(removedMedia);
+
+    // compattazione stabile: ogni media successivo alla prima posizione rimossa viene spostato una sola volta
+    std::size_t target = positions.front();
+    std::size_t next = 0;
+    for (std::size_t source = positions.front(); source < libraryMedia.size(); ++source) {
+        if (next < positions.size() && positions[next] == source) {
+            ++next;
+        }
+        else {
+            libraryMedia[target++] = std::move(libraryMedia[source]);
+        }
+    }
+    libraryMedia.resize(target);
+    updateMediaIndexFrom(positions.front());
+
+    if (columnSnapshotEnabled) {
+        mediaColumns.eraseRows(positions);
+    }
+    if (isJournalAttached()) {
+        LibraryJournal::appendRemoveMultiple(journal.pendingRecords, std::vector<std::uint32_t>(positions.begin(), positions.end()));
+    }
+    notifyBatchChanged();
+
+    logLibraryMessage("[LIBRARY - REMOVE MEDIA] Removed " + std::to_string(positions.size()) + " media\n", Loggers::LogLevel::Info);
+    return static_cast<unsigned int>(positions.size());
+}
+
 void Library::clearLibrary() {
 
     if (!libraryIsEmpty()) {
+        mappedSnapshot.reset();
+        detachJournal();
         libraryMedia.clear();
+        mediaIndexByID.clear();
+        searchIndex.clearIndex();
+        mediaColumns.clearColumns();
+        scoreCache.clear();
         logLibraryMessage("[LIBRARY - CLEAR LIBRARY] Cleared all library contents\n", Loggers::LogLevel::Info);
     }
 }
 
+void Library::takeContents(Library& other) {
+
+    if (&other == this) return;
+
+    mappedSnapshot = std::move(other.mappedSnapshot);
+    libraryMedia = std::move(other.libraryMedia);
+    mediaIndexByID = std::move(other.mediaIndexByID);
+    searchIndex = std::move(other.searchIndex);
+    scoreCache = std::move(other.scoreCache);
+    journal = std::move(other.journal);
+    if (columnSnapshotEnabled == other.columnSnapshotEnabled) {
+        mediaColumns = std::move(other.mediaColumns);
+    }
+    else if (columnSnapshotEnabled) {
+        mediaColumns.rebuildColumns(libraryMedia);
+    }
+    else {
+        mediaColumns.clearColumns();
+    }
+
+    // l'altra libreria resta vuota (e non associata ad alcun journal)
+    other.mappedSnapshot.reset();
+    other.detachJournal();
+    other.libraryMedia.clear();
+    other.mediaIndexByID.clear();
+    other.searchIndex.clearIndex();
+    other.mediaColumns.clearColumns();
+    other.scoreCache.clear();
+
+    logLibraryMessage("[LIBRARY - TAKE CONTENTS] Replaced library contents with " + std::to_string(getLibrarySize()) + " media\n", Loggers::LogLevel::Info);
+}
+
 
 // === MODIFICA ===
 
@@ -150,6 +482,7 @@ bool Library::editLibraryMediaByID(
         logLibraryMessage("[LIBRARY - EDIT MEDIA] Library is empty\n", Loggers::LogLevel::Debug);
         return false;
     }
+    detachMappedSnapshot();
 
     auto media = getMediaByID(id);
     if (!media) {
@@ -157,25 +490,178 @@ bool Library::editLibraryMediaByID(
         return false;
     }
 
+    // il media viene tolto dall'indice di ricerca prima della modifica, e reinserito in ogni caso al termine
+    searchIndex.removeMedia(*media);
+
     try {
 
         Visitors::MediaEditor editor(mediaEdits);
         media->accept(editor);
+        // una modifica fallita lascia il media invariato, lo score in cache va quindi invalidato solo dopo una modifica riuscita
+        scoreCache.erase(id);
+        searchIndex.insertMedia(*media);
+        if (columnSnapshotEnabled) {
+            mediaColumns.updateRow(getMediaIndexByID(id), *media);
+        }
+        // una modifica fallita non cambia il media (MediaEditor applica le modifiche a una copia), vengono registrate solo quelle riuscite
+        if (isJournalAttached()) {
+            LibraryJournal::appendEdit(journal.pendingRecords, getMediaIndexByID(id), mediaEdits);
+        }
+        if (batchUpdateDepth > 0) {
+            batchUpdateChanged = true;
+        }
+        else if (libraryObserver) {
+            libraryObserver->onMediaChanged(getMediaIndexByID(id), id);
+        }
         logLibraryMessage("[LIBRARY - EDIT] Successfully edited media with ID=" + std::to_string(id) + "\n", Loggers::LogLevel::Info);
         return true;
     }
     catch (const Visitors::MediaValidatorException& e) {
+        searchIndex.insertMedia(*media);
         logLibraryMessage("[LIBRARY - EDIT MEDIA] Failed to edit media with ID=" + std::to_string(id) + ", " +
             std::string(e.what()), Loggers::LogLevel::Error);
         throw Visitors::MediaValidatorException(std::string(e.what()));
     }
     catch (const std::exception& e) {
+        searchIndex.insertMedia(*media);
         logLibraryMessage("[LIBRARY - EDIT MEDIA] Failed to edit media with ID=" + std::to_string(id) + ", " +
             std::string(e.what()), Loggers::LogLevel::Error);
         return false;
     }
 }
 
+std::vector<std::string> Library::editLibraryMediaByIDs(
+    const std::vector<unsigned int>& ids,
+    const std::vector<std::unordered_map<std::string, std::string>>& mediaEdits,
+    unsigned int threadCount,
+    std::vector<std::unordered_map<std::string, std::string>>* previousValues)
+{
+    static const unsigned int MIN_EDITS_PER_WORKER = 256;
+
+    const unsigned int count = static_cast<unsigned int>(ids.size());
+    std::vector<std::string> errors(count);
+    if (previousValues) {
+        previousValues->assign(count, {});
+    }
+    if (count == 0) return errors;
+
+    if (mediaEdits.size() != 1 && mediaEdits.size() != count) {
+        logLibraryMessage("[LIBRARY - EDIT MEDIA] Error: " + std::to_string(mediaEdits.size()) + " edit maps for " + std::to_string(count) + " media\n",
+            Loggers::LogLevel::Error);
+        errors.assign(count, "Edit map is missing.\n");
+        return errors;
+    }
+    detachMappedSnapshot();
+
+    // media da modificare (nullptr se assente o ripetuto)
+    std::vector<Media::AbstractMedia*> targets(count, nullptr);
+    std::unordered_set<unsigned int> seenIDs;
+    seenIDs.reserve(count);
+    for (unsigned int i = 0; i < count; ++i) {
+        auto found = mediaIndexByID.find(ids[i]);
+        if (found == mediaIndexByID.end()) {
+            errors[i] = "No media with ID=" + std::to_string(ids[i]) + "\n";
+        }
+        else if (!seenIDs.insert(ids[i]).second) {
+            errors[i] = "Media with ID=" + std::to_string(ids[i]) + " is repeated.\n";
+        }
+        else {
+            targets[i] = libraryMedia[found->second].get();
+        }
+    }
+
+    // i worker elaborano blocchi contigui degli identificatori: ogni worker accede solo ai propri media
+    const unsigned int workers = getWorkerCount(count, MIN_EDITS_PER_WORKER, threadCount);
+
+    // modifiche effettivamente applicate a ciascun media (i campi che non cambiano, o non appartengono al tipo del media, vengono scartati)
+    std::vector<std::unordered_map<std::string, std::string>> appliedEdits(count);
+    std::vector<std::unordered_map<std::string, std::string>> previous(count);
+    std::vector<char> reindex(count, 0);
+
+    // legge (con un proprio AttributeReader) i valori attuali dei campi da modificare
+    runInChunks(count, workers, [&](unsigned int, unsigned int first, unsigned int last) {
+        for (unsigned int i = first; i < last; ++i) {
+            if (!targets[i]) continue;
+            const auto& edits = mediaEdits.size() == 1 ? mediaEdits.front() : mediaEdits[i];
+
+            std::vector<std::string> names;
+            names.reserve(edits.size());
+            for (const auto& edit : edits) {
+                names.push_back(edit.first);
+            }
+            Visitors::AttributeReader reader(names);
+            targets[i]->accept(reader);
+
+            for (const auto& current : reader.getValues()) {
+                const std::string& newValue = edits.at(current.first);
+                if (current.second != newValue) {
+                    appliedEdits[i].emplace(current.first, newValue);
+                    previous[i].emplace(current.first, current.second);
+                    if (SearchIndex::isIndexedAttribute(current.first)) reindex[i] = 1;
+                }
+            }
+        }
+    });
+
+    // l'indice di ricerca non e' condiviso tra i thread: i media con campi indicizzati da modificare vengono tolti prima della modifica, e reinseriti al termine
+    for (unsigned int i = 0; i < count; ++i) {
+        if (reindex[i]) {
+            searchIndex.removeMedia(*targets[i]);
+        }
+        if (!appliedEdits[i].empty()) {
+            scoreCache.erase(ids[i]);
+        }
+    }
+
+    // modifica (con un proprio MediaEditor) i media che cambiano
+    runInChunks(count, workers, [&](unsigned int, unsigned int first, unsigned int last) {
+        for (unsigned int i = first; i < last; ++i) {
+            if (appliedEdits[i].empty()) continue;
+            try {
+                // MediaEditor applica le modifiche a una copia validata, un media non valido resta invariato
+                Visitors::MediaEditor editor(appliedEdits[i]);
+                targets[i]->accept(editor);
+            }
+            catch (const std::exception& e) {
+                errors[i] = e.what();
+                appliedEdits[i].clear();
+                previous[i].clear();
+            }
+        }
+    });
+
+    // aggiornamento seriale delle strutture condivise, nell'ordine degli identificatori
+    unsigned int edited = 0;
+    beginBatchUpdate();
+    for (unsigned int i = 0; i < count; ++i) {
+        if (!errors[i].empty()) {
+            logLibraryMessage("[LIBRARY - EDIT MEDIA] Failed to edit media with ID=" + std::to_string(ids[i]) + ", " + errors[i], Loggers::LogLevel::Error);
+        }
+        if (reindex[i]) {
+            searchIndex.insertMedia(*targets[i]);
+        }
+        if (appliedEdits[i].empty()) continue;
+
+        unsigned int pos = getMediaIndexByID(ids[i]);
+        if (columnSnapshotEnabled) {
+            mediaColumns.updateRow(pos, *targets[i]);
+        }
+        if (isJournalAttached()) {
+            LibraryJournal::appendEdit(journal.pendingRecords, pos, appliedEdits[i]);
+        }
+        batchUpdateChanged = true;
+        ++edited;
+    }
+    endBatchUpdate();
+    if (previousValues) {
+        *previousValues = std::move(previous);
+    }
+
+    logLibraryMessage("[LIBRARY - EDIT MEDIA] Edited " + std::to_string(edited) + " of " + std::to_string(count) + " media with " +
+        std::to_string(std::max(workers, 1u)) + " workers\n", Loggers::LogLevel::Info);
+    return errors;
+}
+
 
 // === VISUALIZZAZIONE (Usati per debugging) ===
 
@@ -231,7 +717,9 @@ std::string Library::viewAllLibraryMedia() const {
     int count = 0;
     if (!libraryIsEmpty()) {
         Visitors::ConcisePrinter printer;
-        for (auto& media : libraryMedia) {
+        for (unsigned int i = 0; i < getLibrarySize(); ++i) {
+            auto media = readMediaAt(i);
+            if (!media) continue;
             media->accept(printer);
             library += "\nMedia " + std::to_string(count) + ") " + printer.getConcisePreview();
             count++;
@@ -243,7 +731,7 @@ std::string Library::viewAllLibraryMedia() const {
 
 // === RICERCA ===
 
-std::vector<unsigned int> Library::searchLibrary(const SearchQuery& query) const {
+std::vector<unsigned int> Library::searchLibrary(const SearchQuery& query, unsigned int threadCount, const std::atomic<bool>* cancelled) const {
 
     std::vector<unsigned int> results;
     if (libraryIsEmpty()) {
@@ -251,15 +739,140 @@ std::vector<unsigned int> Library::searchLibrary(const SearchQuery& query) const
         return results;
     }
 
-    Visitors::SearchVisitor search(query);
+    // file mappato: la ricerca legge direttamente i record, senza indice e senza materializzare i media
+    if (mappedSnapshot) {
+        results = mappedSnapshot->searchRecords(query, cancelled);
+        logLibraryMessage("[LIBRARY - SEARCH LIBRARY] Mapped search over " + std::to_string(getLibrarySize()) + " records found " +
+            std::to_string(results.size()) + " matches\n", Loggers::LogLevel::Debug);
+        return results;
+    }
 
-    for (const auto& media : libraryMedia) {
-        if (media) {
-            media.get()->accept(search);
+    // filtro per identificatore: al piu' un media da verificare
+    if (query.getMediaID() != 0) {
+        Visitors::SearchVisitor search(query);
+        unsigned int pos = getMediaIndexByID(query.getMediaID());
+        if (pos < getLibrarySize()) {
+            libraryMedia[pos]->accept(search);
+        }
+        return search.getMatches();
+    }
+
+    // l'indice restringe la ricerca ai soli candidati, che vengono poi verificati nell'ordine della libreria
+    std::vector<unsigned int> candidates;
+    if (searchIndex.findCandidates(query, candidates)) {
+        return visitSearchCandidates(query, candidates, threadCount, cancelled);
+    }
+    // senza filtri testuali indicizzabili, lo snapshot colonnare valuta i filtri numerici con un ciclo su memoria contigua
+    else if (columnSnapshotEnabled) {
+
+        std::vector<unsigned int> positions;
+        mediaColumns.selectRows(query, positions);
+
+        // i filtri numerici e di tipo sono gli unici impostati, le righe selezionate sono gia' i risultati
+        if (!query.hasTextFilters()) {
+            results.reserve(positions.size());
+            for (unsigned int pos : positions) {
+                results.push_back(mediaColumns.getUniqueIDs()[pos]);
+            }
+            return results;
+        }
+        return visitSearchPositions(query, &positions, threadCount, cancelled);
+    }
+
+    // nessun filtro indicizzabile, scansione completa
+    return visitSearchPositions(query, nullptr, threadCount, cancelled);
+}
+
+std::vector<unsigned int> Library::narrowSearchResults(
+    const SearchQuery& query,
+    const std::vector<unsigned int>& previousIDs,
+    unsigned int threadCount,
+    const std::atomic<bool>* cancelled) const
+{
+    // file mappato: i record vengono letti in ordine dal file, la ricerca completa non materializza i media
+    if (mappedSnapshot) {
+        return searchLibrary(query, threadCount, cancelled);
+    }
+
+    // se i risultati precedenti sono buona parte della libreria, verificarli per posizione non fa risparmiare rispetto alla ricerca normale
+    if (previousIDs.size() >= getLibrarySize() / 2) {
+        return searchLibrary(query, threadCount, cancelled);
+    }
+
+    // vengono verificati i candidati dell'indice o i risultati precedenti, i meno numerosi (entrambi contengono tutti i risultati)
+    std::vector<unsigned int> candidates;
+    if (searchIndex.findCandidates(query, candidates) && candidates.size() < previousIDs.size()) {
+        return visitSearchCandidates(query, candidates, threadCount, cancelled);
+    }
+    logLibraryMessage("[LIBRARY - SEARCH LIBRARY] Narrowing search to " + std::to_string(previousIDs.size()) + " previous results\n",
+        Loggers::LogLevel::Debug);
+    return visitSearchCandidates(query, previousIDs, threadCount, cancelled);
+}
+
+std::vector<unsigned int> Library::visitSearchCandidates(
+    const SearchQuery& query,
+    const std::vector<unsigned int>& candidateIDs,
+    unsigned int threadCount,
+    const std::atomic<bool>* cancelled) const
+{
+    std::vector<unsigned int> positions;
+    positions.reserve(candidateIDs.size());
+    for (unsigned int id : candidateIDs) {
+        auto found = mediaIndexByID.find(id);
+        // con lo snapshot colonnare i filtri numerici scartano i candidati senza visitarli
+        if (found != mediaIndexByID.end() && (!columnSnapshotEnabled || mediaColumns.rowMatches(found->second, query))) {
+            positions.push_back(found->second);
+        }
+    }
+    std::sort(positions.begin(), positions.end());
+
+    return visitSearchPositions(query, &positions, threadCount, cancelled);
+}
+
+std::vector<unsigned int> Library::visitSearchPositions(
+    const SearchQuery& query,
+    const std::vector<unsigned int>* positions,
+    unsigned int threadCount,
+    const std::atomic<bool>* cancelled) const
+{
+    static const unsigned int MIN_MEDIA_PER_WORKER = 2048;
+    // ogni quanti media viene controllato il flag di annullamento
+    static const unsigned int CANCEL_CHECK_INTERVAL = 1024;
+
+    const unsigned int count = positions ? positions->size() : getLibrarySize();
+
+    // visita (con un proprio SearchVisitor) le posizioni nell'intervallo [first, last)
+    auto visitRange = [this, &query, positions, cancelled](unsigned int first, unsigned int last) {
+        Visitors::SearchVisitor search(query);
+        for (unsigned int i = first; i < last; ++i) {
+            if (cancelled && (i - first) % CANCEL_CHECK_INTERVAL == 0 && cancelled->load(std::memory_order_relaxed)) {
+                break;
+            }
+            const auto& media = libraryMedia[positions ? (*positions)[i] : i];
+            if (media) {
+                media->accept(search);
+            }
         }
+        return search.getMatches();
+    };
+
+    const unsigned int workers = getWorkerCount(count, MIN_MEDIA_PER_WORKER, threadCount);
+    if (workers <= 1) {
+        return visitRange(0, count);
     }
 
-    results = search.getMatches();
+    // ogni worker visita un blocco contiguo, i risultati vengono poi concatenati nell'ordine dei blocchi
+    std::vector<std::vector<unsigned int>> partialResults(workers);
+    runInChunks(count, workers, [&partialResults, &visitRange](unsigned int chunk, unsigned int first, unsigned int last) {
+        partialResults[chunk] = visitRange(first, last);
+    });
+
+    std::vector<unsigned int> results;
+    for (const auto& partial : partialResults) {
+        results.insert(results.end(), partial.begin(), partial.end());
+    }
+    logLibraryMessage("[LIBRARY - SEARCH LIBRARY] Parallel search over " + std::to_string(count) + " media with " +
+        std::to_string(workers) + " workers found " + std::to_string(results.size()) + " matches\n", Loggers::LogLevel::Debug);
     return results;
 }
 
@@ -273,75 +886,232 @@ std::shared_ptr<Media::AbstractMedia> Library::getMediaByID(unsigned int id) con
         return nullptr;
     }
 
-    for (auto& media : libraryMedia) {
-        if (media && media->getUniqueID() == id) {
+    if (mappedSnapshot) {
+        unsigned int pos = mappedSnapshot->getIndexByID(id);
+        auto media = pos < getLibrarySize() ? getMediaAtIndex(pos) : nullptr;
+        if (!media) {
+            logLibraryMessage("[LIBRARY - GET MEDIA] Failed to fetch media with ID=" + std::to_string(id) + "\n", Loggers::LogLevel::Debug);
+        }
+        return media;
+    }
 
-            logLibraryMessage("[LIBRARY - GET MEDIA] Successfully fetched media '" + media->getMediaName() + "' with ID=" +
-                std::to_string(media->getUniqueID()) + "\n", Loggers::LogLevel::Debug);
+    auto found = mediaIndexByID.find(id);
+    if (found != mediaIndexByID.end()) {
 
-            return media;
-        }
+        const auto& media = libraryMedia[found->second];
+        logLibraryMessage("[LIBRARY - GET MEDIA] Successfully fetched media '" + media->getMediaName() + "' with ID=" +
+            std::to_string(media->getUniqueID()) + "\n", Loggers::LogLevel::Debug);
+
+        return media;
     }
     logLibraryMessage("[LIBRARY - GET MEDIA] Failed to fetch media with ID=" + std::to_string(id) + "\n", Loggers::LogLevel::Debug);
     return nullptr;
 }
 
+unsigned int Library::getMediaIndexByID(unsigned int id) const {
+
+    if (mappedSnapshot) {
+        return mappedSnapshot->getIndexByID(id);
+    }
+    auto found = mediaIndexByID.find(id);
+    if (found == mediaIndexByID.end()) {
+        return getLibrarySize();
+    }
+    return found->second;
+}
+
+
+// === SNAPSHOT COLONNARE ===
+
+void Library::setColumnSnapshotEnabled(bool enabled) {
+
+    if (enabled == columnSnapshotEnabled) return;
+
+    columnSnapshotEnabled = enabled;
+    if (enabled) {
+        mediaColumns.rebuildColumns(libraryMedia);
+        logLibraryMessage("[LIBRARY - COLUMN SNAPSHOT] Built column snapshot with " + std::to_string(mediaColumns.getRowCount()) + " rows\n", Loggers::LogLevel::Debug);
+    }
+    else {
+        mediaColumns = MediaColumns();
+        logLibraryMessage("[LIBRARY - COLUMN SNAPSHOT] Released column snapshot\n", Loggers::LogLevel::Debug);
+    }
+}
+
+bool Library::isColumnSnapshotEnabled() const { return columnSnapshotEnabled; }
+
+const MediaColumns& Library::getColumnSnapshot() const { return mediaColumns; }
+
 
 // === SCORING VISITOR ===
 
+void Library::precomputeLibraryScores() const {
+
+    scoreCache.reserve(getLibrarySize());
+    unsigned int computed = 0;
+    Visitors::ScoreVisitor scoring;
+    for (unsigned int i = 0; i < getLibrarySize(); ++i) {
+        if (scoreCache.find(getUniqueIDAt(i)) != scoreCache.end()) continue;
+        auto media = readMediaAt(i);
+        if (media) {
+            media->accept(scoring);
+            scoreCache.emplace(media->getUniqueID(), ScoreEntry{ scoring.getScoreValue(), scoring.getScoreLabel(), scoring.getScoreInfo() });
+            ++computed;
+        }
+    }
+    logLibraryMessage("[LIBRARY - PRECOMPUTE SCORES] Computed " + std::to_string(computed) + " new scores (" +
+        std::to_string(scoreCache.size()) + " cached)\n", Loggers::LogLevel::Debug);
+}
+
+void Library::clearScoreCache() { scoreCache.clear(); }
+
 float Library::getMediaScoreValueByID(unsigned int id) const {
 
-    auto media = getMediaByID(id);
-    if (!media) {
+    const ScoreEntry* score = getScoreEntry(id);
+    if (!score) {
         logLibraryMessage("[LIBRARY - GET SCORE VALUE] Error: Could not fetch media with ID= " + std::to_string(id) + "\n", Loggers::LogLevel::Error);
         return 0.0f;
     }
-    Visitors::ScoreVisitor scoring;
-    media->accept(scoring);
     logLibraryMessage("[LIBRARY - GET SCORE VALUE] Media with ID=" + std::to_string(id) + " has score: " +
-        std::to_string(scoring.getScoreValue()).substr(0, 4) + "/100\n", Loggers::LogLevel::Info);
-    return scoring.getScoreValue();
+        std::to_string(score->value).substr(0, 4) + "/100\n", Loggers::LogLevel::Info);
+    return score->value;
 }
 
 std::string Library::getMediaScoreLabelByID(unsigned int id) const {
 
-    auto media = getMediaByID(id);
-    if (!media) {
+    const ScoreEntry* score = getScoreEntry(id);
+    if (!score) {
         logLibraryMessage("[LIBRARY - GET SCORE LABEL] Error: Could not fetch media with ID= " + std::to_string(id) + "\n", Loggers::LogLevel::Error);
         return "Unknown Quality";
     }
-    Visitors::ScoreVisitor scoring;
-    media->accept(scoring);
-    logLibraryMessage("[LIBRARY - GET SCORE LABEL] Media with ID=" + std::to_string(id) + " has quality label: " + scoring.getScoreLabel() + "\n", Loggers::LogLevel::Info);
-    return scoring.getScoreLabel();
+    logLibraryMessage("[LIBRARY - GET SCORE LABEL] Media with ID=" + std::to_string(id) + " has quality label: " + score->label + "\n", Loggers::LogLevel::Info);
+    return score->label;
 }
 
 std::string Library::getMediaScoreInfoByID(unsigned int id) const {
 
-    auto media = getMediaByID(id);
-    if (!media) {
+    const ScoreEntry* score = getScoreEntry(id);
+    if (!score) {
         logLibraryMessage("[LIBRARY - GET SCORE INFO] Error: Could not fetch media with ID= " + std::to_string(id) + "\n", Loggers::LogLevel::Error);
         return "Unknown Info";
     }
-    Visitors::ScoreVisitor scoring;
-    media->accept(scoring);
-    logLibraryMessage("[LIBRARY - GET SCORE INFO] Media with ID=" + std::to_string(id) + " scoring info: " + scoring.getScoreInfo() + "\n", Loggers::LogLevel::Info);
-    return scoring.getScoreInfo();
+    logLibraryMessage("[LIBRARY - GET SCORE INFO] Media with ID=" + std::to_string(id) + " scoring info: " + score->info + "\n", Loggers::LogLevel::Info);
+    return score->info;
 }
 
+std::vector<float> Library::scoreAll() const { return scoreRange(0, getLibrarySize()); }
 
-// === JSON ===
+std::vector<float> Library::scoreRange(unsigned int first, unsigned int last) const {
 
-QJsonObject Library::toJson() const {
+    std::vector<float> scores;
+    if (last > getLibrarySize()) last = getLibrarySize();
+    if (first >= last) {
+        logLibraryMessage("[LIBRARY - SCORE RANGE] Empty range [" + std::to_string(first) + ", " + std::to_string(last) + ")\n", Loggers::LogLevel::Debug);
+        return scores;
+    }
+    scores.assign(last - first, Visitors::ScoreVisitor::SCORE_UNKNOWN);
 
-    // oggetto JSON principale per contenere tutti i media attualmente in libreria
-    QJsonObject rootObject;
+    // con un file mappato lo snapshot colonnare viene costruito solo alla materializzazione dei media
+    if (columnSnapshotEnabled && !mappedSnapshot) {
+        mediaColumns.scoreRows(first, last, scores.data());
+    }
+    else {
+        // senza snapshot le colonne vengono lette solo per l'intervallo richiesto
+        MediaColumns rangeColumns;
+        for (unsigned int i = first; i < last; ++i) {
+            auto media = readMediaAt(i);
+            if (media) {
+                rangeColumns.appendRow(*media);
+            }
+        }
+        rangeColumns.scoreRows(0, rangeColumns.getRowCount(), scores.data());
+    }
 
-    // array JSON per contenere tutti i media serializzati
+    logLibraryMessage("[LIBRARY - SCORE RANGE] Computed " + std::to_string(scores.size()) + " scores\n", Loggers::LogLevel::Debug);
+    return scores;
+}
+
+std::vector<unsigned int> Library::getTopScoredMedia(unsigned int k, const SearchQuery& query) const {
+
+    // numero di media valutati insieme dai kernel
+    static const unsigned int TOP_SCORE_BLOCK = 1024;
+
+    std::vector<unsigned int> topIDs;
+    if (k == 0 || libraryIsEmpty()) {
+        return topIDs;
+    }
+
+    // posizioni candidate: quelle dei media trovati dalla ricerca, oppure tutte se non ci sono filtri
+    const bool filtered = query.hasFilters();
+    std::vector<unsigned int> matchPositions;
+    if (filtered) {
+        for (unsigned int id : searchLibrary(query)) {
+            matchPositions.push_back(getMediaIndexByID(id));
+        }
+    }
+    const unsigned int candidateCount = filtered ? matchPositions.size() : getLibrarySize();
+
+    // heap di al piu' k elementi (score, posizione), in cima il peggiore tra i migliori trovati finora
+    using ScoredPosition = std::pair<float, unsigned int>;
+    auto better = [](const ScoredPosition& a, const ScoredPosition& b) {
+        return a.first > b.first || (a.first == b.first && a.second < b.second);
+    };
+    std::vector<ScoredPosition> heap;
+    heap.reserve(std::min(k, candidateCount));
+
+    std::vector<unsigned int> blockPositions;
+    std::vector<float> blockScores;
+    blockPositions.reserve(TOP_SCORE_BLOCK);
+
+    for (unsigned int start = 0; start < candidateCount; start += TOP_SCORE_BLOCK) {
+
+        unsigned int end = std::min(candidateCount, start + TOP_SCORE_BLOCK);
+        blockPositions.clear();
+        for (unsigned int i = start; i < end; ++i) {
+            blockPositions.push_back(filtered ? matchPositions[i] : i);
+        }
+        scorePositions(blockPositions, blockScores);
+
+        for (unsigned int i = 0; i < blockPositions.size(); ++i) {
+            ScoredPosition candidate(blockScores[i], blockPositions[i]);
+            if (heap.size() < k) {
+                heap.push_back(candidate);
+                std::push_heap(heap.begin(), heap.end(), better);
+            }
+            else if (better(candidate, heap.front())) {
+                std::pop_heap(heap.begin(), heap.end(), better);
+                heap.back() = candidate;
+                std::push_heap(heap.begin(), heap.end(), better);
+            }
+        }
+    }
+
+    // ordinamento finale dei soli k elementi, dal migliore
+    std::sort_heap(heap.begin(), heap.end(), better);
+    topIDs.reserve(heap.size());
+    for (const auto& scored : heap) {
+        topIDs.push_back(getUniqueIDAt(scored.second));
+    }
+
+    logLibraryMessage("[LIBRARY - TOP SCORED] Selected " + std::to_string(topIDs.size()) + " of " +
+        std::to_string(candidateCount) + " media\n", Loggers::LogLevel::Debug);
+    return topIDs;
+}
+
+
+// === JSON ===
+
+QJsonObject Library::toJson() const {
+
+    // oggetto JSON principale per contenere tutti i media attualmente in libreria
+    QJsonObject rootObject;
+
+    // array JSON per contenere tutti i media serializzati
     QJsonArray mediaArray;
 
     // scorre tutti i media
-    for (const auto& media : libraryMedia) {
+    for (unsigned int i = 0; i < getLibrarySize(); ++i) {
+        auto media = readMediaAt(i);
         if (media) {
 
             // serializza in formato JSON ciascun media (virtuale puro 'toJson')
@@ -360,10 +1130,16 @@ QJsonObject Library::toJson() const {
 
 }
 
-void Library::fromJson(const QJsonObject& obj) {
+void Library::fromJson(const QJsonObject& obj, unsigned int threadCount) {
 
     // svuota la libreria attuale
+    mappedSnapshot.reset();
+    detachJournal();
     libraryMedia.clear();
+    mediaIndexByID.clear();
+    searchIndex.clearIndex();
+    mediaColumns.clearColumns();
+    scoreCache.clear();
 
 
     logLibraryMessage("[LIBRARY - LOAD LIBRARY] Attempting to read library contents from file...\n", Loggers::LogLevel::Debug);
@@ -376,60 +1152,52 @@ void Library::fromJson(const QJsonObject& obj) {
     else if (obj.contains("media") && obj["media"].isArray()) {
 
         QJsonArray mediaArray = obj["media"].toArray();
-        unsigned int mediaCount = 0;
 
-        // scorre ogni media nell'array
+        // prende l'oggetto JSON, il tipo e l'identificatore salvato di ogni media nell'array
+        std::vector<QJsonObject> mediaObjects;
+        std::vector<ImportRecord> records;
+        mediaObjects.reserve(mediaArray.size());
+        records.reserve(mediaArray.size());
         for (const auto& mediaValue : mediaArray) {
+            mediaObjects.push_back(mediaValue.toObject());
+            const QJsonObject& mediaObject = mediaObjects.back();
+            bool hasUniqueID = mediaObject.contains("uniqueID") && mediaObject["uniqueID"].isDouble();
+            records.push_back({ mediaObject["mediaType"].toString().toStdString(), hasUniqueID,
+                                hasUniqueID ? static_cast<unsigned int>(mediaObject["uniqueID"].toInt()) : 0 });
+        }
 
-            // prende l'oggetto JSON del media
-            QJsonObject mediaObject = mediaValue.toObject();
-            // prende il tipo del media salvato
-            QString mediaType = mediaObject["mediaType"].toString();
-            Model::Library::MediaFactory factory;
-
-            try {
-
-                // tenta di ricreare il tipo trovato utilizzando MediaFactory, usando mappa di attributi vuota
-                auto mediaPtr = factory.createMedia(mediaType.toStdString(), {});
-                if (mediaPtr) {
-
-                    // se questo ha successo, si usa il virtuale puro 'fromJson' per settare gli attributi
-                    mediaPtr->fromJson(mediaObject);
-                    // e si aggiunge il media alla fine della libreria
-                    libraryMedia.push_back(mediaPtr);
-                    ++mediaCount;
-                }
-                // altrimenti, errre
-                else {
-                    logLibraryMessage("[LIBRARY - LOAD LIBRARY Error: MediaFactory error for media type '" + mediaType.toStdString() + "'\n", Loggers::LogLevel::Error);
-                }
-            }
-            catch (const Model::Visitors::MediaValidatorException& e) {
-                logLibraryMessage("[LIBRARY - LOAD LIBRARY] Error: MediaValidator could not validate media of type '" + mediaType.toStdString() + "', " + std::string(e.what()), Loggers::LogLevel::Error);
-            }
-            catch (const std::exception& e) {
-                logLibraryMessage("[LIBRARY - LOAD LIBRARY] Error: MediaFactory could not create media of type '" + mediaType.toStdString() + "', " + std::string(e.what()), Loggers::LogLevel::Error);
-            }
+        // ricrea ciascun media con MediaFactory, poi si usa il virtuale puro 'fromJson' per settare gli attributi
+        std::vector<std::string> errors;
+        importRecords(records, [&mediaObjects](unsigned int i, Media::AbstractMedia& media) { media.fromJson(mediaObjects[i]); },
+                      threadCount, libraryMedia, errors);
+        for (const auto& error : errors) {
+            logLibraryMessage(error, Loggers::LogLevel::Error);
         }
-        logLibraryMessage("[LIBRARY - LOAD LIBRARY] Successfully read " + std::to_string(mediaCount) + " media from JSON object into library\n", Loggers::LogLevel::Info);
+
+        // ricostruisce l'indice degli identificatori una sola volta, a caricamento concluso
+        rebuildLibraryIndexes();
+        logLibraryMessage("[LIBRARY - LOAD LIBRARY] Successfully read " + std::to_string(libraryMedia.size()) + " media from JSON object into library\n", Loggers::LogLevel::Info);
     }
     else {
         logLibraryMessage("[LIBRARY - LOAD LIBRARY] Error: Could not load library contents file!\n", Loggers::LogLevel::Error);
     }
 }
 
-bool Library::saveToFile(const QString& filename) const {
+bool Library::saveToFile(const QString& filename, bool compact, const ProgressCallback& progress) const {
 
-    logLibraryMessage("[LIBRARY - SAVE TO FILE] Saving library contents to file '" + filename.toStdString() + "'\n", Loggers::LogLevel::Info);
+    // media scritti tra due notifiche dell'avanzamento
+    static const unsigned int PROGRESS_STEP = 8192;
 
-    // serializza l'intera libreria in un oggetto JSON
-    QJsonObject rootObject = toJson();
 
-    // crea un QJsonDocument da questo in modo da poterci scrivere
-    QJsonDocument doc(rootObject);
+    logLibraryMessage("[LIBRARY - SAVE TO FILE] Saving library contents to file '" + filename.toStdString() + "'\n", Loggers::LogLevel::Info);
 
-    // crea e apre il file di salvataggio in modalita' scrittura
-    QFile file(filename);
+    // se il file e' quello dell'ultimo salvataggio (o caricamento) basta aggiungere al journal le operazioni effettuate nel frattempo
+    if (isJournalAttached() && journal.snapshotFile == filename && appendToJournal(filename)) {
+        return true;
+    }
+
+    // crea e apre il file di salvataggio in modalita' scrittura (su file temporaneo, che sostituisce il file di destinazione solo al 'commit')
+    QSaveFile file(filename);
     if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
 
         // errore di apertura file
@@ -437,18 +1205,47 @@ bool Library::saveToFile(const QString& filename) const {
         return false;
     }
 
-    // scrive su file l'oggetto JSON, con indentazione per maggior leggibilita'
-    file.write(doc.toJson(QJsonDocument::Indented));
+    // scrive i media uno alla volta, nello stesso formato di 'toJson' (indentato per maggior leggibilita', oppure compatto)
+    JsonStreamWriter writer(file, compact);
+    Visitors::JsonRecordEncoder encoder(writer);
+    writer.beginObject();
+    writer.writeKey("media");
+    writer.beginArray();
+    unsigned int mediaCount = getLibrarySize();
+    for (unsigned int i = 0; i < mediaCount; ++i) {
+        auto media = readMediaAt(i);
+        if (media) {
+            media->accept(encoder);
+        }
+        if (progress && (i + 1) % PROGRESS_STEP == 0) {
+            progress(i + 1, mediaCount);
+        }
+    }
+    if (progress) {
+        progress(mediaCount, mediaCount);
+    }
+    writer.endArray();
+    writer.endObject();
 
-    // chiusura del file
-    file.close();
+    // in caso di errore il file temporaneo viene scartato e il file di destinazione resta invariato
+    if (!writer.finish() || !file.commit()) {
+        logLibraryMessage("[LIBRARY - SAVE TO FILE] Error: Could not write file '" + filename.toStdString() + "'\n", Loggers::LogLevel::Error);
+        return false;
+    }
 
     // logga  il successo
     logLibraryMessage("[LIBRARY - SAVE TO FILE] Successfully saved library contents to file '" + filename.toStdString() + "'\n", Loggers::LogLevel::Info);
+
+    // le operazioni successive verranno salvate nel journal del file
+    resetJournal(filename);
     return true;
 }
 
-bool Library::loadFromFile(const QString& filename) {
+bool Library::loadFromFile(const QString& filename, unsigned int threadCount, const ProgressCallback& progress) {
+
+    // record letti prima di costruire i relativi media (eventualmente in parallelo)
+    static const unsigned int IMPORT_BLOCK_SIZE = 8192;
+
 
     logLibraryMessage("[LIBARY - LOAD FROM FILE] Attempting to read contents into library from file '" + filename.toStdString() + "'\n", Loggers::LogLevel::Info);
 
@@ -461,43 +1258,683 @@ bool Library::loadFromFile(const QString& filename) {
         return false;
     }
 
-    // legge tutti i contenuti del file in un QByteArray
-    QByteArray fileContents = file.readAll();
-    // chiude il file
-    file.close();
+    std::uint64_t fileSize = static_cast<std::uint64_t>(file.size());
+
+    // i media letti vengono tenuti da parte, e sostituiscono il contenuto della libreria solo se l'intero file e' un JSON valido
+    std::vector<std::shared_ptr<Media::AbstractMedia>> loadedMedia;
+    std::vector<std::string> loadErrors;
+    bool hasMediaArray = false;
+
+    try {
+        JsonStreamReader reader(file);
+        std::vector<JsonRecord> blockRecords;
+        std::vector<ImportRecord> blockInfo;
+        std::string key;
+
+        reader.skipByteOrderMark();
+        if (reader.peekValueType() != JsonStreamReader::ValueType::Object) {
+            throw std::runtime_error("JSON document is not an object\n");
+        }
+        reader.beginObject();
+        while (reader.nextObjectKey(key)) {
+
+            if (key != "media") {
+                reader.skipValue();
+                continue;
+            }
+
+            // come in QJsonObject, in caso di chiavi "media" duplicate vale l'ultima
+            loadedMedia.clear();
+            loadErrors.clear();
+            hasMediaArray = reader.peekValueType() == JsonStreamReader::ValueType::Array;
+            if (!hasMediaArray) {
+                reader.skipValue();
+                continue;
+            }
+
+            // scorre i media nell'array a blocchi: la lettura del file e' seriale, la costruzione dei media di un blocco puo' essere parallela
+            reader.beginArray();
+            bool moreRecords = reader.nextArrayValue();
+            while (moreRecords) {
+
+                blockInfo.clear();
+                while (moreRecords && blockInfo.size() < IMPORT_BLOCK_SIZE) {
+
+                    // i record (e la loro memoria) vengono riutilizzati da un blocco al successivo
+                    if (blockRecords.size() == blockInfo.size()) {
+                        blockRecords.emplace_back();
+                    }
+                    JsonRecord& record = blockRecords[blockInfo.size()];
+
+                    // un elemento che non e' un oggetto equivale a un oggetto vuoto (come 'toObject' in 'fromJson')
+                    if (reader.peekValueType() == JsonStreamReader::ValueType::Object) {
+                        record.readFrom(reader);
+                    }
+                    else {
+                        reader.skipValue();
+                        record.clear();
+                    }
+                    bool hasUniqueID = record.isDouble("uniqueID");
+                    blockInfo.push_back({ record.toString("mediaType"), hasUniqueID,
+                                          hasUniqueID ? static_cast<unsigned int>(record.toInt("uniqueID")) : 0 });
+                    moreRecords = reader.nextArrayValue();
+                }
 
-    // crea un QJsonDocument con il contenuto letto
-    QJsonDocument doc = QJsonDocument::fromJson(fileContents);
-    if (!doc.isObject()) {
+                // ogni media viene costruito direttamente dal proprio record
+                importRecords(blockInfo, [&blockRecords](unsigned int i, Media::AbstractMedia& media) {
+                    Visitors::JsonRecordDecoder decoder(blockRecords[i]);
+                    media.accept(decoder);
+                }, threadCount, loadedMedia, loadErrors);
+                if (progress) {
+                    progress(reader.getOffset(), fileSize);
+                }
+            }
+        }
+        reader.expectEnd();
+        if (progress) {
+            progress(fileSize, fileSize);
+        }
+    }
+    catch (const std::exception& e) {
         // segnala se il file non contiene un oggetto JSON valido
-        logLibraryMessage("[LIBRARY - LOAD FROM FILE] Error: File '" + filename.toStdString() + "' does not contain a valid JSON object\n", Loggers::LogLevel::Error);
+        logLibraryMessage("[LIBRARY - LOAD FROM FILE] Error: File '" + filename.toStdString() + "' does not contain a valid JSON object, " + std::string(e.what()), Loggers::LogLevel::Error);
         return false;
     }
+    file.close();
 
-    // recupera l'oggetto JSON principale
-    QJsonObject rootObject = doc.object();
+    // svuota la libreria attuale
+    mappedSnapshot.reset();
+    detachJournal();
+    libraryMedia.clear();
+    mediaIndexByID.clear();
+    searchIndex.clearIndex();
+    mediaColumns.clearColumns();
+    scoreCache.clear();
+
+    if (!hasMediaArray) {
+        logLibraryMessage("[LIBRARY - LOAD LIBRARY] JSON file does not contain a library!", Loggers::LogLevel::Error);
+    }
+    else {
+        for (const auto& error : loadErrors) {
+            logLibraryMessage(error, Loggers::LogLevel::Error);
+        }
+        libraryMedia = std::move(loadedMedia);
+        // ricostruisce l'indice degli identificatori una sola volta, a caricamento concluso
+        rebuildLibraryIndexes();
+        logLibraryMessage("[LIBRARY - LOAD LIBRARY] Successfully read " + std::to_string(libraryMedia.size()) + " media from JSON file into library\n", Loggers::LogLevel::Info);
+    }
 
-    // carica i media in libreria utilizzando il metodo 'fromJson'
-    fromJson(rootObject);
+    // applica le operazioni salvate dopo l'ultimo salvataggio completo del file
+    replayJournal(filename);
 
     logLibraryMessage("[LIBRARY - LOAD FROM FILE] Successfully loaded library contents from file '" + filename.toStdString() + "\n", Loggers::LogLevel::Debug);
     return true;
 }
 
+void Library::importRecords(const std::vector<ImportRecord>& records, const std::function<void(unsigned int, Media::AbstractMedia&)>& decode,
+                            unsigned int threadCount, std::vector<std::shared_ptr<Media::AbstractMedia>>& media, std::vector<std::string>& errors) const {
+
+    static const unsigned int MIN_RECORDS_PER_WORKER = 256;
+
+    const unsigned int count = records.size();
+    std::vector<std::shared_ptr<Media::AbstractMedia>> created(count);
+    std::vector<std::string> recordErrors(count);
+    std::atomic<bool> validationFailed(false);
+
+    // crea il media di un record (i messaggi di errore vengono conservati, e segnalati alla fine nell'ordine dei record)
+    auto importRecord = [&records, &decode, &created, &recordErrors, &validationFailed](unsigned int i) {
+        const std::string& mediaType = records[i].mediaType;
+        Model::Library::MediaFactory factory;
+        try {
+
+            // tenta di ricreare il tipo trovato utilizzando MediaFactory, usando mappa di attributi vuota
+            auto mediaPtr = factory.createMedia(mediaType, {});
+            if (mediaPtr) {
+                decode(i, *mediaPtr);
+                created[i] = mediaPtr;
+            }
+            else {
+                recordErrors[i] = "[LIBRARY - LOAD LIBRARY Error: MediaFactory error for media type '" + mediaType + "'\n";
+            }
+        }
+        catch (const Model::Visitors::MediaValidatorException& e) {
+            recordErrors[i] = "[LIBRARY - LOAD LIBRARY] Error: MediaValidator could not validate media of type '" + mediaType + "', " + std::string(e.what());
+            validationFailed = true;
+        }
+        catch (const std::exception& e) {
+            recordErrors[i] = "[LIBRARY - LOAD LIBRARY] Error: MediaFactory could not create media of type '" + mediaType + "', " + std::string(e.what());
+        }
+    };
+
+    unsigned int workers = getWorkerCount(count, MIN_RECORDS_PER_WORKER, threadCount);
+
+    // identificatori della costruzione seriale: ogni media creato consuma il valore del contatore, poi l'identificatore salvato lo aggiorna
+    std::vector<unsigned int> reservedIDs;
+    unsigned int nextUniqueID = Media::AbstractFile::uniqueIDCounter;
+    if (workers > 1) {
+        reservedIDs.assign(count, Media::AbstractFile::INVALID_UNIQUE_ID);
+        for (unsigned int i = 0; i < count; ++i) {
+            if (!MediaFactory::isSupportedType(records[i].mediaType)) continue;
+            reservedIDs[i] = nextUniqueID++;
+            // un identificatore non valido (contatore esaurito) fa fallire la validazione, e il record non aggiorna il contatore
+            if (reservedIDs[i] == Media::AbstractFile::INVALID_UNIQUE_ID) {
+                workers = 1;
+                break;
+            }
+            if (records[i].hasUniqueID && records[i].uniqueID > nextUniqueID) {
+                nextUniqueID = records[i].uniqueID;
+            }
+        }
+    }
+
+    if (workers > 1) {
+
+        // ogni worker crea i media di un blocco contiguo, con gli identificatori riservati (il contatore statico non viene usato)
+        runInChunks(count, workers, [&importRecord, &reservedIDs](unsigned int, unsigned int first, unsigned int last) {
+            for (unsigned int i = first; i < last; ++i) {
+                Media::AbstractFile::ReservedUniqueID reserve(reservedIDs[i]);
+                importRecord(i);
+            }
+        });
+
+        if (validationFailed) {
+            // la simulazione del contatore presuppone che ogni media creato sia valido: in caso contrario si ripete la costruzione in modo seriale
+            logLibraryMessage("[LIBRARY - LOAD LIBRARY] Media validation failed during parallel load, loading " + std::to_string(count) + " records serially\n", Loggers::LogLevel::Debug);
+            created.assign(count, nullptr);
+            recordErrors.assign(count, std::string());
+            workers = 1;
+        }
+        else {
+            Media::AbstractFile::uniqueIDCounter = nextUniqueID;
+            logLibraryMessage("[LIBRARY - LOAD LIBRARY] Parallel load of " + std::to_string(count) + " records with " + std::to_string(workers) + " workers\n", Loggers::LogLevel::Debug);
+        }
+    }
+
+    if (workers <= 1) {
+        for (unsigned int i = 0; i < count; ++i) {
+            importRecord(i);
+        }
+    }
+
+    for (unsigned int i = 0; i < count; ++i) {
+        if (!recordErrors[i].empty()) {
+            errors.push_back(std::move(recordErrors[i]));
+        }
+        if (created[i]) {
+            media.push_back(std::move(created[i]));
+        }
+    }
+}
+
+
+// === SNAPSHOT BINARIO ===
+
+bool Library::saveBinary(const QString& filename) const {
+
+    logLibraryMessage("[LIBRARY - SAVE BINARY] Saving library snapshot to file '" + filename.toStdString() + "'\n", Loggers::LogLevel::Info);
+
+    // un file mappato non viene mai modificato (ogni modifica materializza i media), il suo contenuto puo' essere copiato cosi' com'e'
+    std::string snapshot = mappedSnapshot ? std::string(mappedSnapshot->getMappedData(), mappedSnapshot->getMappedSize())
+                                          : BinarySnapshot::encode(libraryMedia);
+
+    // scrittura su file temporaneo, che sostituisce il file di destinazione solo al 'commit'
+    QSaveFile file(filename);
+    if (!file.open(QIODevice::WriteOnly)) {
+        logLibraryMessage("[LIBRARY - SAVE BINARY] Error: Could not open file '" + filename.toStdString() + "'\n", Loggers::LogLevel::Error);
+        return false;
+    }
+    if (file.write(snapshot.data(), static_cast<qint64>(snapshot.size())) != static_cast<qint64>(snapshot.size()) || !file.commit()) {
+        logLibraryMessage("[LIBRARY - SAVE BINARY] Error: Could not write file '" + filename.toStdString() + "'\n", Loggers::LogLevel::Error);
+        return false;
+    }
+
+    logLibraryMessage("[LIBRARY - SAVE BINARY] Successfully saved " + std::to_string(getLibrarySize()) + " media (" +
+        std::to_string(snapshot.size()) + " bytes) to file '" + filename.toStdString() + "'\n", Loggers::LogLevel::Info);
+    return true;
+}
+
+bool Library::loadBinary(const QString& filename) {
+
+    logLibraryMessage("[LIBRARY - LOAD BINARY] Attempting to read library snapshot from file '" + filename.toStdString() + "'\n", Loggers::LogLevel::Info);
+
+    QFile file(filename);
+    if (!file.open(QIODevice::ReadOnly)) {
+        logLibraryMessage("[LIBRARY - LOAD BINARY] Error: Could not open file '" + filename.toStdString() + "'\n", Loggers::LogLevel::Error);
+        return false;
+    }
+    QByteArray fileContents = file.readAll();
+    file.close();
+
+    std::vector<std::shared_ptr<Media::AbstractMedia>> loaded;
+    unsigned int skippedRecords = 0;
+    try {
+        loaded = BinarySnapshot::decode(fileContents.constData(), static_cast<std::size_t>(fileContents.size()), skippedRecords);
+    }
+    catch (const std::exception& e) {
+        logLibraryMessage("[LIBRARY - LOAD BINARY] Error: File '" + filename.toStdString() + "' is not a valid library snapshot, " +
+            std::string(e.what()), Loggers::LogLevel::Error);
+        return false;
+    }
+    if (skippedRecords > 0) {
+        logLibraryMessage("[LIBRARY - LOAD BINARY] Skipped " + std::to_string(skippedRecords) + " records of unknown media type\n", Loggers::LogLevel::Error);
+    }
+
+    // come nel caricamento da JSON, i media non validi (file corrotto o modificato) vengono scartati
+    std::size_t validCount = 0;
+    for (auto& media : loaded) {
+        try {
+            Visitors::MediaValidator validator;
+            media->accept(validator);
+            loaded[validCount++] = std::move(media);
+        }
+        catch (const Visitors::MediaValidatorException& e) {
+            logLibraryMessage("[LIBRARY - LOAD LIBRARY] Error: MediaValidator could not validate media '" + media->getMediaName() + "', " +
+                std::string(e.what()), Loggers::LogLevel::Error);
+        }
+    }
+    loaded.resize(validCount);
+
+    // sostituisce i contenuti della libreria e ricostruisce gli indici una sola volta
+    detachJournal();
+    libraryMedia = std::move(loaded);
+    rebuildLibraryIndexes();
+
+    logLibraryMessage("[LIBRARY - LOAD BINARY] Successfully loaded " + std::to_string(getLibrarySize()) + " media from file '" +
+        filename.toStdString() + "'\n", Loggers::LogLevel::Info);
+    return true;
+}
+
+
+// === FILE MAPPATO ===
+
+bool Library::openMapped(const QString& filename) {
+
+    logLibraryMessage("[LIBRARY - OPEN MAPPED] Attempting to map library snapshot file '" + filename.toStdString() + "'\n", Loggers::LogLevel::Info);
+
+    auto snapshot = std::make_unique<MappedSnapshot>();
+    try {
+        snapshot->open(filename);
+    }
+    catch (const std::exception& e) {
+        logLibraryMessage("[LIBRARY - OPEN MAPPED] Error: Could not map file '" + filename.toStdString() + "', " + std::string(e.what()), Loggers::LogLevel::Error);
+        return false;
+    }
+    if (snapshot->getSkippedRecordCount() > 0) {
+        logLibraryMessage("[LIBRARY - OPEN MAPPED] Skipped " + std::to_string(snapshot->getSkippedRecordCount()) + " records of unknown media type\n", Loggers::LogLevel::Error);
+    }
+
+    // sostituisce i contenuti della libreria: gli indici restano vuoti finche' i media non vengono materializzati
+    detachJournal();
+    libraryMedia.clear();
+    rebuildLibraryIndexes();
+    mappedSnapshot = std::move(snapshot);
+
+    logLibraryMessage("[LIBRARY - OPEN MAPPED] Successfully mapped " + std::to_string(getLibrarySize()) + " media (" +
+        std::to_string(mappedSnapshot->getMappedSize()) + " bytes) from file '" + filename.toStdString() + "'\n", Loggers::LogLevel::Info);
+    return true;
+}
+
+bool Library::isMapped() const { return mappedSnapshot != nullptr; }
+
 
 // METODI AUSILIARI
 
 bool Library::checkDuplicateID(unsigned int id) const {
 
-    for (const auto& media : libraryMedia) {
-        if (media) {
-            if (media->getUniqueID() == id) {
-                return true;
+    return mediaIndexByID.find(id) != mediaIndexByID.end();
+}
+
+unsigned int Library::getWorkerCount(unsigned int count, unsigned int minPerWorker, unsigned int threadCount) {
+
+    // sotto la soglia di elementi per worker il costo di creazione dei thread supera il guadagno
+    return std::min(threadCount, count / minPerWorker);
+}
+
+void Library::runInChunks(unsigned int count, unsigned int workers, const std::function<void(unsigned int, unsigned int, unsigned int)>& range) {
+
+    if (workers <= 1) {
+        range(0, 0, count);
+        return;
+    }
+
+    std::vector<std::thread> threads;
+    threads.reserve(workers - 1);
+    const unsigned int chunk = (count + workers - 1) / workers;
+    for (unsigned int w = 1; w < workers; ++w) {
+        unsigned int first = std::min(count, w * chunk);
+        unsigned int last = std::min(count, first + chunk);
+        threads.emplace_back(range, w, first, last);
+    }
+    // il primo blocco viene eseguito dal thread chiamante
+    range(0, 0, std::min(count, chunk));
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+void Library::rebuildLibraryIndexes() {
+
+    mappedSnapshot.reset();
+    mediaIndexByID.clear();
+    mediaIndexByID.reserve(libraryMedia.size());
+    searchIndex.clearIndex();
+    scoreCache.clear();
+    for (unsigned int i = 0; i < libraryMedia.size(); ++i) {
+        if (libraryMedia[i]) {
+            // in caso di identificatori duplicati vale la prima occorrenza (come nella ricerca lineare)
+            if (mediaIndexByID.emplace(libraryMedia[i]->getUniqueID(), i).second) {
+                searchIndex.insertMedia(*libraryMedia[i]);
             }
         }
     }
-    return false;
+    if (columnSnapshotEnabled) {
+        mediaColumns.rebuildColumns(libraryMedia);
+    }
+}
+
+const Library::ScoreEntry* Library::getScoreEntry(unsigned int id) const {
+
+    auto cached = scoreCache.find(id);
+    if (cached != scoreCache.end()) {
+        return &cached->second;
+    }
+
+    auto media = getMediaByID(id);
+    if (!media) {
+        return nullptr;
+    }
+    Visitors::ScoreVisitor scoring;
+    media->accept(scoring);
+    auto inserted = scoreCache.emplace(id, ScoreEntry{ scoring.getScoreValue(), scoring.getScoreLabel(), scoring.getScoreInfo() });
+    return &inserted.first->second;
+}
+
+void Library::scorePositions(const std::vector<unsigned int>& positions, std::vector<float>& scores) const {
+
+    scores.assign(positions.size(), Visitors::ScoreVisitor::SCORE_UNKNOWN);
+
+    // indici (in 'positions') dei media senza score nella cache
+    std::vector<unsigned int> pending;
+    for (unsigned int i = 0; i < positions.size(); ++i) {
+        auto cached = scoreCache.find(getUniqueIDAt(positions[i]));
+        if (cached != scoreCache.end()) {
+            scores[i] = cached->second.value;
+        }
+        else {
+            pending.push_back(i);
+        }
+    }
+    if (pending.empty()) return;
+
+    if (columnSnapshotEnabled && !mappedSnapshot) {
+        unsigned int firstPos = positions[pending.front()];
+        unsigned int lastPos = positions[pending.back()] + 1;
+        // posizioni (quasi) contigue: un solo passaggio dei kernel sull'intero intervallo
+        if (lastPos - firstPos <= 4 * pending.size()) {
+            std::vector<float> rangeScores(lastPos - firstPos);
+            mediaColumns.scoreRows(firstPos, lastPos, rangeScores.data());
+            for (unsigned int i : pending) {
+                scores[i] = rangeScores[positions[i] - firstPos];
+            }
+        }
+        else {
+            for (unsigned int i : pending) {
+                mediaColumns.scoreRows(positions[i], positions[i] + 1, &scores[i]);
+            }
+        }
+    }
+    else {
+        // senza snapshot vengono lette le colonne dei soli media da calcolare
+        MediaColumns pendingColumns;
+        std::vector<unsigned int> pendingRows;
+        for (unsigned int i : pending) {
+            auto media = readMediaAt(positions[i]);
+            if (media) {
+                pendingColumns.appendRow(*media);
+                pendingRows.push_back(i);
+            }
+        }
+        std::vector<float> pendingScores(pendingRows.size());
+        pendingColumns.scoreRows(0, pendingColumns.getRowCount(), pendingScores.data());
+        for (unsigned int j = 0; j < pendingRows.size(); ++j) {
+            scores[pendingRows[j]] = pendingScores[j];
+        }
+    }
+}
+
+void Library::detachMappedSnapshot() {
+
+    if (!mappedSnapshot) return;
+
+    std::vector<std::shared_ptr<Media::AbstractMedia>> media;
+    media.reserve(mappedSnapshot->getRecordCount());
+    unsigned int invalidRecords = 0;
+    for (unsigned int i = 0; i < mappedSnapshot->getRecordCount(); ++i) {
+        try {
+            media.push_back(mappedSnapshot->getMediaAt(i));
+        }
+        catch (const std::runtime_error&) {
+            // i record troncati o non validi non possono essere materializzati e vengono scartati
+            ++invalidRecords;
+        }
+    }
+    if (invalidRecords > 0) {
+        logLibraryMessage("[LIBRARY - DETACH MAPPED] Discarded " + std::to_string(invalidRecords) + " invalid records\n", Loggers::LogLevel::Error);
+    }
+
+    // i media gia' materializzati restano gli stessi oggetti, i puntatori gia' restituiti restano validi
+    libraryMedia = std::move(media);
+    rebuildLibraryIndexes();
+    logLibraryMessage("[LIBRARY - DETACH MAPPED] Materialized " + std::to_string(libraryMedia.size()) + " media, released mapped file\n", Loggers::LogLevel::Info);
+}
+
+std::shared_ptr<Media::AbstractMedia> Library::readMediaAt(unsigned int pos) const {
+
+    if (!mappedSnapshot) {
+        return libraryMedia[pos];
+    }
+    try {
+        return mappedSnapshot->decodeMediaAt(pos);
+    }
+    catch (const std::runtime_error& e) {
+        logLibraryMessage("[LIBRARY - READ MAPPED] Could not read mapped media at index " + std::to_string(pos) + ": " + std::string(e.what()), Loggers::LogLevel::Error);
+        return nullptr;
+    }
+}
+
+unsigned int Library::getUniqueIDAt(unsigned int pos) const {
+
+    return mappedSnapshot ? mappedSnapshot->getUniqueIDAt(pos) : libraryMedia[pos]->getUniqueID();
+}
+
+void Library::updateMediaIndexFrom(unsigned int pos) {
+
+    for (unsigned int i = pos; i < libraryMedia.size(); ++i) {
+        if (libraryMedia[i]) {
+            mediaIndexByID[libraryMedia[i]->getUniqueID()] = i;
+        }
+    }
+}
+
+bool Library::isJournalAttached() const { return !journal.snapshotFile.isEmpty(); }
+
+void Library::detachJournal() const { journal = JournalState(); }
+
+bool Library::appendToJournal(const QString& filename) const {
+
+    QString journalFile = LibraryJournal::journalFileName(filename);
+    if (!QFile::exists(journalFile)) {
+        logLibraryMessage("[LIBRARY - JOURNAL] Journal of file '" + filename.toStdString() + "' is missing, saving full library\n", Loggers::LogLevel::Error);
+        return false;
+    }
+    if (journal.pendingRecords.empty()) {
+        logLibraryMessage("[LIBRARY - JOURNAL] No changes to save to file '" + filename.toStdString() + "'\n", Loggers::LogLevel::Info);
+        return true;
+    }
+
+    // compattazione: oltre la soglia conviene riscrivere il file JSON, il journal riparte vuoto
+    if (journal.journalSize + journal.pendingRecords.size() > journal.snapshotSize / LibraryJournal::COMPACTION_RATIO) {
+        logLibraryMessage("[LIBRARY - JOURNAL] Compacting journal of file '" + filename.toStdString() + "'\n", Loggers::LogLevel::Debug);
+        return false;
+    }
+
+    QFile file(journalFile);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Append)) {
+        logLibraryMessage("[LIBRARY - JOURNAL] Error: Could not open journal '" + journalFile.toStdString() + "'\n", Loggers::LogLevel::Error);
+        return false;
+    }
+    qint64 pendingSize = static_cast<qint64>(journal.pendingRecords.size());
+    bool written = file.write(journal.pendingRecords.data(), pendingSize) == pendingSize && file.flush();
+    file.close();
+    if (!written) {
+        // un record scritto solo in parte terminerebbe il journal, facendo ignorare i record aggiunti in seguito
+        QFile::resize(journalFile, static_cast<qint64>(journal.journalSize));
+        logLibraryMessage("[LIBRARY - JOURNAL] Error: Could not write journal '" + journalFile.toStdString() + "'\n", Loggers::LogLevel::Error);
+        return false;
+    }
+
+    journal.journalSize += journal.pendingRecords.size();
+    journal.pendingRecords.clear();
+    logLibraryMessage("[LIBRARY - JOURNAL] Saved " + std::to_string(pendingSize) + " bytes of changes to journal '" +
+        journalFile.toStdString() + "'\n", Loggers::LogLevel::Info);
+    return true;
+}
+
+void Library::resetJournal(const QString& filename) const {
+
+    detachJournal();
+    QString journalFile = LibraryJournal::journalFileName(filename);
+
+    // l'intestazione lega il journal al contenuto del file appena salvato
+    LibraryJournal::SnapshotInfo info;
+    info.mediaCount = getLibrarySize();
+    std::string header;
+    bool written = false;
+    if (LibraryJournal::readSnapshotInfo(filename, info)) {
+        header = LibraryJournal::encodeHeader(info);
+        QSaveFile file(journalFile);
+        written = file.open(QIODevice::WriteOnly) &&
+                  file.write(header.data(), static_cast<qint64>(header.size())) == static_cast<qint64>(header.size()) && file.commit();
+    }
+    if (!written) {
+        // un journal precedente non si riferisce piu' al file salvato
+        QFile::remove(journalFile);
+        logLibraryMessage("[LIBRARY - JOURNAL] Error: Could not create journal '" + journalFile.toStdString() + "'\n", Loggers::LogLevel::Error);
+        return;
+    }
+
+    journal.snapshotFile = filename;
+    journal.snapshotSize = info.size;
+    journal.journalSize = header.size();
+}
+
+void Library::replayJournal(const QString& filename) {
+
+    QString journalFile = LibraryJournal::journalFileName(filename);
+    if (!QFile::exists(journalFile)) {
+        return;
+    }
+    QFile file(journalFile);
+    if (!file.open(QIODevice::ReadOnly)) {
+        logLibraryMessage("[LIBRARY - JOURNAL] Error: Could not open journal '" + journalFile.toStdString() + "'\n", Loggers::LogLevel::Error);
+        return;
+    }
+    QByteArray contents = file.readAll();
+    file.close();
+    const char* data = contents.constData();
+    std::size_t size = static_cast<std::size_t>(contents.size());
+
+    // un journal scritto per un contenuto diverso del file (ad esempio sostituito dopo il salvataggio) viene ignorato
+    LibraryJournal::SnapshotInfo header;
+    LibraryJournal::SnapshotInfo current;
+    if (!LibraryJournal::decodeHeader(data, size, header) || !LibraryJournal::readSnapshotInfo(filename, current) ||
+        header.size != current.size || header.checksum != current.checksum || header.mediaCount != getLibrarySize()) {
+        logLibraryMessage("[LIBRARY - JOURNAL] Error: Journal '" + journalFile.toStdString() + "' does not match file '" +
+            filename.toStdString() + "', ignored\n", Loggers::LogLevel::Error);
+        return;
+    }
+
+    // le operazioni vengono applicate in ordine, senza essere registrate (la libreria non e' ancora associata al journal)
+    // e senza notificare l'osservatore, che considera il caricamento come un'unica sostituzione del contenuto
+    std::size_t offset = LibraryJournal::FILE_HEADER_SIZE;
+    unsigned int replayed = 0;
+    LibraryJournal::Operation operation;
+    ILibraryObserver* observer = libraryObserver;
+    libraryObserver = nullptr;
+    while (offset < size) {
+        std::size_t recordSize = LibraryJournal::decodeOperation(data + offset, size - offset, operation);
+        if (recordSize == 0 || !applyJournalOperation(operation)) {
+            break;
+        }
+        offset += recordSize;
+        ++replayed;
+    }
+    libraryObserver = observer;
+
+    // coda incompleta (ad esempio per un'interruzione durante la scrittura): viene eliminata, per poter aggiungere nuovi record
+    if (offset < size) {
+        if (!QFile::resize(journalFile, static_cast<qint64>(offset))) {
+            logLibraryMessage("[LIBRARY - JOURNAL] Error: Could not truncate journal '" + journalFile.toStdString() + "'\n", Loggers::LogLevel::Error);
+            return;
+        }
+        logLibraryMessage("[LIBRARY - JOURNAL] Discarded " + std::to_string(size - offset) + " bytes of invalid records from journal '" +
+            journalFile.toStdString() + "'\n", Loggers::LogLevel::Error);
+    }
 
+    journal.snapshotFile = filename;
+    journal.snapshotSize = current.size;
+    journal.journalSize = offset;
+    logLibraryMessage("[LIBRARY - JOURNAL] Replayed " + std::to_string(replayed) + " changes from journal '" + journalFile.toStdString() + "'\n",
+        Loggers::LogLevel::Info);
+}
+
+bool Library::applyJournalOperation(const LibraryJournal::Operation& operation) {
+
+    unsigned int sizeBefore = getLibrarySize();
+    switch (operation.type) {
+
+    case LibraryJournal::OperationType::Insert:
+        return insertLibraryMediaAt(operation.media, sizeBefore);
+
+    case LibraryJournal::OperationType::InsertAt:
+        return operation.position <= sizeBefore && insertLibraryMediaAt(operation.media, operation.position);
+
+    case LibraryJournal::OperationType::Remove:
+        return operation.position < sizeBefore && removeLibraryMediaByID(getUniqueIDAt(operation.position));
+
+    case LibraryJournal::OperationType::RemoveMultiple: {
+        std::vector<unsigned int> ids;
+        ids.reserve(operation.positions.size());
+        for (std::uint32_t pos : operation.positions) {
+            if (pos >= sizeBefore) return false;
+            ids.push_back(getUniqueIDAt(pos));
+        }
+        return removeLibraryMediaByIDs(ids) == operation.positions.size();
+    }
+
+    case LibraryJournal::OperationType::InsertMultipleAt: {
+        std::vector<PositionedMedia> media;
+        media.reserve(operation.positions.size());
+        for (std::size_t i = 0; i < operation.positions.size(); ++i) {
+            media.emplace_back(operation.positions[i], operation.multipleMedia[i]);
+        }
+        return insertLibraryMediaAtPositions(media);
+    }
+
+    case LibraryJournal::OperationType::Edit:
+        if (operation.position >= sizeBefore) {
+            return false;
+        }
+        try {
+            return editLibraryMediaByID(getUniqueIDAt(operation.position), operation.edits);
+        }
+        catch (const Visitors::MediaValidatorException&) {
+            // gia' segnalato da 'editLibraryMediaByID'
+            return false;
+        }
+    }
+    return false;
 }
 
 }
@@ -5,11 +5,19 @@
 #include "Model/Loggers/IMediaLogger.h"
 #include "Model/Loggers/LogLevel.h"
 #include "Model/Library/SearchQuery.h"
+#include "Model/Library/SearchIndex.h"
+#include "Model/Library/MediaColumns.h"
+#include "Model/Library/MappedSnapshot.h"
+#include "Model/Library/LibraryJournal.h"
+#include "Model/Library/ILibraryObserver.h"
 
 #include <string>
 #include <vector>
 #include <unordered_map>
 #include <memory>
+#include <functional>
+#include <cstdint>
+#include <atomic>
 
 #include <QJsonObject>
 #include <QJsonArray>
@@ -35,11 +43,31 @@
 namespace Model {
 namespace Library {
 
+namespace Command {
+class RemoveCommand;
+class BulkRemoveCommand;
+}
+
 
 class Library {
 
+    // l'annullamento di una rimozione reinserisce media gia' validati, senza validarli di nuovo
+    friend class Command::RemoveCommand;
+    friend class Command::BulkRemoveCommand;
+
 public:
 
+    /**
+     * @brief ProgressCallback : notifica dell'avanzamento di un salvataggio o caricamento (chiamata dal thread che lo esegue)
+     * @param processed : quantita' gia' elaborata
+     * @param total : quantita' totale
+     */
+    using ProgressCallback = std::function<void(std::uint64_t processed, std::uint64_t total)>;
+
+    /** @brief PositionedMedia : media con la sua posizione in libreria (ad esempio un media rimosso, da reinserire nella stessa posizione) */
+    using PositionedMedia = std::pair<unsigned int, std::shared_ptr<Media::AbstractMedia>>;
+
+
     // === COSTRUTTORE ===
 
     /**
@@ -83,6 +111,38 @@ public:
     void logLibraryMessage(const std::string& msg, Loggers::LogLevel lvl = Loggers::LogLevel::Info) const;
 
 
+    // === OSSERVATORE ===
+
+    /**
+     * @brief setLibraryObserver : associa alla libreria un osservatore, notificato dopo ogni inserimento, rimozione o modifica di un media
+     * @param observer : osservatore da associare (non posseduto dalla libreria, 'nullptr' per nessun osservatore)
+     */
+    void setLibraryObserver(ILibraryObserver* observer);
+
+    /**
+     * @brief getLibraryObserver : restituisce l'osservatore associato alla libreria
+     * @return ILibraryObserver* : puntatore all'osservatore associato, altrimenti 'nullptr'
+     */
+    ILibraryObserver* getLibraryObserver() const;
+
+    /**
+     * @brief beginBatchUpdate : inizia un aggiornamento in blocco (le chiamate possono essere annidate). Fino al corrispondente 'endBatchUpdate'
+     *                           l'osservatore non riceve notifiche per i singoli media e vengono registrati solo i messaggi di errore
+     */
+    void beginBatchUpdate();
+
+    /**
+     * @brief endBatchUpdate : termina un aggiornamento in blocco, notificando l'osservatore con 'onMediaBatchChanged' se almeno un media e' cambiato
+     */
+    void endBatchUpdate();
+
+    /**
+     * @brief isBatchUpdating : verifica se e' in corso un aggiornamento in blocco
+     * @return bool : true se e' in corso un aggiornamento in blocco, false altrimenti
+     */
+    bool isBatchUpdating() const;
+
+
     // === HELPER ===
 
     /**
@@ -100,9 +160,17 @@ public:
     /**
      * @brief getAllLibraryMedia : restituisce tutti i media attualmente presenti nella libreria
      * @return const std::vector& : vettore di smart pointer di tipo std::shared_ptr ai media attualmente in libreria
+     * @details con un file mappato (vedi 'openMapped') i media non sono ancora in memoria e il vettore e' vuoto: usare 'getMediaAtIndex'
      */
     const std::vector<std::shared_ptr<Media::AbstractMedia>>& getAllLibraryMedia() const;
 
+    /**
+     * @brief getMediaAtIndex : restituisce il media in una data posizione della libreria (materializzandolo se la libreria e' mappata)
+     * @param ind : posizione del media
+     * @return std::shared_ptr<AbstractMedia> : smart pointer al media, altrimenti 'nullptr'
+     */
+    std::shared_ptr<Media::AbstractMedia> getMediaAtIndex(unsigned int ind) const;
+
 
     // === INSERIMENTO ===
 
@@ -112,6 +180,21 @@ public:
      */
     void insertLibraryMedia(const std::shared_ptr<Media::AbstractMedia> media);
 
+    /**
+     * @brief insertLibraryMediaAt : inserisce un media gia' esistente in una data posizione della libreria (i media successivi scalano di uno)
+     * @param media : smart pointer al media da aggiungere
+     * @param pos : posizione del media inserito (se non valida, il media viene inserito in fondo)
+     * @return bool : true se il media viene inserito con successo, false altrimenti
+     */
+    bool insertLibraryMediaAt(const std::shared_ptr<Media::AbstractMedia> media, unsigned int pos);
+
+    /**
+     * @brief insertLibraryMediaAtPositions : inserisce piu' media gia' esistenti nelle rispettive posizioni, spostando ogni media della libreria una sola volta
+     * @param media : coppie (posizione finale, media), in ordine strettamente crescente di posizione (ad esempio i media rimossi da 'removeLibraryMediaByIDs')
+     * @return bool : true se tutti i media vengono inseriti, false se almeno uno non e' valido (in tal caso non ne viene inserito nessuno)
+     */
+    bool insertLibraryMediaAtPositions(const std::vector<PositionedMedia>& media);
+
 
     // === RIMOZIONE ===
 
@@ -122,11 +205,28 @@ public:
      */
     bool removeLibraryMediaByID(unsigned int id);
 
+    /**
+     * @brief removeLibraryMediaByIDs : rimuove piu' media con un'unica compattazione stabile della libreria (l'ordine dei media rimanenti non cambia)
+     * @param ids : identificatori univoci dei media da rimuovere (quelli non presenti vengono ignorati)
+     * @param removed : se non nullo, riceve le coppie (posizione prima della rimozione, media) dei media rimossi, in ordine crescente di posizione
+     * @return unsigned int : numero di media rimossi
+     * @details indici, colonne e journal vengono aggiornati una sola volta, e l'osservatore riceve un'unica notifica
+     */
+    unsigned int removeLibraryMediaByIDs(const std::vector<unsigned int>& ids, std::vector<PositionedMedia>* removed = nullptr);
+
     /**
      * @brief clearLibrary : rimuove tutti i media della libreria
      */
     void clearLibrary();
 
+    /**
+     * @brief takeContents : sostituisce i contenuti della libreria (media, indici, cache, journal) con quelli di un'altra libreria, che resta vuota
+     * @param other : libreria da cui prendere i contenuti (ad esempio caricata da un thread secondario)
+     * @details i media e gli indici vengono spostati e non ricostruiti (lo snapshot colonnare solo se le due librerie hanno impostazioni diverse).
+     *          Logger e livello di logging della libreria restano invariati
+     */
+    void takeContents(Library& other);
+
 
     // === MODIFICA ===
 
@@ -139,6 +239,21 @@ public:
      */
     bool editLibraryMediaByID(unsigned int id, const std::unordered_map<std::string, std::string>& mediaEdits);
 
+    /**
+     * @brief editLibraryMediaByIDs : modifica piu' media in base ai loro identificatori univoci, applicando le modifiche in parallelo
+     * @param ids : identificatori univoci dei media da modificare (senza ripetizioni)
+     * @param mediaEdits : mappe delle modifiche, una sola (applicata a tutti i media) oppure una per ogni identificatore
+     * @param threadCount : numero massimo di thread da utilizzare per la modifica dei media (1 per la modifica seriale)
+     * @param previousValues : se non nullo, riceve per ogni identificatore i valori precedenti dei soli campi cambiati (vuoto se il media non e' cambiato)
+     * @return std::vector<std::string> : per ogni identificatore, il messaggio d'errore della modifica (vuoto se la modifica ha avuto successo)
+     * @details un media la cui modifica fallisce resta invariato, gli altri vengono modificati comunque. Le modifiche sono un aggiornamento
+     *          in blocco ('beginBatchUpdate'), per cui l'osservatore riceve un'unica notifica al termine
+     */
+    std::vector<std::string> editLibraryMediaByIDs(const std::vector<unsigned int>& ids,
+                                                   const std::vector<std::unordered_map<std::string, std::string>>& mediaEdits,
+                                                   unsigned int threadCount = 1,
+                                                   std::vector<std::unordered_map<std::string, std::string>>* previousValues = nullptr);
+
 
     // === VISUALIZZAZIONE (Utilizzati per debugging) ===
 
@@ -176,9 +291,25 @@ public:
     /**
      * @brief searchLibrary : effettua una ricerca con filtri (tramite lo struct SearchQuery) sui media attualmente in libreria
      * @param query : filtri con cui effettuare la ricerca
+     * @param threadCount : numero massimo di thread da utilizzare per la verifica dei media (1 per la ricerca seriale)
+     * @param cancelled : flag di annullamento (opzionale), se impostato durante la ricerca questa si interrompe restituendo risultati parziali
      * @return std::vector : vettore contenente gli identificatori univoci dei media trovati nella ricerca (puo' essere vuoto)
+     * @details i risultati, e il loro ordine (quello della libreria), non dipendono dal numero di thread
+     */
+    std::vector<unsigned int> searchLibrary(const SearchQuery& query, unsigned int threadCount = 1, const std::atomic<bool>* cancelled = nullptr) const;
+
+    /**
+     * @brief narrowSearchResults : ripete una ricerca solo sui risultati di una ricerca precedente, invece che sull'intera libreria
+     * @param query : filtri con cui effettuare la ricerca
+     * @param previousIDs : identificatori univoci trovati dalla ricerca precedente
+     * @param threadCount : numero massimo di thread da utilizzare per la verifica dei media (1 per la ricerca seriale)
+     * @param cancelled : flag di annullamento (opzionale), come in 'searchLibrary'
+     * @return std::vector : identificatori univoci dei media trovati, nell'ordine della libreria
+     * @details corretto solo se 'query' e' piu' restrittiva della ricerca precedente (ad esempio un nome che contiene il nome cercato prima),
+     *          e se la libreria non e' stata modificata nel frattempo
      */
-    std::vector<unsigned int> searchLibrary(const SearchQuery& query) const;
+    std::vector<unsigned int> narrowSearchResults(const SearchQuery& query, const std::vector<unsigned int>& previousIDs, unsigned int threadCount = 1,
+                                                  const std::atomic<bool>* cancelled = nullptr) const;
 
 
     // === FETCH ===
@@ -190,9 +321,50 @@ public:
      */
     std::shared_ptr<Media::AbstractMedia> getMediaByID(unsigned int id) const;
 
+    /**
+     * @brief getMediaIndexByID : restituisce la posizione di un media nella libreria in base al suo identificatore univoco (in tempo costante)
+     * @param id : identificatore univoco del media
+     * @return unsigned int : posizione del media nella libreria, altrimenti il numero di media attualmente in libreria
+     */
+    unsigned int getMediaIndexByID(unsigned int id) const;
+
+
+    // === SNAPSHOT COLONNARE ===
+
+    /**
+     * @brief setColumnSnapshotEnabled : attiva o disattiva lo snapshot colonnare (MediaColumns) della libreria
+     * @param enabled : true per costruire lo snapshot e mantenerlo aggiornato ad ogni modifica, false per liberarlo
+     */
+    void setColumnSnapshotEnabled(bool enabled);
+
+    /**
+     * @brief isColumnSnapshotEnabled : verifica se lo snapshot colonnare e' attivo
+     * @return bool : true se attivo, false altrimenti
+     */
+    bool isColumnSnapshotEnabled() const;
+
+    /**
+     * @brief getColumnSnapshot : restituisce lo snapshot colonnare (vuoto se non attivo), con righe nell'ordine della libreria
+     * @return const MediaColumns& : riferimento costante allo snapshot
+     */
+    const MediaColumns& getColumnSnapshot() const;
+
 
     // === SCORING VISITOR ===
 
+    // Gli score vengono calcolati una sola volta per media (valore, label e info insieme) e salvati in una cache per identificatore univoco,
+    // invalidata ad ogni modifica o rimozione del media. La cache non e' protetta da accessi concorrenti.
+
+    /**
+     * @brief precomputeLibraryScores : calcola in blocco gli score di tutti i media non ancora presenti nella cache
+     */
+    void precomputeLibraryScores() const;
+
+    /**
+     * @brief clearScoreCache : svuota la cache degli score (verranno ricalcolati alla prossima richiesta)
+     */
+    void clearScoreCache();
+
     /**
      * @brief getMediaScoreValueByID : restituisce lo score numerico del media in base al suo identificatore univoco
      * @param id : identificatore univoco del media
@@ -214,6 +386,32 @@ public:
      */
     std::string getMediaScoreInfoByID(unsigned int id) const;
 
+    /**
+     * @brief scoreAll : calcola in blocco lo score numerico di tutti i media della libreria (tramite i kernel di ScoreKernels)
+     * @return std::vector<float> : score (0-100) dei media, nell'ordine della libreria
+     */
+    std::vector<float> scoreAll() const;
+
+    /**
+     * @brief scoreRange : calcola in blocco lo score numerico dei media in un intervallo di posizioni
+     * @param first : prima posizione
+     * @param last : posizione successiva all'ultima (limitata alla dimensione della libreria)
+     * @return std::vector<float> : score (0-100) dei media, l'elemento 'i' corrisponde alla posizione 'first + i'
+     * @details usa lo snapshot colonnare se attivo, altrimenti legge le colonne necessarie per il solo intervallo richiesto.
+     *          Gli score sono gli stessi di ScoreVisitor, ma non vengono calcolati label e info e non viene usata la cache degli score.
+     */
+    std::vector<float> scoreRange(unsigned int first, unsigned int last) const;
+
+    /**
+     * @brief getTopScoredMedia : restituisce i 'k' media con score numerico piu' alto, eventualmente tra quelli trovati da una ricerca
+     * @param k : numero massimo di media da restituire
+     * @param query : filtri di ricerca (se nessun filtro e' impostato vengono considerati tutti i media)
+     * @return std::vector<unsigned int> : identificatori univoci dei media, in ordine di score decrescente (a parita' di score, nell'ordine della libreria)
+     * @details i media vengono valutati a blocchi con un unico passaggio, mantenendo solo i 'k' migliori in un heap;
+     *          vengono usati gli score gia' presenti nella cache, gli altri sono calcolati con i kernel di ScoreKernels
+     */
+    std::vector<unsigned int> getTopScoredMedia(unsigned int k, const SearchQuery& query = SearchQuery()) const;
+
 
     // === JSON ===
 
@@ -226,23 +424,76 @@ public:
     /**
      * @brief fromJson : riempie la libreria leggendo i media da un oggetto JSON, ricostruendo ciascun media utilizzando la classe MediaFactory
      * @param obj : oggetto QJsonObject con la rappresentazione serializzata dei media della libreria
-     * @details la libreria viene "svuotata" dei suoi contenuti attuali prima della lettura
+     * @param threadCount : numero massimo di thread da utilizzare per la costruzione dei media (1 per la lettura seriale)
+     * @details la libreria viene "svuotata" dei suoi contenuti attuali prima della lettura. Media, identificatori, ordine ed errori segnalati
+     *          non dipendono dal numero di thread
      */
-    void fromJson(const QJsonObject& obj);
+    void fromJson(const QJsonObject& obj, unsigned int threadCount = 1);
 
     /**
      * @brief saveToFile : salva i media della libreria in formato JSON su file
      * @param filename : file su cui scrivere i dati dei media in libreria
+     * @param compact : true per scrivere il JSON in formato compatto, false (default) per il formato indentato
+     * @param progress : notifica dell'avanzamento (media scritti / media totali), opzionale
      * @return bool : true se il salvataggio ha successo, false altrimenti
+     * @details i media vengono scritti uno alla volta con JsonStreamWriter, senza costruire l'intero documento in memoria. La scrittura avviene
+     *          su un file temporaneo che sostituisce il file di destinazione solo a salvataggio completato.
+     *          Se la libreria e' stata salvata o caricata per ultimo dallo stesso file, vengono solo aggiunte al journal (LibraryJournal) le
+     *          operazioni effettuate nel frattempo, finche' il journal non supera 1/COMPACTION_RATIO del file: in quel caso (o in caso di
+     *          errore) la libreria viene salvata per intero e il journal riparte vuoto. Il formato (compatto o indentato) cambia solo allora
      */
-    bool saveToFile(const QString& filename) const;
+    bool saveToFile(const QString& filename, bool compact = false, const ProgressCallback& progress = nullptr) const;
 
     /**
-     * @brief loadFromFile : carica i media della libreria da un file JSON, ricostruendo i media tramite il metodo 'fromJson'
+     * @brief loadFromFile : carica i media della libreria da un file JSON, con le stesse regole del metodo 'fromJson'
      * @param filename : file da cui leggere i media da caricare in liberia
+     * @param threadCount : numero massimo di thread da utilizzare per la costruzione dei media (1 per la lettura seriale)
+     * @param progress : notifica dell'avanzamento (byte letti / dimensione del file, il numero di media e' noto solo a fine lettura), opzionale
      * @return bool : true se la lettura ha successo, false altrimenti
+     * @details il file viene letto in streaming con JsonStreamReader, senza costruire un QJsonDocument: i record vengono letti a blocchi e ogni
+     *          media viene creato direttamente dal proprio record, quindi oltre ai media caricati la memoria usata e' quella di un blocco di record.
+     *          Se il file non e' un JSON valido la libreria non viene modificata. Se accanto al file e' presente il suo journal, le operazioni
+     *          salvate vengono applicate ai media caricati (un eventuale record incompleto in coda viene scartato)
+     */
+    bool loadFromFile(const QString& filename, unsigned int threadCount = 1, const ProgressCallback& progress = nullptr);
+
+
+    // === SNAPSHOT BINARIO ===
+
+    /**
+     * @brief saveBinary : salva i media della libreria su file nel formato binario di BinarySnapshot
+     * @param filename : file su cui scrivere (sostituito solo a scrittura completata)
+     * @return bool : true se il salvataggio ha successo, false altrimenti
+     */
+    bool saveBinary(const QString& filename) const;
+
+    /**
+     * @brief loadBinary : carica i media della libreria da un file nel formato binario di BinarySnapshot
+     * @param filename : file da cui leggere i media
+     * @return bool : true se la lettura ha successo, false altrimenti
+     * @details il file viene decodificato interamente prima di sostituire i contenuti della libreria: in caso di errore la libreria resta invariata
+     */
+    bool loadBinary(const QString& filename);
+
+
+    // === FILE MAPPATO ===
+
+    // In modalita' mappata i media restano nel file (MappedSnapshot) e vengono materializzati al primo accesso tramite 'getMediaByID'
+    // o 'getMediaAtIndex'; la ricerca viene effettuata direttamente sul file. La modalita' e' pensata per la sola consultazione:
+    // alla prima modifica (inserimento, rimozione, modifica) tutti i media vengono materializzati e la mappatura viene rilasciata.
+
+    /**
+     * @brief openMapped : apre un file nel formato di BinarySnapshot mappandolo in memoria, senza caricarne i media
+     * @param filename : file da aprire
+     * @return bool : true se l'apertura ha successo, false altrimenti (la libreria resta invariata)
+     */
+    bool openMapped(const QString& filename);
+
+    /**
+     * @brief isMapped : verifica se la libreria e' in modalita' mappata
+     * @return bool : true se i media sono letti da un file mappato, false altrimenti
      */
-    bool loadFromFile(const QString& filename);
+    bool isMapped() const;
 
 
 private:
@@ -250,6 +501,39 @@ private:
     std::vector<std::shared_ptr<Media::AbstractMedia>> libraryMedia;             //  media della libreria
     Loggers::IMediaLogger* libraryLogger;                                        // logger associato
     Loggers::LogLevel logLevel;                                                  // livello severita' del logging
+    ILibraryObserver* libraryObserver;                                           // osservatore delle modifiche ai media (opzionale)
+    unsigned int batchUpdateDepth;                                               // livello di annidamento degli aggiornamenti in blocco
+    bool batchUpdateChanged;                                                     // true se l'aggiornamento in blocco in corso ha cambiato dei media
+    Loggers::LogLevel batchSavedLogLevel;                                        // livello di logging da ripristinare al termine dell'aggiornamento
+    std::unordered_map<unsigned int, unsigned int> mediaIndexByID;               // indice identificatore univoco -> posizione in 'libraryMedia'
+    SearchIndex searchIndex;                                                     // indice invertito dei campi testuali, usato dalla ricerca
+    MediaColumns mediaColumns;                                                   // snapshot colonnare degli attributi numerici (opzionale)
+    bool columnSnapshotEnabled;                                                  // true se 'mediaColumns' viene mantenuto
+    std::unique_ptr<MappedSnapshot> mappedSnapshot;                              // file mappato (solo in modalita' mappata)
+
+    /** @brief JournalState : journal associato al file JSON salvato o caricato per ultimo */
+    struct JournalState {
+        QString snapshotFile;                 // file JSON (vuoto se la libreria non e' associata ad alcun journal)
+        std::uint64_t snapshotSize = 0;       // dimensione del file JSON
+        std::uint64_t journalSize = 0;        // byte del journal gia' scritti su file
+        std::string pendingRecords;           // operazioni non ancora scritte sul journal
+    };
+    mutable JournalState journal;                                                // modificato anche dal salvataggio
+
+    /** @brief ScoreEntry : risultato di un calcolo di ScoreVisitor */
+    struct ScoreEntry {
+        float value;          // score numerico
+        std::string label;    // label qualitativo
+        std::string info;     // informazioni sul calcolo
+    };
+    mutable std::unordered_map<unsigned int, ScoreEntry> scoreCache;            // cache degli score, identificatore univoco -> score
+
+    /** @brief ImportRecord : dati di un media da caricare, letti prima della sua costruzione */
+    struct ImportRecord {
+        std::string mediaType;      // tipo del media
+        bool hasUniqueID;           // true se e' presente un identificatore salvato (numerico)
+        unsigned int uniqueID;      // identificatore salvato
+    };
 
     // === CHECK DUPLICATE ID ===   added 4/6/25
 
@@ -259,6 +543,189 @@ private:
      * @return bool : true se l'identificatore univoco viene trovato, false altrimenti
      */
     bool checkDuplicateID(unsigned int id) const;
+
+
+    // === OSSERVATORE ===
+
+    /**
+     * @brief notifyBatchChanged : segnala all'osservatore un cambiamento di piu' media con 'onMediaBatchChanged' (durante un aggiornamento
+     *                             in blocco la notifica viene rimandata al suo termine)
+     */
+    void notifyBatchChanged();
+
+
+    // === RIPRISTINO ===
+
+    /**
+     * @brief restoreLibraryMediaAt : come 'insertLibraryMediaAt', ma senza validare il media (usato per reinserire un media rimosso, gia' validato)
+     * @param media : smart pointer al media da reinserire
+     * @param pos : posizione del media reinserito (se non valida, il media viene inserito in fondo)
+     * @return bool : true se il media viene reinserito con successo, false altrimenti (media nullo o identificatore gia' presente)
+     */
+    bool restoreLibraryMediaAt(const std::shared_ptr<Media::AbstractMedia> media, unsigned int pos);
+
+    /**
+     * @brief restoreLibraryMediaAtPositions : come 'insertLibraryMediaAtPositions', ma senza validare i media (usato per reinserire media rimossi, gia' validati)
+     * @param media : coppie (posizione finale, media), in ordine strettamente crescente di posizione
+     * @return bool : true se tutti i media vengono reinseriti, false se una posizione o un identificatore non e' valido (in tal caso non ne viene reinserito nessuno)
+     */
+    bool restoreLibraryMediaAtPositions(const std::vector<PositionedMedia>& media);
+
+
+    // === PARALLELISMO ===
+
+    /**
+     * @brief getWorkerCount : calcola il numero di worker con cui dividere un lavoro in blocchi contigui
+     * @param count : numero di elementi da elaborare
+     * @param minPerWorker : numero minimo di elementi per worker
+     * @param threadCount : numero massimo di thread
+     * @return unsigned int : numero di worker (0 o 1 per l'elaborazione seriale)
+     */
+    static unsigned int getWorkerCount(unsigned int count, unsigned int minPerWorker, unsigned int threadCount);
+
+    /**
+     * @brief runInChunks : esegue 'range' su blocchi contigui [first, last) di elementi, uno per worker, e attende il termine di tutti i worker
+     * @param count : numero di elementi da elaborare
+     * @param workers : numero di worker, come calcolato da 'getWorkerCount' (con al piu' un worker, un solo blocco nel thread chiamante)
+     * @param range : funzione (indice del blocco, first, last), il primo blocco viene eseguito dal thread chiamante
+     */
+    static void runInChunks(unsigned int count, unsigned int workers, const std::function<void(unsigned int, unsigned int, unsigned int)>& range);
+
+
+    // === INDICI ===
+
+    /**
+     * @brief rebuildLibraryIndexes : ricostruisce da zero gli indici 'mediaIndexByID', 'searchIndex' e (se attivo) 'mediaColumns' a partire dai contenuti di 'libraryMedia'
+     */
+    void rebuildLibraryIndexes();
+
+    /**
+     * @brief updateMediaIndexFrom : aggiorna le posizioni salvate nell'indice per tutti i media a partire da una data posizione (usato dopo una rimozione)
+     * @param pos : prima posizione da aggiornare
+     */
+    void updateMediaIndexFrom(unsigned int pos);
+
+
+    // === FILE MAPPATO ===
+
+    /**
+     * @brief detachMappedSnapshot : materializza tutti i media del file mappato in 'libraryMedia' e rilascia la mappatura (prima di una modifica)
+     */
+    void detachMappedSnapshot();
+
+    /**
+     * @brief readMediaAt : restituisce il media in una posizione per una lettura in blocco (in modalita' mappata il media non viene conservato)
+     * @param pos : posizione del media
+     * @return std::shared_ptr<AbstractMedia> : smart pointer al media, 'nullptr' se il record non puo' essere decodificato
+     */
+    std::shared_ptr<Media::AbstractMedia> readMediaAt(unsigned int pos) const;
+
+    /**
+     * @brief getUniqueIDAt : restituisce l'identificatore univoco del media in una posizione (senza materializzarlo)
+     * @param pos : posizione del media
+     * @return unsigned int : identificatore univoco
+     */
+    unsigned int getUniqueIDAt(unsigned int pos) const;
+
+
+    // === JOURNAL ===
+
+    /**
+     * @brief isJournalAttached : verifica se le operazioni sulla libreria vengono registrate per il journal
+     * @return bool : true se la libreria e' associata a un journal, false altrimenti
+     */
+    bool isJournalAttached() const;
+
+    /**
+     * @brief detachJournal : dissocia la libreria dal journal, scartando le operazioni non ancora scritte (il prossimo salvataggio sara' completo)
+     */
+    void detachJournal() const;
+
+    /**
+     * @brief appendToJournal : aggiunge al journal di un file le operazioni non ancora scritte
+     * @param filename : file JSON a cui e' associato il journal
+     * @return bool : true se le operazioni sono state scritte, false se serve un salvataggio completo (journal troppo grande o errore)
+     */
+    bool appendToJournal(const QString& filename) const;
+
+    /**
+     * @brief resetJournal : crea un journal vuoto per un file JSON appena salvato per intero, e vi associa la libreria
+     * @param filename : file JSON salvato
+     */
+    void resetJournal(const QString& filename) const;
+
+    /**
+     * @brief replayJournal : applica alla libreria appena caricata le operazioni del journal di un file JSON, e vi associa la libreria
+     * @param filename : file JSON caricato
+     * @details il journal viene ignorato se non si riferisce al contenuto attuale del file; i record successivi al primo record non valido
+     *          (o non applicabile) vengono eliminati dal file
+     */
+    void replayJournal(const QString& filename);
+
+    /**
+     * @brief applyJournalOperation : applica alla libreria un'operazione letta dal journal
+     * @param operation : operazione da applicare
+     * @return bool : true se l'operazione e' stata applicata, false altrimenti (posizione non valida, media non valido)
+     */
+    bool applyJournalOperation(const LibraryJournal::Operation& operation);
+
+
+    // === CACHE SCORE ===
+
+    /**
+     * @brief getScoreEntry : restituisce lo score di un media dalla cache, calcolandolo con ScoreVisitor se non presente
+     * @param id : identificatore univoco del media
+     * @return const ScoreEntry* : score del media, oppure 'nullptr' se il media non e' presente in libreria
+     */
+    const ScoreEntry* getScoreEntry(unsigned int id) const;
+
+    /**
+     * @brief scorePositions : restituisce gli score numerici dei media in un insieme di posizioni, usando la cache quando possibile
+     * @param positions : posizioni (crescenti) dei media
+     * @param scores : vettore in cui salvare gli score, l'elemento 'i' corrisponde a 'positions[i]'
+     */
+    void scorePositions(const std::vector<unsigned int>& positions, std::vector<float>& scores) const;
+
+
+    // === RICERCA ===
+
+    /**
+     * @brief visitSearchPositions : verifica con SearchVisitor i media in un insieme di posizioni, eventualmente dividendole in blocchi tra piu' thread
+     * @param query : filtri di ricerca
+     * @param positions : posizioni (crescenti) da visitare, oppure 'nullptr' per visitare l'intera libreria
+     * @param threadCount : numero massimo di thread (ogni thread usa un proprio SearchVisitor)
+     * @param cancelled : flag di annullamento ('nullptr' se la ricerca non puo' essere annullata)
+     * @return std::vector<unsigned int> : identificatori dei media trovati, nell'ordine della libreria
+     */
+    std::vector<unsigned int> visitSearchPositions(const SearchQuery& query, const std::vector<unsigned int>* positions, unsigned int threadCount,
+                                                   const std::atomic<bool>* cancelled) const;
+
+    /**
+     * @brief visitSearchCandidates : verifica con 'visitSearchPositions' un insieme di media candidati, dati per identificatore univoco
+     * @param query : filtri di ricerca
+     * @param candidateIDs : identificatori dei candidati (in qualsiasi ordine), gli identificatori non presenti vengono ignorati
+     * @param threadCount : numero massimo di thread
+     * @param cancelled : flag di annullamento ('nullptr' se la ricerca non puo' essere annullata)
+     * @return std::vector<unsigned int> : identificatori dei media trovati, nell'ordine della libreria
+     */
+    std::vector<unsigned int> visitSearchCandidates(const SearchQuery& query, const std::vector<unsigned int>& candidateIDs, unsigned int threadCount,
+                                                    const std::atomic<bool>* cancelled) const;
+
+
+    // === CARICAMENTO ===
+
+    /**
+     * @brief importRecords : crea con MediaFactory i media di un blocco di record, eventualmente dividendoli in blocchi tra piu' thread
+     * @param records : tipo e identificatore salvato di ciascun record
+     * @param decode : imposta gli attributi del media appena creato a partire dal record in una posizione (chiamata anche da thread diversi)
+     * @param threadCount : numero massimo di thread
+     * @param media : vettore a cui aggiungere i media creati, nell'ordine dei record
+     * @param errors : vettore a cui aggiungere i messaggi di errore dei record non caricati, nell'ordine dei record
+     * @details gli identificatori assegnati ai media sono gli stessi della costruzione seriale: vengono calcolati prima della costruzione
+     *          simulando il contatore statico, e assegnati da ciascun thread con AbstractFile::ReservedUniqueID
+     */
+    void importRecords(const std::vector<ImportRecord>& records, const std::function<void(unsigned int, Media::AbstractMedia&)>& decode,
+                       unsigned int threadCount, std::vector<std::shared_ptr<Media::AbstractMedia>>& media, std::vector<std::string>& errors) const;
 };
 
 }
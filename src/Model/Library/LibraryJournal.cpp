@@ -0,0 +1,314 @@
+#include "LibraryJournal.h"
+#include "Model/Library/BinarySnapshot.h"
+
+#include <array>
+#include <vector>
+#include <cstring>
+
+#include <QFile>
+
+
+namespace Model {
+namespace Library {
+
+namespace {
+
+inline void appendU32(std::string& out, std::uint32_t value) {
+    char bytes[4] = { static_cast<char>(value & 0xFFu), static_cast<char>((value >> 8) & 0xFFu),
+                      static_cast<char>((value >> 16) & 0xFFu), static_cast<char>((value >> 24) & 0xFFu) };
+    out.append(bytes, 4);
+}
+
+inline void appendString(std::string& out, const std::string& value) {
+    appendU32(out, static_cast<std::uint32_t>(value.size()));
+    out.append(value);
+}
+
+// tabella del CRC-32 (polinomio riflesso 0xEDB88320, lo stesso di zlib)
+const std::array<std::uint32_t, 256>& crcTable() {
+
+    static const std::array<std::uint32_t, 256> table = [] {
+        std::array<std::uint32_t, 256> t{};
+        for (std::uint32_t i = 0; i < 256; ++i) {
+            std::uint32_t c = i;
+            for (unsigned int k = 0; k < 8; ++k) {
+                c = (c & 1u) ? (0xEDB88320u ^ (c >> 1)) : (c >> 1);
+            }
+            t[i] = c;
+        }
+        return t;
+    }();
+    return table;
+}
+
+}
+
+const char LibraryJournal::FILE_MAGIC[4] = { 'V', 'L', 'J', 'N' };
+const std::uint32_t LibraryJournal::FORMAT_VERSION = 1;
+const std::string LibraryJournal::FILE_SUFFIX = ".journal";
+const std::size_t LibraryJournal::FILE_HEADER_SIZE = 24;
+const std::size_t LibraryJournal::RECORD_HEADER_SIZE = 5;
+const std::size_t LibraryJournal::RECORD_CHECKSUM_SIZE = 4;
+const unsigned int LibraryJournal::COMPACTION_RATIO = 4;
+
+
+// === FILE ===
+
+QString LibraryJournal::journalFileName(const QString& snapshotFile) { return snapshotFile + QString::fromStdString(FILE_SUFFIX); }
+
+bool LibraryJournal::readSnapshotInfo(const QString& snapshotFile, SnapshotInfo& info) {
+
+    // lettura binaria, per calcolare il checksum dei byte effettivamente presenti su file
+    QFile file(snapshotFile);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    std::vector<char> block(64 * 1024);
+    std::uint64_t size = 0;
+    std::uint32_t crc = 0;
+    qint64 read = 0;
+    while ((read = file.read(block.data(), static_cast<qint64>(block.size()))) > 0) {
+        crc = checksum(block.data(), static_cast<std::size_t>(read), crc);
+        size += static_cast<std::uint64_t>(read);
+    }
+    if (read < 0) {
+        return false;
+    }
+    info.size = size;
+    info.checksum = crc;
+    return true;
+}
+
+std::uint32_t LibraryJournal::checksum(const char* data, std::size_t size, std::uint32_t crc) {
+
+    const std::array<std::uint32_t, 256>& table = crcTable();
+    crc = ~crc;
+    for (std::size_t i = 0; i < size; ++i) {
+        crc = table[(crc ^ static_cast<unsigned char>(data[i])) & 0xFFu] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+
+// === CODIFICA ===
+
+std::string LibraryJournal::encodeHeader(const SnapshotInfo& info) {
+
+    std::string out;
+    out.reserve(FILE_HEADER_SIZE);
+    out.append(FILE_MAGIC, 4);
+    appendU32(out, FORMAT_VERSION);
+    appendU32(out, static_cast<std::uint32_t>(info.size & 0xFFFFFFFFu));
+    appendU32(out, static_cast<std::uint32_t>(info.size >> 32));
+    appendU32(out, info.checksum);
+    appendU32(out, info.mediaCount);
+    return out;
+}
+
+void LibraryJournal::appendInsert(std::string& out, const std::shared_ptr<Media::AbstractMedia>& media) {
+
+    appendRecord(out, OperationType::Insert, BinarySnapshot::encode({ media }));
+}
+
+void LibraryJournal::appendInsertAt(std::string& out, std::uint32_t position, const std::shared_ptr<Media::AbstractMedia>& media) {
+
+    std::string payload;
+    appendU32(payload, position);
+    payload += BinarySnapshot::encode({ media });
+    appendRecord(out, OperationType::InsertAt, payload);
+}
+
+void LibraryJournal::appendRemove(std::string& out, std::uint32_t position) {
+
+    std::string payload;
+    appendU32(payload, position);
+    appendRecord(out, OperationType::Remove, payload);
+}
+
+void LibraryJournal::appendRemoveMultiple(std::string& out, const std::vector<std::uint32_t>& positions) {
+
+    std::string payload;
+    payload.reserve(4 + positions.size() * 4);
+    appendU32(payload, static_cast<std::uint32_t>(positions.size()));
+    for (std::uint32_t position : positions) {
+        appendU32(payload, position);
+    }
+    appendRecord(out, OperationType::RemoveMultiple, payload);
+}
+
+void LibraryJournal::appendInsertMultipleAt(
+    std::string& out,
+    const std::vector<std::uint32_t>& positions,
+    const std::vector<std::shared_ptr<Media::AbstractMedia>>& media)
+{
+    std::string payload;
+    appendU32(payload, static_cast<std::uint32_t>(positions.size()));
+    for (std::uint32_t position : positions) {
+        appendU32(payload, position);
+    }
+    payload += BinarySnapshot::encode(media);
+    appendRecord(out, OperationType::InsertMultipleAt, payload);
+}
+
+void LibraryJournal::appendEdit(std::string& out, std::uint32_t position, const std::unordered_map<std::string, std::string>& edits) {
+
+    std::string payload;
+    appendU32(payload, position);
+    appendU32(payload, static_cast<std::uint32_t>(edits.size()));
+    for (const auto& edit : edits) {
+        appendString(payload, edit.first);
+        appendString(payload, edit.second);
+    }
+    appendRecord(out, OperationType::Edit, payload);
+}
+
+void LibraryJournal::appendRecord(std::string& out, OperationType type, const std::string& payload) {
+
+    std::size_t recordStart = out.size();
+    out.push_back(static_cast<char>(type));
+    appendU32(out, static_cast<std::uint32_t>(payload.size()));
+    out.append(payload);
+    appendU32(out, checksum(out.data() + recordStart, out.size() - recordStart));
+}
+
+
+// === DECODIFICA ===
+
+bool LibraryJournal::decodeHeader(const char* data, std::size_t size, SnapshotInfo& info) {
+
+    if (size < FILE_HEADER_SIZE || std::memcmp(data, FILE_MAGIC, 4) != 0 || BinarySnapshot::loadU32(data + 4) != FORMAT_VERSION) {
+        return false;
+    }
+    info.size = static_cast<std::uint64_t>(BinarySnapshot::loadU32(data + 8)) |
+                (static_cast<std::uint64_t>(BinarySnapshot::loadU32(data + 12)) << 32);
+    info.checksum = BinarySnapshot::loadU32(data + 16);
+    info.mediaCount = BinarySnapshot::loadU32(data + 20);
+    return true;
+}
+
+std::size_t LibraryJournal::decodeOperation(const char* data, std::size_t size, Operation& operation) {
+
+    if (size < RECORD_HEADER_SIZE + RECORD_CHECKSUM_SIZE) {
+        return 0;
+    }
+    std::uint32_t length = BinarySnapshot::loadU32(data + 1);
+    if (size - RECORD_HEADER_SIZE - RECORD_CHECKSUM_SIZE < length) {
+        return 0;
+    }
+    std::size_t recordSize = RECORD_HEADER_SIZE + length + RECORD_CHECKSUM_SIZE;
+    if (checksum(data, RECORD_HEADER_SIZE + length) != BinarySnapshot::loadU32(data + RECORD_HEADER_SIZE + length)) {
+        return 0;
+    }
+
+    const char* payload = data + RECORD_HEADER_SIZE;
+    const char* end = payload + length;
+    operation.media.reset();
+    operation.edits.clear();
+    operation.positions.clear();
+    operation.multipleMedia.clear();
+    operation.position = 0;
+
+    // legge il numero di posizioni e le posizioni (RemoveMultiple, InsertMultipleAt), restituisce il numero di byte letti (0 se non valide)
+    auto readPositions = [&operation, payload, end]() -> std::size_t {
+        if (end - payload < 4) return 0;
+        std::uint32_t count = BinarySnapshot::loadU32(payload);
+        if (static_cast<std::size_t>(end - payload - 4) / 4 < count) return 0;
+        operation.positions.resize(count);
+        for (std::uint32_t i = 0; i < count; ++i) {
+            operation.positions[i] = BinarySnapshot::loadU32(payload + 4 + 4 * i);
+        }
+        return 4 + static_cast<std::size_t>(count) * 4;
+    };
+
+    switch (static_cast<std::uint8_t>(data[0])) {
+
+    case static_cast<std::uint8_t>(OperationType::Insert):
+    case static_cast<std::uint8_t>(OperationType::InsertAt): {
+        operation.type = static_cast<OperationType>(data[0]);
+        if (operation.type == OperationType::InsertAt) {
+            if (length < 4) {
+                return 0;
+            }
+            operation.position = BinarySnapshot::loadU32(payload);
+            payload += 4;
+            length -= 4;
+        }
+        unsigned int skippedRecords = 0;
+        try {
+            auto media = BinarySnapshot::decode(payload, length, skippedRecords);
+            if (media.size() != 1 || skippedRecords > 0) {
+                return 0;
+            }
+            operation.media = media.front();
+        }
+        catch (const std::exception&) {
+            return 0;
+        }
+        return recordSize;
+    }
+
+    case static_cast<std::uint8_t>(OperationType::Remove):
+        operation.type = OperationType::Remove;
+        if (length < 4) {
+            return 0;
+        }
+        operation.position = BinarySnapshot::loadU32(payload);
+        return recordSize;
+
+    case static_cast<std::uint8_t>(OperationType::Edit): {
+        operation.type = OperationType::Edit;
+        if (length < 8) {
+            return 0;
+        }
+        operation.position = BinarySnapshot::loadU32(payload);
+        std::uint32_t editCount = BinarySnapshot::loadU32(payload + 4);
+        const char* current = payload + 8;
+        std::string values[2];
+        for (std::uint32_t i = 0; i < editCount; ++i) {
+            for (std::string& value : values) {
+                if (end - current < 4) return 0;
+                std::uint32_t valueLength = BinarySnapshot::loadU32(current);
+                current += 4;
+                if (static_cast<std::size_t>(end - current) < valueLength) return 0;
+                value.assign(current, valueLength);
+                current += valueLength;
+            }
+            operation.edits[values[0]] = values[1];
+        }
+        return recordSize;
+    }
+
+    case static_cast<std::uint8_t>(OperationType::RemoveMultiple):
+        operation.type = OperationType::RemoveMultiple;
+        if (readPositions() != length) {
+            return 0;
+        }
+        return recordSize;
+
+    case static_cast<std::uint8_t>(OperationType::InsertMultipleAt): {
+        operation.type = OperationType::InsertMultipleAt;
+        std::size_t read = readPositions();
+        if (read == 0) {
+            return 0;
+        }
+        unsigned int skippedRecords = 0;
+        try {
+            operation.multipleMedia = BinarySnapshot::decode(payload + read, length - read, skippedRecords);
+        }
+        catch (const std::exception&) {
+            return 0;
+        }
+        if (operation.multipleMedia.size() != operation.positions.size() || skippedRecords > 0) {
+            return 0;
+        }
+        return recordSize;
+    }
+
+    default:
+        // tipo di operazione sconosciuto
+        return 0;
+    }
+}
+
+}
+}
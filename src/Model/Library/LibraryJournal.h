@@ -0,0 +1,160 @@
+#ifndef MODEL_LIBRARY_LIBRARY_JOURNAL_H
+#define MODEL_LIBRARY_LIBRARY_JOURNAL_H
+
+#include "Model/Media/AbstractMedia.h"
+
+#include <string>
+#include <memory>
+#include <cstdint>
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+#include <QString>
+
+/** @brief LibraryJournal
+ *
+ *  LibraryJournal definisce il formato del journal delle modifiche di una libreria salvata in formato JSON: un file binario "append-only",
+ *  salvato accanto al file JSON (snapshot) con suffisso ".journal", che contiene le operazioni (inserimento, rimozione, modifica) effettuate
+ *  sulla libreria dopo il salvataggio dello snapshot. In questo modo un salvataggio dopo poche modifiche scrive solo le modifiche stesse,
+ *  invece di riscrivere l'intera libreria; quando il journal diventa troppo grande rispetto allo snapshot, la libreria viene salvata per intero
+ *  (compattazione) e il journal riparte vuoto.
+ *
+ *  Struttura del file (interi little-endian):
+ *  - intestazione : magic "VLJN" (4 byte), versione (u32), dimensione dello snapshot in byte (u64), checksum CRC-32 dello snapshot (u32),
+ *    numero di media dello snapshot (u32). Il journal viene applicato solo allo snapshot descritto dall'intestazione
+ *  - record : tipo (u8, OperationType), lunghezza del contenuto (u32), contenuto, CRC-32 di tipo, lunghezza e contenuto (u32)
+ *
+ *  Contenuto dei record:
+ *  - Insert : il media inserito (in fondo alla libreria), codificato come uno snapshot di BinarySnapshot con un solo media
+ *  - InsertAt : posizione del media inserito (u32), seguita dal media codificato come in Insert (ad esempio un media rimosso e poi ripristinato)
+ *  - Remove : posizione del media rimosso (u32)
+ *  - Edit : posizione del media modificato (u32), numero di modifiche (u32) e, per ciascuna, chiave e valore (lunghezza u32 seguita dai byte)
+ *  - RemoveMultiple : numero di media rimossi (u32) e le loro posizioni prima della rimozione (u32 ciascuna, in ordine crescente)
+ *  - InsertMultipleAt : numero di media inseriti (u32), le loro posizioni finali (u32 ciascuna, in ordine crescente), seguite dai media
+ *    codificati come un unico snapshot di BinarySnapshot (ad esempio i media di una rimozione multipla annullata)
+ *
+ *  Le operazioni fanno riferimento alle posizioni dei media e non ai loro identificatori univoci, che non vengono conservati dal formato JSON.
+ *  Un record incompleto o con checksum errato (ad esempio per un'interruzione durante la scrittura) termina il journal: i record successivi
+ *  vengono ignorati.
+ */
+
+namespace Model {
+namespace Library {
+
+class LibraryJournal {
+
+public:
+
+    // === COSTANTI STATICHE ===
+
+    static const char FILE_MAGIC[4];                // "VLJN"
+    static const std::uint32_t FORMAT_VERSION;      // versione corrente del formato
+    static const std::string FILE_SUFFIX;           // suffisso aggiunto al nome dello snapshot (".journal")
+    static const std::size_t FILE_HEADER_SIZE;      // lunghezza dell'intestazione del file
+    static const std::size_t RECORD_HEADER_SIZE;    // lunghezza dell'intestazione di un record (tipo e lunghezza)
+    static const std::size_t RECORD_CHECKSUM_SIZE;  // lunghezza del checksum in coda a un record
+    static const unsigned int COMPACTION_RATIO;     // il journal viene compattato quando supera 1/COMPACTION_RATIO dello snapshot
+
+    /** @brief OperationType : tipo di operazione di un record */
+    enum class OperationType : std::uint8_t { Insert = 0, Remove, Edit, InsertAt, RemoveMultiple, InsertMultipleAt };
+
+    /** @brief SnapshotInfo : snapshot a cui si riferisce il journal */
+    struct SnapshotInfo {
+        std::uint64_t size = 0;         // dimensione del file in byte
+        std::uint32_t checksum = 0;     // CRC-32 del contenuto del file
+        std::uint32_t mediaCount = 0;   // numero di media caricati dal file
+    };
+
+    /** @brief Operation : operazione letta da un record */
+    struct Operation {
+        OperationType type = OperationType::Insert;
+        std::uint32_t position = 0;                                 // posizione del media (Remove, Edit, InsertAt)
+        std::shared_ptr<Media::AbstractMedia> media;                // media da inserire (Insert, InsertAt)
+        std::unordered_map<std::string, std::string> edits;         // modifiche da effettuare (Edit)
+        std::vector<std::uint32_t> positions;                       // posizioni dei media (RemoveMultiple, InsertMultipleAt)
+        std::vector<std::shared_ptr<Media::AbstractMedia>> multipleMedia;   // media da inserire (InsertMultipleAt)
+    };
+
+
+    // === FILE ===
+
+    /**
+     * @brief journalFileName : restituisce il nome del journal associato a uno snapshot
+     * @param snapshotFile : file dello snapshot
+     * @return QString : file del journal
+     */
+    static QString journalFileName(const QString& snapshotFile);
+
+    /**
+     * @brief readSnapshotInfo : calcola dimensione e checksum di un file snapshot, leggendolo a blocchi
+     * @param snapshotFile : file dello snapshot
+     * @param info : informazioni calcolate (il numero di media non viene modificato)
+     * @return bool : true se il file e' stato letto, false altrimenti
+     */
+    static bool readSnapshotInfo(const QString& snapshotFile, SnapshotInfo& info);
+
+    /**
+     * @brief checksum : calcola (o prosegue) il CRC-32 di un blocco di byte
+     * @param data : byte del blocco
+     * @param size : numero di byte
+     * @param crc : CRC-32 dei blocchi precedenti (0 per il primo blocco)
+     * @return std::uint32_t : CRC-32 aggiornato
+     */
+    static std::uint32_t checksum(const char* data, std::size_t size, std::uint32_t crc = 0);
+
+
+    // === CODIFICA ===
+
+    /**
+     * @brief encodeHeader : codifica l'intestazione di un journal
+     * @param info : snapshot a cui si riferisce il journal
+     * @return std::string : byte dell'intestazione
+     */
+    static std::string encodeHeader(const SnapshotInfo& info);
+
+    static void appendInsert(std::string& out, const std::shared_ptr<Media::AbstractMedia>& media);
+    static void appendInsertAt(std::string& out, std::uint32_t position, const std::shared_ptr<Media::AbstractMedia>& media);
+    static void appendRemove(std::string& out, std::uint32_t position);
+    static void appendRemoveMultiple(std::string& out, const std::vector<std::uint32_t>& positions);
+    static void appendInsertMultipleAt(std::string& out, const std::vector<std::uint32_t>& positions,
+                                       const std::vector<std::shared_ptr<Media::AbstractMedia>>& media);
+    static void appendEdit(std::string& out, std::uint32_t position, const std::unordered_map<std::string, std::string>& edits);
+
+
+    // === DECODIFICA ===
+
+    /**
+     * @brief decodeHeader : legge l'intestazione di un journal
+     * @param data : contenuto del journal
+     * @param size : lunghezza del contenuto
+     * @param info : snapshot a cui si riferisce il journal
+     * @return bool : true se l'intestazione e' valida e della versione corrente, false altrimenti
+     */
+    static bool decodeHeader(const char* data, std::size_t size, SnapshotInfo& info);
+
+    /**
+     * @brief decodeOperation : legge il record che inizia in una posizione del journal
+     * @param data : inizio del record
+     * @param size : byte disponibili a partire da 'data'
+     * @param operation : operazione letta
+     * @return std::size_t : lunghezza del record, 0 se il record e' incompleto, ha un checksum errato o un contenuto non valido
+     */
+    static std::size_t decodeOperation(const char* data, std::size_t size, Operation& operation);
+
+
+private:
+
+    /**
+     * @brief appendRecord : aggiunge un record completo (intestazione, contenuto e checksum)
+     * @param out : stringa a cui aggiungere il record
+     * @param type : tipo di operazione
+     * @param payload : contenuto del record
+     */
+    static void appendRecord(std::string& out, OperationType type, const std::string& payload);
+};
+
+}
+}
+
+#endif // MODEL_LIBRARY_LIBRARY_JOURNAL_H
@@ -5,6 +5,8 @@
 #include "Model/Library/Command/InsertCommand.h"
 #include "Model/Library/Command/RemoveCommand.h"
 #include "Model/Library/Command/EditCommand.h"
+#include "Model/Library/Command/BulkEditCommand.h"
+#include "Model/Library/Command/BulkRemoveCommand.h"
 
 #include <string>
 #include <vector>
@@ -19,11 +21,15 @@
 namespace Model {
 namespace Library {
 
+const std::size_t Manager::DEFAULT_UNDO_MEMORY_BUDGET = 64 * 1024 * 1024;
+
 Manager::Manager(Loggers::IMediaLogger* log)
     : mediaLibrary(log),
     currentIndex(0),
     lastUndoDescription(""),
-    lastRedoDescription("")
+    lastRedoDescription(""),
+    undoMemoryBudget(DEFAULT_UNDO_MEMORY_BUDGET),
+    undoMemoryUsage(0)
 {
     mediaLibrary.setLibraryLogLevel(Loggers::LogLevel::Info);
 }
@@ -95,15 +101,11 @@ unsigned int Manager::getMediaIndexByID(unsigned int id) const {
         return getSize();
     }
 
-    const auto& media = mediaLibrary.getAllLibraryMedia();
-    for (unsigned int i = 0; i < media.size(); ++i) {
-        if (media[i] && media[i]->getUniqueID() == id) {
-            return i;
-        }
+    unsigned int ind = mediaLibrary.getMediaIndexByID(id);
+    if (!isValidIndex(ind)) {
+        mediaLibrary.logLibraryMessage("[MANAGER GET MEDIA BY ID] No media with ID=" + std::to_string(id) + " was found, returning library size\n", Loggers::LogLevel::Debug);
     }
-
-    mediaLibrary.logLibraryMessage("[MANAGER GET MEDIA BY ID] No media with ID=" + std::to_string(id) + " was found, returning library size\n", Loggers::LogLevel::Debug);
-    return media.size();
+    return ind;
 }
 
 
@@ -115,7 +117,7 @@ std::shared_ptr<Media::AbstractMedia> Manager::getMediaAtIndex(unsigned int ind)
         mediaLibrary.logLibraryMessage("[MANAGER - GET MEDIA AT] Index '" + std::to_string(ind) + "' is not a valid index\n", Loggers::LogLevel::Debug);
         return nullptr;
     }
-    return mediaLibrary.getAllLibraryMedia().at(ind);
+    return mediaLibrary.getMediaAtIndex(ind);
 }
 
 std::shared_ptr<Media::AbstractMedia> Manager::getCurrentMedia() const {
@@ -196,6 +198,36 @@ bool Manager::removeMediaAtCurrentIndex() {
     return removeMediaAtIndex(currentIndex);
 }
 
+unsigned int Manager::removeMediaByIDs(const std::vector<unsigned int>& ids) {
+
+    if (isEmpty() || ids.empty()) {
+        mediaLibrary.logLibraryMessage("[MANAGER - REMOVE MEDIA BY ID] Library is empty or no media to remove\n", Loggers::LogLevel::Debug);
+        return 0;
+    }
+
+    auto command = std::make_shared<Command::BulkRemoveCommand>(&mediaLibrary, ids);
+    // eseguito prima di 'executeCommand' (che non lo ripete), cosi' una rimozione senza media presenti non entra nella cronologia
+    command->execute();
+    unsigned int removedCount = command->getRemovedCount();
+    if (removedCount == 0) return 0;
+    executeCommand(command);
+
+    if (!isValidIndex(currentIndex)) {
+        currentIndex = isEmpty() ? 0 : getSize() - 1;
+    }
+    mediaLibrary.logLibraryMessage("[MANAGER - REMOVE MEDIA BY ID] Removed " + std::to_string(removedCount) + " media\n", Loggers::LogLevel::Info);
+    return removedCount;
+}
+
+unsigned int Manager::removeMediaByQuery(const SearchQuery& query, unsigned int threadCount) {
+
+    if (isEmpty()) {
+        mediaLibrary.logLibraryMessage("[MANAGER - REMOVE MEDIA BY QUERY] Library is empty\n", Loggers::LogLevel::Debug);
+        return 0;
+    }
+    return removeMediaByIDs(mediaLibrary.searchLibrary(query, threadCount));
+}
+
 
 // === MODIFICA ===
 
@@ -238,6 +270,35 @@ bool Manager::editMediaAtCurrentIndex(const std::unordered_map<std::string, std:
     return editMediaAtIndex(currentIndex, mediaEdits);
 }
 
+std::vector<std::pair<unsigned int, std::string>> Manager::editMediaByQuery(
+    const SearchQuery& query,
+    const std::unordered_map<std::string, std::string>& mediaEdits,
+    unsigned int threadCount)
+{
+    if (isEmpty() || mediaEdits.empty()) {
+        mediaLibrary.logLibraryMessage("[MANAGER - EDIT MEDIA BY QUERY] Library is empty or no edits\n", Loggers::LogLevel::Debug);
+        return {};
+    }
+
+    std::vector<unsigned int> matches = mediaLibrary.searchLibrary(query, threadCount);
+    if (matches.empty()) {
+        mediaLibrary.logLibraryMessage("[MANAGER - EDIT MEDIA BY QUERY] Search found no media to edit\n", Loggers::LogLevel::Info);
+        return {};
+    }
+    unsigned int matchCount = static_cast<unsigned int>(matches.size());
+
+    auto command = std::make_shared<Command::BulkEditCommand>(&mediaLibrary, std::move(matches), mediaEdits, threadCount);
+    // eseguito prima di 'executeCommand' (che non lo ripete), cosi' una modifica che non cambia alcun media non entra nella cronologia
+    command->execute();
+    if (command->getEditedCount() > 0) {
+        executeCommand(command);
+    }
+
+    mediaLibrary.logLibraryMessage("[MANAGER - EDIT MEDIA BY QUERY] Edited " + std::to_string(command->getEditedCount()) + " of " + std::to_string(matchCount) +
+        " matching media, " + std::to_string(command->getFailures().size()) + " failed\n", Loggers::LogLevel::Info);
+    return command->getFailures();
+}
+
 
 // === CREAZIONE ===
 
@@ -279,14 +340,14 @@ std::shared_ptr<Media::AbstractMedia> Manager::createNewMedia(
 
 // === RICERCA ===
 
-std::vector<unsigned int> Manager::searchMedia(const SearchQuery& query) const {
+std::vector<unsigned int> Manager::searchMedia(const SearchQuery& query, unsigned int threadCount, const std::atomic<bool>* cancelled) const {
 
     if (isEmpty()) {
         mediaLibrary.logLibraryMessage("[MANAGER - SEARCH MEDIA] Library is empty, returning empty result vector\n", Loggers::LogLevel::Debug);
         return {};
     }
 
-    std::vector<unsigned int> searchResults = mediaLibrary.searchLibrary(query);
+    std::vector<unsigned int> searchResults = mediaLibrary.searchLibrary(query, threadCount, cancelled);
     if (searchResults.empty()) {
         mediaLibrary.logLibraryMessage("[MANAGER - SEARCH MEDIA] Search found no matching media, returning empty result vector\n", Loggers::LogLevel::Info);
         return searchResults;
@@ -297,6 +358,18 @@ std::vector<unsigned int> Manager::searchMedia(const SearchQuery& query) const {
     return searchResults;
 }
 
+std::vector<unsigned int> Manager::narrowSearch(
+    const SearchQuery& query,
+    const std::vector<unsigned int>& previousIDs,
+    unsigned int threadCount,
+    const std::atomic<bool>* cancelled) const
+{
+    if (previousIDs.empty()) {
+        return {};
+    }
+    return mediaLibrary.narrowSearchResults(query, previousIDs, threadCount, cancelled);
+}
+
 std::vector<unsigned int> Manager::getSearchResultIndexesByID(const std::vector<unsigned int>& mediaIDs) const {
 
     if (mediaIDs.empty()) {
@@ -314,6 +387,13 @@ std::vector<unsigned int> Manager::getSearchResultIndexesByID(const std::vector<
     return mediaIndexes;
 }
 
+
+// === SNAPSHOT COLONNARE ===
+
+void Manager::setColumnSnapshotEnabled(bool enabled) { mediaLibrary.setColumnSnapshotEnabled(enabled); }
+
+bool Manager::isColumnSnapshotEnabled() const { return mediaLibrary.isColumnSnapshotEnabled(); }
+
 // === SCORING ===
 
 float Manager::getMediaScoreAtIndex(unsigned int ind) const {
@@ -349,22 +429,57 @@ std::string Manager::getMediaScoreInfoAtIndex(unsigned int ind) const {
     return mediaLibrary.getMediaScoreInfoByID(media->getUniqueID());
 }
 
+void Manager::precomputeMediaScores() const { mediaLibrary.precomputeLibraryScores(); }
+
+std::vector<float> Manager::scoreAll() const { return mediaLibrary.scoreAll(); }
+
+std::vector<float> Manager::scoreRange(unsigned int first, unsigned int last) const { return mediaLibrary.scoreRange(first, last); }
+
+std::vector<unsigned int> Manager::getTopScoredMedia(unsigned int k, const SearchQuery& query) const { return mediaLibrary.getTopScoredMedia(k, query); }
+
 
 // === JSON ===
 
-bool Manager::saveContentsToFile(const QString& filename) const {
+bool Manager::saveContentsToFile(const QString& filename, bool compact, const Library::ProgressCallback& progress) const {
+
+    return mediaLibrary.saveToFile(filename, compact, progress);
 
-    return mediaLibrary.saveToFile(filename);
+}
+
+bool Manager::loadContentsFromFile(const QString& filename, unsigned int threadCount, const Library::ProgressCallback& progress) {
+
+    bool readSuccess = mediaLibrary.loadFromFile(filename, threadCount, progress);
+    if (readSuccess) currentIndex = 0;
+    return readSuccess;
+}
+
+bool Manager::saveContentsToBinary(const QString& filename) const {
 
+    return mediaLibrary.saveBinary(filename);
 }
 
-bool Manager::loadContentsFromFile(const QString& filename) {
+bool Manager::loadContentsFromBinary(const QString& filename) {
 
-    bool readSuccess = mediaLibrary.loadFromFile(filename);
+    bool readSuccess = mediaLibrary.loadBinary(filename);
     if (readSuccess) currentIndex = 0;
     return readSuccess;
 }
 
+bool Manager::openContentsMapped(const QString& filename) {
+
+    bool openSuccess = mediaLibrary.openMapped(filename);
+    if (openSuccess) currentIndex = 0;
+    return openSuccess;
+}
+
+bool Manager::isContentsMapped() const { return mediaLibrary.isMapped(); }
+
+void Manager::replaceContents(Library& loaded) {
+
+    mediaLibrary.takeContents(loaded);
+    currentIndex = 0;
+}
+
 
 // === LOGGERS ===
 
@@ -372,6 +487,10 @@ void Manager::setLibraryLogger(Model::Loggers::IMediaLogger* newLogger) {
     mediaLibrary.setLibraryLogger(newLogger);
 }
 
+Model::Loggers::IMediaLogger* Manager::getLibraryLogger() const {
+    return mediaLibrary.getLibraryLogger();
+}
+
 Model::Loggers::LogLevel Manager::getLogLevel() const {
     return mediaLibrary.getLibraryLogLevel();
 }
@@ -380,6 +499,12 @@ void Manager::setLogLevel(Model::Loggers::LogLevel level) {
     mediaLibrary.setLibraryLogLevel(level);
 }
 
+// === OSSERVATORE ===
+
+void Manager::setLibraryObserver(ILibraryObserver* observer) {
+    mediaLibrary.setLibraryObserver(observer);
+}
+
 // === COMMAND ===
 
 void Manager::executeCommand(const std::shared_ptr<Command::IAbstractCommand>& cmd) {
@@ -388,10 +513,15 @@ void Manager::executeCommand(const std::shared_ptr<Command::IAbstractCommand>& c
     if (cmd) {
         // eseguilo
         cmd->execute();
-        // inserisci nel vettore dei Undo
-        undoCommands.push_back(cmd);
         // svuota vettore dei Redo
+        for (const auto& command : redoCommands) {
+            if (command) undoMemoryUsage -= command->getMemoryUsage();
+        }
         redoCommands.clear();
+        // inserisci nel vettore dei Undo
+        undoCommands.push_back(cmd);
+        undoMemoryUsage += cmd->getMemoryUsage();
+        enforceUndoMemoryBudget();
     }
 }
 
@@ -404,12 +534,15 @@ void Manager::undoCommand() {
         // e togli dal vettore
         undoCommands.pop_back();
         if (command) {
-            // esegui il comando
+            // esegui il comando (la memoria trattenuta puo' cambiare, ad esempio un media rimosso torna in libreria)
+            undoMemoryUsage -= command->getMemoryUsage();
             command->undo();
+            undoMemoryUsage += command->getMemoryUsage();
             // aggiorna info ultimo comando annullato
             lastUndoDescription = command->getCommandInfo();
             // inserisci nel vettore dei Redo
             redoCommands.push_back(command);
+            enforceUndoMemoryBudget();
         }
     }
 }
@@ -424,11 +557,14 @@ void Manager::redoCommand() {
         redoCommands.pop_back();
         if (command) {
             // esegui il comando
+            undoMemoryUsage -= command->getMemoryUsage();
             command->execute();
+            undoMemoryUsage += command->getMemoryUsage();
             // aggiorna info ultimo comando eseguito (ripristinato)
             lastRedoDescription = command->getCommandInfo();
             // inserisci comando nel vettori dei Undo
             undoCommands.push_back(command);
+            enforceUndoMemoryBudget();
         }
     }
 }
@@ -444,6 +580,106 @@ bool Manager::canRedoCommand() const {
 void Manager::clearCommandOperations() {
     undoCommands.clear();
     redoCommands.clear();
+    undoMemoryUsage = 0;
+}
+
+void Manager::setUndoMemoryBudget(std::size_t bytes) {
+
+    undoMemoryBudget = bytes;
+    enforceUndoMemoryBudget();
+}
+
+std::size_t Manager::getUndoMemoryBudget() const { return undoMemoryBudget; }
+
+std::size_t Manager::getUndoMemoryUsage() const { return undoMemoryUsage; }
+
+
+// === BATCH ===
+
+void Manager::beginBatch() {
+
+    if (openBatch) {
+        mediaLibrary.logLibraryMessage("[MANAGER - BEGIN BATCH] Discarding uncommitted batch of " + std::to_string(openBatch->getOperationCount()) +
+            " operations\n", Loggers::LogLevel::Info);
+    }
+    openBatch = std::make_shared<Command::BatchCommand>(&mediaLibrary);
+}
+
+bool Manager::isBatchOpen() const { return openBatch != nullptr; }
+
+bool Manager::queueInsert(const std::shared_ptr<Media::AbstractMedia>& media) {
+
+    if (!openBatch) return false;
+    openBatch->addInsert(media);
+    return true;
+}
+
+bool Manager::queueEdit(unsigned int id, const std::unordered_map<std::string, std::string>& mediaEdits) {
+
+    if (!openBatch) return false;
+    openBatch->addEdit(id, mediaEdits);
+    return true;
+}
+
+bool Manager::queueRemove(unsigned int id) {
+
+    if (!openBatch) return false;
+    openBatch->addRemove(id);
+    return true;
+}
+
+bool Manager::commitBatch() {
+
+    if (!openBatch) {
+        mediaLibrary.logLibraryMessage("[MANAGER - COMMIT BATCH] No open batch\n", Loggers::LogLevel::Debug);
+        return false;
+    }
+    // il batch viene chiuso in ogni caso, anche se fallisce
+    auto batch = std::move(openBatch);
+    openBatch.reset();
+    unsigned int operations = batch->getOperationCount();
+    if (operations == 0) return true;
+
+    try {
+        batch->validate();
+        executeCommand(batch);
+    }
+    catch (const Visitors::MediaValidatorException& e) {
+        mediaLibrary.logLibraryMessage("[MANAGER - COMMIT BATCH] Error: Batch rejected, library unchanged: " + std::string(e.what()), Loggers::LogLevel::Error);
+        throw;
+    }
+
+    // inserimenti e rimozioni possono aver reso l'indice corrente non valido
+    if (!isValidIndex(currentIndex)) {
+        currentIndex = isEmpty() ? 0 : getSize() - 1;
+    }
+    mediaLibrary.logLibraryMessage("[MANAGER - COMMIT BATCH] Committed batch of " + std::to_string(operations) + " operations\n", Loggers::LogLevel::Info);
+    return true;
+}
+
+void Manager::cancelBatch() { openBatch.reset(); }
+
+
+void Manager::enforceUndoMemoryBudget() {
+
+    // vengono scartati prima i comandi Redo piu' lontani dallo stato corrente (quelli in testa, da ripristinare per ultimi), anche tutti,
+    // poi i comandi Undo piu' vecchi: la cronologia Undo non viene sacrificata per i Redo, e l'ultimo comando eseguito resta sempre annullabile
+    std::size_t discardedRedo = 0;
+    while (undoMemoryUsage > undoMemoryBudget && !redoCommands.empty()) {
+        if (redoCommands.front()) undoMemoryUsage -= redoCommands.front()->getMemoryUsage();
+        redoCommands.pop_front();
+        ++discardedRedo;
+    }
+    std::size_t discardedUndo = 0;
+    while (undoMemoryUsage > undoMemoryBudget && undoCommands.size() > 1) {
+        if (undoCommands.front()) undoMemoryUsage -= undoCommands.front()->getMemoryUsage();
+        undoCommands.pop_front();
+        ++discardedUndo;
+    }
+    if (discardedRedo > 0 || discardedUndo > 0) {
+        mediaLibrary.logLibraryMessage("[MANAGER - UNDO HISTORY] Discarded " + std::to_string(discardedRedo) + " redo and " + std::to_string(discardedUndo) +
+            " oldest undo command(s) to stay within the undo memory budget\n", Loggers::LogLevel::Debug);
+    }
 }
 
 
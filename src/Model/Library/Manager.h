@@ -3,6 +3,7 @@
 
 #include "Model/Library/Library.h"
 #include "Model/Library/Command/IAbstractCommand.h"
+#include "Model/Library/Command/BatchCommand.h"
 #include "Model/Loggers/IMediaLogger.h"
 #include "Model/Loggers/LogLevel.h"
 #include "Model/Library/SearchQuery.h"
@@ -10,8 +11,11 @@
 
 #include <string>
 #include <vector>
+#include <deque>
 #include <unordered_map>
 #include <memory>
+#include <atomic>
+#include <cstddef>
 
 #include <QString>
 
@@ -21,7 +25,7 @@
  *  Viene utilizzata come "ponte" tra il modello logico e la vista, comunicando con il Controller.
  *
  *  Contiene come campi dati privati un'istanza di Library e un contatore di indice corrente.
- *  Inoltre, contiene come campi dati privati due vettori 'undoCommands' e 'redoCommands' di smart pointer del tipo std::shared_ptr<IAbstractCommand> per implementare il design pattern Command
+ *  Inoltre, contiene come campi dati privati due code 'undoCommands' e 'redoCommands' di smart pointer del tipo std::shared_ptr<IAbstractCommand> per implementare il design pattern Command
  *  e due stringhe 'lastUndoDescription' e 'lastRedoDescription' per contenere informazioni sull'ultimo comando eseguito oppure ripristinato.
  *
  *  Manager estende le funzionalita' di Library e aggiunge altre nuove. Le funzionalita' base di Library (inserimento, rimozione, modifica, fetch, caricamento/salvataggio) vengono estese in Manager in modo da agire
@@ -31,6 +35,17 @@
  *
  *  La classe Manager implementa il design pattern Command, in modo da incapsulare ogni operazione di Manager come un oggetto del tipo IAbstractCommand, o di una sua classe derivata, per poter implementare le operazioni Undo/Redo.
  *  In particolare, utilizza i comandi concreti del namespace Model::Library::Command, InsertCommand, RemoveCommand e EditCommand.
+ *
+ *  La stessa modifica puo' essere applicata a tutti i risultati di una ricerca ('editMediaByQuery') con un Command::BulkEditCommand, che modifica i media
+ *  in parallelo e produce un'unica operazione annullabile, riportando i media la cui modifica e' fallita. Allo stesso modo, 'removeMediaByQuery' e
+ *  'removeMediaByIDs' rimuovono piu' media con un Command::BulkRemoveCommand, compattando la libreria in un solo passaggio.
+ *
+ *  Piu' operazioni possono essere raggruppate in una transazione ('beginBatch', 'queueInsert'/'queueEdit'/'queueRemove', 'commitBatch'), eseguita con un
+ *  Command::BatchCommand: le operazioni vengono validate insieme, applicate con un'unica notifica all'osservatore e annullate/ripristinate in un solo passo.
+ *
+ *  La memoria trattenuta dalla cronologia Undo/Redo (stimata da ciascun comando con 'getMemoryUsage') e' limitata da un budget configurabile
+ *  ('setUndoMemoryBudget'): quando viene superato, vengono scartati prima i comandi Redo piu' lontani e poi i comandi Undo piu' vecchi
+ *  (l'ultimo comando eseguito resta sempre annullabile).
  */
 
 namespace Model {
@@ -40,6 +55,8 @@ class Manager {
 
 public:
 
+    static const std::size_t DEFAULT_UNDO_MEMORY_BUDGET;    // budget di default della memoria della cronologia Undo/Redo (in byte)
+
     // === COSTRUTTORE ===
 
     /**
@@ -185,6 +202,21 @@ public:
      */
     bool removeMediaAtCurrentIndex();
 
+    /**
+     * @brief removeMediaByIDs : rimuove piu' media in un solo passaggio, come un'unica operazione annullabile
+     * @param ids : identificatori univoci dei media da rimuovere (quelli non presenti vengono ignorati)
+     * @return unsigned int : numero di media rimossi
+     */
+    unsigned int removeMediaByIDs(const std::vector<unsigned int>& ids);
+
+    /**
+     * @brief removeMediaByQuery : rimuove tutti i media trovati da una ricerca in un solo passaggio, come un'unica operazione annullabile
+     * @param query : filtri con cui selezionare i media da rimuovere
+     * @param threadCount : numero massimo di thread da utilizzare per la ricerca (1 per la ricerca seriale)
+     * @return unsigned int : numero di media rimossi
+     */
+    unsigned int removeMediaByQuery(const SearchQuery& query, unsigned int threadCount = 1);
+
 
     // === MODIFICA ===
 
@@ -205,6 +237,16 @@ public:
      */
     bool editMediaAtCurrentIndex(const std::unordered_map<std::string, std::string>& mediaEdits);
 
+    /**
+     * @brief editMediaByQuery : applica la stessa mappa di modifiche a tutti i media trovati da una ricerca, in parallelo, come un'unica operazione annullabile
+     * @param query : filtri con cui selezionare i media da modificare
+     * @param mediaEdits : mappa delle modifiche da applicare a ciascun media
+     * @param threadCount : numero massimo di thread da utilizzare per ricerca e modifica (1 per l'esecuzione seriale)
+     * @return std::vector : media la cui modifica non ha avuto successo (e che restano invariati), come coppie (identificatore univoco, messaggio d'errore)
+     */
+    std::vector<std::pair<unsigned int, std::string>> editMediaByQuery(const SearchQuery& query, const std::unordered_map<std::string, std::string>& mediaEdits,
+                                                                       unsigned int threadCount = 1);
+
 
     // === CREAZIONE ===
 
@@ -223,9 +265,22 @@ public:
     /**
      * @brief searchMedia : ricerca dei media in base a filtri (impostati da SearchQuery)
      * @param query : filtri da applicare nell'operazione di ricerca
-     * @return std::vector<unsigned int> : vettore contenente gli identificatori univoci dei media trovati
+     * @param threadCount : numero massimo di thread da usare per la ricerca (default 1, ricerca seriale)
+     * @param cancelled : flag di annullamento (opzionale), se impostato durante la ricerca questa si interrompe con risultati parziali
+     * @return std::vector<unsigned int> : vettore contenente gli identificatori univoci dei media trovati, nello stesso ordine per qualsiasi numero di thread
      */
-    std::vector<unsigned int> searchMedia(const SearchQuery& query) const;
+    std::vector<unsigned int> searchMedia(const SearchQuery& query, unsigned int threadCount = 1, const std::atomic<bool>* cancelled = nullptr) const;
+
+    /**
+     * @brief narrowSearch : ripete una ricerca solo sui risultati di una ricerca precedente (vedi Library::narrowSearchResults)
+     * @param query : filtri da applicare, piu' restrittivi di quelli della ricerca precedente
+     * @param previousIDs : identificatori univoci trovati dalla ricerca precedente
+     * @param threadCount : numero massimo di thread da usare per la ricerca (default 1, ricerca seriale)
+     * @param cancelled : flag di annullamento (opzionale)
+     * @return std::vector<unsigned int> : identificatori univoci dei media trovati
+     */
+    std::vector<unsigned int> narrowSearch(const SearchQuery& query, const std::vector<unsigned int>& previousIDs, unsigned int threadCount = 1,
+                                           const std::atomic<bool>* cancelled = nullptr) const;
 
     /**
      * @brief getSearchResultIndexesByID : restituisce i corrispondenti indici in libreria a partire dai identificatori dei media trovati nella ricerca
@@ -235,21 +290,75 @@ public:
     std::vector<unsigned int> getSearchResultIndexesByID(const std::vector<unsigned int>& mediaIDs) const;
 
 
+    // === SNAPSHOT COLONNARE ===
+
+    /**
+     * @brief setColumnSnapshotEnabled : attiva o disattiva lo snapshot colonnare della libreria (usato da ricerca e analisi sui valori numerici)
+     * @param enabled : true per attivarlo, false per disattivarlo
+     */
+    void setColumnSnapshotEnabled(bool enabled);
+
+    /**
+     * @brief isColumnSnapshotEnabled : verifica se lo snapshot colonnare della libreria e' attivo
+     * @return bool : true se attivo, false altrimenti
+     */
+    bool isColumnSnapshotEnabled() const;
+
+
     // === JSON ===
 
     /**
      * @brief saveContentsToFile : salva la i contenuti correnti della libreria su file in formato JSON
      * @param filename : path del file a cui salvare i contenuti
+     * @param compact : true per il formato JSON compatto, false (default) per il formato indentato
+     * @param progress : notifica dell'avanzamento (vedi Library::saveToFile), opzionale
      * @return bool : true se l'operazione ha successo, false altrimenti
+     * @details salvando sullo stesso file, vengono scritte nel journal del file solo le modifiche successive all'ultimo salvataggio (vedi Library::saveToFile)
      */
-    bool saveContentsToFile(const QString& filename) const;
+    bool saveContentsToFile(const QString& filename, bool compact = false, const Library::ProgressCallback& progress = nullptr) const;
 
     /**
      * @brief loadContentsFromFile : carica media nella libreria da file in formato JSON
      * @param filename : path del file da cui caricare
+     * @param threadCount : numero massimo di thread da utilizzare per la costruzione dei media (1 per il caricamento seriale)
+     * @param progress : notifica dell'avanzamento (vedi Library::loadFromFile), opzionale
      * @return  bool : true se l'operazione ha successo, false altrimenti
+     * @details le modifiche salvate nel journal del file vengono riapplicate dopo il caricamento
+     */
+    bool loadContentsFromFile(const QString& filename, unsigned int threadCount = 1, const Library::ProgressCallback& progress = nullptr);
+
+    /**
+     * @brief saveContentsToBinary : salva i contenuti correnti della libreria su file nel formato binario (vedi Library::saveBinary)
+     * @param filename : path del file a cui salvare i contenuti
+     * @return bool : true se l'operazione ha successo, false altrimenti
      */
-    bool loadContentsFromFile(const QString& filename);
+    bool saveContentsToBinary(const QString& filename) const;
+
+    /**
+     * @brief loadContentsFromBinary : carica media nella libreria da file nel formato binario (vedi Library::loadBinary)
+     * @param filename : path del file da cui caricare
+     * @return bool : true se l'operazione ha successo, false altrimenti
+     */
+    bool loadContentsFromBinary(const QString& filename);
+
+    /**
+     * @brief openContentsMapped : apre un file nel formato binario mappandolo in memoria, i media vengono letti al primo accesso (vedi Library::openMapped)
+     * @param filename : path del file da aprire
+     * @return bool : true se l'operazione ha successo, false altrimenti
+     */
+    bool openContentsMapped(const QString& filename);
+
+    /**
+     * @brief isContentsMapped : verifica se i media della libreria sono letti da un file mappato (vedi Library::isMapped)
+     * @return bool : true se la libreria e' in modalita' mappata, false altrimenti
+     */
+    bool isContentsMapped() const;
+
+    /**
+     * @brief replaceContents : sostituisce i contenuti della libreria con quelli di una libreria caricata separatamente (ad esempio da un thread secondario)
+     * @param loaded : libreria caricata, che resta vuota (vedi Library::takeContents)
+     */
+    void replaceContents(Library& loaded);
 
 
     // === SCORING ===
@@ -275,6 +384,34 @@ public:
      */
     std::string getMediaScoreInfoAtIndex(unsigned int ind) const;
 
+    /**
+     * @brief precomputeMediaScores : calcola in blocco gli score di tutti i media della libreria (salvati nella cache della libreria)
+     * @details utile prima di operazioni che richiedono lo score di molti media, ad esempio l'ordinamento per score
+     */
+    void precomputeMediaScores() const;
+
+    /**
+     * @brief scoreAll : calcola in blocco lo score numerico di tutti i media (vedi Library::scoreAll)
+     * @return std::vector<float> : score dei media, nell'ordine della libreria
+     */
+    std::vector<float> scoreAll() const;
+
+    /**
+     * @brief scoreRange : calcola in blocco lo score numerico dei media tra due indici (vedi Library::scoreRange)
+     * @param first : primo indice
+     * @param last : indice successivo all'ultimo
+     * @return std::vector<float> : score dei media, l'elemento 'i' corrisponde all'indice 'first + i'
+     */
+    std::vector<float> scoreRange(unsigned int first, unsigned int last) const;
+
+    /**
+     * @brief getTopScoredMedia : restituisce i 'k' media con score piu' alto, eventualmente filtrati da una ricerca (vedi Library::getTopScoredMedia)
+     * @param k : numero massimo di media da restituire
+     * @param query : filtri di ricerca (nessun filtro per considerare tutti i media)
+     * @return std::vector<unsigned int> : identificatori univoci dei media, in ordine di score decrescente
+     */
+    std::vector<unsigned int> getTopScoredMedia(unsigned int k, const SearchQuery& query = SearchQuery()) const;
+
 
     // === COMMAND ===
 
@@ -311,6 +448,72 @@ public:
      */
     void clearCommandOperations();
 
+    /**
+     * @brief setUndoMemoryBudget : imposta la memoria massima della cronologia Undo/Redo, scartando subito i comandi piu' vecchi se necessario
+     * @param bytes : budget di memoria (in byte)
+     */
+    void setUndoMemoryBudget(std::size_t bytes);
+
+    /**
+     * @brief getUndoMemoryBudget : restituisce la memoria massima della cronologia Undo/Redo
+     * @return std::size_t : budget di memoria (in byte)
+     */
+    std::size_t getUndoMemoryBudget() const;
+
+    /**
+     * @brief getUndoMemoryUsage : restituisce la memoria stimata della cronologia Undo/Redo attuale
+     * @return std::size_t : memoria stimata (in byte)
+     */
+    std::size_t getUndoMemoryUsage() const;
+
+
+    // === BATCH ===
+
+    /**
+     * @brief beginBatch : apre un batch (transazione) in cui accodare operazioni, scartando un eventuale batch aperto e non confermato
+     */
+    void beginBatch();
+
+    /**
+     * @brief isBatchOpen : verifica se c'e' un batch aperto
+     * @return bool : true se c'e' un batch aperto, false altrimenti
+     */
+    bool isBatchOpen() const;
+
+    /**
+     * @brief queueInsert : accoda al batch aperto l'inserimento di un media (in fondo alla libreria)
+     * @param media : smart pointer al media da inserire
+     * @return bool : true se l'operazione e' stata accodata, false se non c'e' un batch aperto
+     */
+    bool queueInsert(const std::shared_ptr<Media::AbstractMedia>& media);
+
+    /**
+     * @brief queueEdit : accoda al batch aperto la modifica di un media
+     * @param id : identificatore univoco del media da modificare
+     * @param mediaEdits : mappa di modifiche
+     * @return bool : true se l'operazione e' stata accodata, false se non c'e' un batch aperto
+     */
+    bool queueEdit(unsigned int id, const std::unordered_map<std::string, std::string>& mediaEdits);
+
+    /**
+     * @brief queueRemove : accoda al batch aperto la rimozione di un media
+     * @param id : identificatore univoco del media da rimuovere
+     * @return bool : true se l'operazione e' stata accodata, false se non c'e' un batch aperto
+     */
+    bool queueRemove(unsigned int id);
+
+    /**
+     * @brief commitBatch : valida ed esegue tutte le operazioni del batch aperto come un'unica operazione annullabile, e chiude il batch
+     * @return bool : true se il batch e' stato eseguito (o era vuoto), false se non c'e' un batch aperto
+     * @throws MediaValidatorException se la validazione o un'operazione fallisce (in tal caso la libreria resta invariata)
+     */
+    bool commitBatch();
+
+    /**
+     * @brief cancelBatch : chiude il batch aperto senza eseguire le operazioni accodate
+     */
+    void cancelBatch();
+
 
     // == LOGGING ===
 
@@ -320,6 +523,12 @@ public:
      */
     void setLibraryLogger(Model::Loggers::IMediaLogger* newLogger);
 
+    /**
+     * @brief getLibraryLogger : restituisce il logger associato alla libreria
+     * @return Loggers::IMediaLogger* : puntatore al logger associato
+     */
+    Model::Loggers::IMediaLogger* getLibraryLogger() const;
+
     /**
      * @brief getLogLevel : restituisce il livello di severita' logging della liberia
      * @return LogLevel : livello di severita' logging (definito in Loggers::LogLevel)
@@ -332,14 +541,32 @@ public:
      */
     void setLogLevel(Model::Loggers::LogLevel level);
 
+
+    // === OSSERVATORE ===
+
+    /**
+     * @brief setLibraryObserver : associa alla libreria un osservatore, notificato per ogni media inserito, rimosso o modificato
+     *                             dall'esecuzione, annullamento o ripristino dei comandi
+     * @param observer : osservatore da associare ('nullptr' per nessun osservatore)
+     */
+    void setLibraryObserver(ILibraryObserver* observer);
+
 private:
 
     Library mediaLibrary;                                                   // libreria dei media
     unsigned int currentIndex;                                              // indice di media corrente
-    std::vector<std::shared_ptr<Command::IAbstractCommand>> undoCommands;   // vettore di smart pointer di command Undo
-    std::vector<std::shared_ptr<Command::IAbstractCommand>> redoCommands;   // vettore di smart pointer di command Redo
+    std::deque<std::shared_ptr<Command::IAbstractCommand>> undoCommands;    // coda di smart pointer di command Undo (il piu' vecchio in testa)
+    std::deque<std::shared_ptr<Command::IAbstractCommand>> redoCommands;    // coda di smart pointer di command Redo
     std::string lastUndoDescription;                                        // dettagli ultimo Undo
     std::string lastRedoDescription;                                        // dettagli ultimo Redo
+    std::size_t undoMemoryBudget;                                           // memoria massima della cronologia Undo/Redo (in byte)
+    std::size_t undoMemoryUsage;                                            // memoria stimata della cronologia Undo/Redo (in byte)
+    std::shared_ptr<Command::BatchCommand> openBatch;                       // batch aperto (nullptr se non ce n'e' uno)
+
+    /**
+     * @brief enforceUndoMemoryBudget : scarta i comandi Redo piu' lontani e poi i comandi Undo piu' vecchi finche' la cronologia non rientra nel budget
+     */
+    void enforceUndoMemoryBudget();
 };
 
 }
@@ -0,0 +1,339 @@
+#include "MappedSnapshot.h"
+#include "Model/Library/BinarySnapshot.h"
+#include "Model/Media/AbstractFile.h"
+#include "Model/Visitors/MediaValidator.h"
+
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+
+
+namespace Model {
+namespace Library {
+
+namespace {
+
+// esito memorizzato del confronto tra una stringa della tabella e un filtro testuale
+const std::uint8_t TEXT_UNKNOWN = 0;
+const std::uint8_t TEXT_MATCH = 1;
+const std::uint8_t TEXT_NO_MATCH = 2;
+
+/** @brief RecordMatcher : verifica dei filtri di SearchVisitor sul contenuto di un record, senza materializzare il media */
+class RecordMatcher {
+
+public:
+
+    RecordMatcher(const SearchQuery& searchQuery, std::size_t tableSize, std::function<std::string(std::uint32_t)> tableLookup)
+        : query(searchQuery),
+        lookup(std::move(tableLookup)),
+        name(searchQuery.getMediaName(), tableSize),
+        uploader(searchQuery.getMediaUploader(), tableSize),
+        format(searchQuery.getMediaFormat(), tableSize),
+        genre(searchQuery.getMediaGenre(), tableSize),
+        artist(searchQuery.getAudioArtist(), tableSize),
+        director(searchQuery.getVideoDirector(), tableSize),
+        author(searchQuery.getEBookAuthor(), tableSize),
+        publisher(searchQuery.getEBookPublisher(), tableSize),
+        creator(searchQuery.getImageCreator(), tableSize),
+        location(searchQuery.getImageLocation(), tableSize)
+    {
+        static const char* const TYPE_NAMES[] = { "AUDIO", "VIDEO", "EBOOK", "IMAGE" };
+        for (unsigned int t = 0; t < 4; ++t) {
+            // per il tipo serve match esatto
+            typeAllowed[t] = query.getMediaType().empty() || SearchQuery::checkExactMatch(query.getMediaType(), TYPE_NAMES[t]);
+        }
+    }
+
+    bool allowsType(std::uint8_t type) const { return typeAllowed[type]; }
+
+    /**
+     * @brief matches : verifica un record, leggendo i campi nell'ordine di SnapshotEncoder
+     * @throws std::runtime_error : se il record e' troncato
+     */
+    bool matches(BinarySnapshot::RecordType type, BinarySnapshot::RecordReader& reader) {
+
+        // campi comuni
+        reader.readU32();           // identificatore salvato
+        reader.readStringIndex();   // path
+        float size = reader.readF32();
+        std::uint32_t nameIndex = reader.readStringIndex();
+        std::uint32_t uploaderIndex = reader.readStringIndex();
+        std::uint32_t formatIndex = reader.readStringIndex();
+        unsigned int rating = reader.readU32();
+
+        if (query.getMinimumMediaRating() != 0 && rating < query.getMinimumMediaRating()) return false;
+        if (query.getMaximumMediaRating() != 0 && rating > query.getMaximumMediaRating()) return false;
+        if (!SearchQuery::checkRange(size, query.getMinimumFileSize(), query.getMaximumFileSize())) return false;
+        if (!checkText(name, nameIndex) || !checkText(uploader, uploaderIndex) || !checkText(format, formatIndex)) return false;
+
+        switch (type) {
+
+        case BinarySnapshot::RecordType::Audio: {
+            std::uint32_t artistIndex = reader.readStringIndex();
+            std::uint32_t genreIndex = reader.readStringIndex();
+            reader.readStringIndex();   // album
+            unsigned int year = reader.readU32();
+            unsigned int length = reader.readU32();
+            unsigned int bitRate = reader.readU32();
+            return checkText(artist, artistIndex) && checkText(genre, genreIndex)
+                   && SearchQuery::checkRange(year, query.getMinimumReleaseYear(), query.getMaximumReleaseYear())
+                   && SearchQuery::checkRange(length, query.getMinimumLength(), query.getMaximumLength())
+                   && SearchQuery::checkRange(bitRate, query.getMinimumBitRate(), query.getMaximumBitRate());
+        }
+        case BinarySnapshot::RecordType::Video: {
+            std::uint32_t directorIndex = reader.readStringIndex();
+            std::uint32_t genreIndex = reader.readStringIndex();
+            unsigned int year = reader.readU32();
+            unsigned int length = reader.readU32();
+            reader.readU32();           // framerate
+            reader.readI32();           // larghezza
+            int height = reader.readI32();
+            return checkText(director, directorIndex) && checkText(genre, genreIndex)
+                   && SearchQuery::checkRange(year, query.getMinimumReleaseYear(), query.getMaximumReleaseYear())
+                   && SearchQuery::checkRange(length, query.getMinimumLength(), query.getMaximumLength())
+                   && SearchQuery::checkRange(height, static_cast<int>(query.getMinimumResolution()), static_cast<int>(query.getMaximumResolution()));
+        }
+        case BinarySnapshot::RecordType::EBook: {
+            std::uint32_t authorIndex = reader.readStringIndex();
+            std::uint32_t publisherIndex = reader.readStringIndex();
+            unsigned int year = reader.readU32();
+            reader.readStringIndex();   // ISBN
+            unsigned int length = reader.readU32();
+            return checkText(author, authorIndex) && checkText(publisher, publisherIndex)
+                   && SearchQuery::checkRange(year, query.getMinimumReleaseYear(), query.getMaximumReleaseYear())
+                   && SearchQuery::checkRange(length, query.getMinimumLength(), query.getMaximumLength());
+        }
+        case BinarySnapshot::RecordType::Image: {
+            reader.readStringIndex();   // data di creazione
+            std::uint32_t creatorIndex = reader.readStringIndex();
+            reader.readStringIndex();   // categoria
+            reader.readI32();           // larghezza
+            int height = reader.readI32();
+            reader.readI32();           // aspect ratio
+            reader.readI32();
+            reader.readU32();           // bitdepth
+            reader.readU8();            // compressione
+            std::uint32_t locationIndex = reader.readStringIndex();
+            return checkText(creator, creatorIndex) && checkText(location, locationIndex)
+                   && SearchQuery::checkRange(height, static_cast<int>(query.getMinimumResolution()), static_cast<int>(query.getMaximumResolution()));
+        }
+        }
+        return false;
+    }
+
+private:
+
+    /** @brief TextFilter : filtro testuale, con l'esito del confronto per ciascuna stringa della tabella (allocato solo se il filtro e' impostato) */
+    struct TextFilter {
+        TextFilter(const std::string& filterValue, std::size_t tableSize)
+            : value(filterValue),
+            results(filterValue.empty() ? 0 : tableSize, TEXT_UNKNOWN)
+        {}
+        const std::string& value;
+        std::vector<std::uint8_t> results;
+    };
+
+    const SearchQuery& query;
+    std::function<std::string(std::uint32_t)> lookup;
+    bool typeAllowed[4];
+    TextFilter name, uploader, format, genre, artist, director, author, publisher, creator, location;
+
+    bool checkText(TextFilter& filter, std::uint32_t index) {
+
+        if (filter.value.empty()) return true;
+        std::uint8_t& result = filter.results[index];
+        if (result == TEXT_UNKNOWN) {
+            result = SearchQuery::checkPartialMatch(lookup(index), filter.value) ? TEXT_MATCH : TEXT_NO_MATCH;
+        }
+        return result == TEXT_MATCH;
+    }
+};
+
+}
+
+
+// === COSTRUTTORE / DISTRUTTORE ===
+
+MappedSnapshot::MappedSnapshot()
+    : mappedData(nullptr),
+    mappedSize(0),
+    skippedRecords(0),
+    firstUniqueID(Media::AbstractFile::INVALID_UNIQUE_ID)
+{}
+
+MappedSnapshot::~MappedSnapshot() { close(); }
+
+
+// === APERTURA ===
+
+void MappedSnapshot::open(const QString& filename) {
+
+    close();
+
+    file.setFileName(filename);
+    if (!file.open(QIODevice::ReadOnly)) {
+        throw std::runtime_error("Could not open file\n");
+    }
+    const qint64 fileSize = file.size();
+    unsigned char* data = fileSize > 0 ? file.map(0, fileSize) : nullptr;
+    if (!data) {
+        file.close();
+        throw std::runtime_error("Could not map file into memory\n");
+    }
+    mappedData = reinterpret_cast<const char*>(data);
+    mappedSize = static_cast<std::size_t>(fileSize);
+
+    try {
+        BinarySnapshot::indexSnapshot(mappedData, mappedSize, stringOffsets, recordOffsets, skippedRecords);
+    }
+    catch (const std::runtime_error&) {
+        close();
+        throw;
+    }
+
+    // un identificatore riservato per ogni record
+    firstUniqueID = Media::AbstractFile::uniqueIDCounter;
+    Media::AbstractFile::uniqueIDCounter += static_cast<unsigned int>(recordOffsets.size());
+}
+
+void MappedSnapshot::close() {
+
+    materialized.clear();
+    std::vector<std::uint64_t>().swap(stringOffsets);
+    std::vector<std::uint64_t>().swap(recordOffsets);
+    if (mappedData) {
+        file.unmap(reinterpret_cast<unsigned char*>(const_cast<char*>(mappedData)));
+    }
+    file.close();
+    mappedData = nullptr;
+    mappedSize = 0;
+    skippedRecords = 0;
+    firstUniqueID = Media::AbstractFile::INVALID_UNIQUE_ID;
+}
+
+bool MappedSnapshot::isOpen() const { return mappedData != nullptr; }
+
+
+// === GETTER ===
+
+unsigned int MappedSnapshot::getRecordCount() const { return static_cast<unsigned int>(recordOffsets.size()); }
+
+unsigned int MappedSnapshot::getSkippedRecordCount() const { return skippedRecords; }
+
+unsigned int MappedSnapshot::getMaterializedCount() const { return static_cast<unsigned int>(materialized.size()); }
+
+unsigned int MappedSnapshot::getFirstUniqueID() const { return firstUniqueID; }
+
+const char* MappedSnapshot::getMappedData() const { return mappedData; }
+
+std::size_t MappedSnapshot::getMappedSize() const { return mappedSize; }
+
+unsigned int MappedSnapshot::getUniqueIDAt(unsigned int ind) const { return firstUniqueID + ind; }
+
+unsigned int MappedSnapshot::getIndexByID(unsigned int id) const {
+
+    if (!isOpen() || id < firstUniqueID || id - firstUniqueID >= getRecordCount()) {
+        return getRecordCount();
+    }
+    return id - firstUniqueID;
+}
+
+
+// === MATERIALIZZAZIONE ===
+
+std::shared_ptr<Media::AbstractMedia> MappedSnapshot::getMediaAt(unsigned int ind) const {
+
+    if (ind >= getRecordCount()) return nullptr;
+
+    auto found = materialized.find(ind);
+    if (found != materialized.end()) {
+        return found->second;
+    }
+    auto media = decodeRecordAt(ind);
+    materialized.emplace(ind, media);
+    return media;
+}
+
+std::shared_ptr<Media::AbstractMedia> MappedSnapshot::decodeMediaAt(unsigned int ind) const {
+
+    if (ind >= getRecordCount()) return nullptr;
+
+    auto found = materialized.find(ind);
+    return found != materialized.end() ? found->second : decodeRecordAt(ind);
+}
+
+
+// === RICERCA ===
+
+std::vector<unsigned int> MappedSnapshot::searchRecords(const SearchQuery& query, const std::atomic<bool>* cancelled) const {
+
+    std::vector<unsigned int> matches;
+    if (!isOpen()) return matches;
+
+    // filtro per identificatore: al piu' un record da verificare
+    unsigned int first = 0;
+    unsigned int last = getRecordCount();
+    if (query.getMediaID() != 0) {
+        first = getIndexByID(query.getMediaID());
+        last = std::min(first + 1, getRecordCount());
+    }
+
+    RecordMatcher matcher(query, stringOffsets.size(), [this](std::uint32_t index) { return getTableString(index); });
+    for (unsigned int i = first; i < last; ++i) {
+
+        if (cancelled && (i - first) % 1024 == 0 && cancelled->load(std::memory_order_relaxed)) {
+            break;
+        }
+        const char* record = mappedData + recordOffsets[i];
+        std::uint8_t type = static_cast<std::uint8_t>(record[0]);
+        if (!matcher.allowsType(type)) continue;
+
+        BinarySnapshot::RecordReader reader(mappedData, stringOffsets, record + BinarySnapshot::RECORD_HEADER_SIZE, BinarySnapshot::loadU32(record + 1));
+        try {
+            if (matcher.matches(static_cast<BinarySnapshot::RecordType>(type), reader)) {
+                matches.push_back(getUniqueIDAt(i));
+            }
+        }
+        catch (const std::runtime_error&) {
+            // record troncato, non puo' essere materializzato e quindi non viene trovato
+        }
+    }
+    return matches;
+}
+
+
+// === METODI AUSILIARI ===
+
+std::shared_ptr<Media::AbstractMedia> MappedSnapshot::decodeRecordAt(unsigned int ind) const {
+
+    const char* record = mappedData + recordOffsets[ind];
+    BinarySnapshot::RecordReader reader(mappedData, stringOffsets, record + BinarySnapshot::RECORD_HEADER_SIZE, BinarySnapshot::loadU32(record + 1));
+
+    // il costruttore del media usa il valore corrente del contatore, che viene quindi portato all'identificatore riservato al record
+    // e poi ripristinato (mantenendo un eventuale valore maggiore impostato da SnapshotDecoder con l'identificatore salvato)
+    const unsigned int counter = Media::AbstractFile::uniqueIDCounter;
+    Media::AbstractFile::uniqueIDCounter = getUniqueIDAt(ind);
+    std::shared_ptr<Media::AbstractMedia> media;
+    try {
+        media = BinarySnapshot::decodeRecord(static_cast<BinarySnapshot::RecordType>(record[0]), reader);
+    }
+    catch (const std::runtime_error&) {
+        Media::AbstractFile::uniqueIDCounter = std::max(counter, Media::AbstractFile::uniqueIDCounter);
+        throw;
+    }
+    Media::AbstractFile::uniqueIDCounter = std::max(counter, Media::AbstractFile::uniqueIDCounter);
+
+    // un record non valido (file corrotto o modificato) viene trattato come illeggibile: MediaValidatorException deriva da std::runtime_error
+    Visitors::MediaValidator validator;
+    media->accept(validator);
+    return media;
+}
+
+std::string MappedSnapshot::getTableString(std::uint32_t index) const {
+
+    const char* entry = mappedData + stringOffsets[index];
+    return std::string(entry + 4, BinarySnapshot::loadU32(entry));
+}
+
+}
+}
@@ -0,0 +1,152 @@
+#ifndef MODEL_LIBRARY_MAPPED_SNAPSHOT_H
+#define MODEL_LIBRARY_MAPPED_SNAPSHOT_H
+
+#include "Model/Media/AbstractMedia.h"
+#include "Model/Library/SearchQuery.h"
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <cstddef>
+#include <unordered_map>
+#include <atomic>
+
+#include <QFile>
+#include <QString>
+
+/** @brief MappedSnapshot
+ *
+ *  MappedSnapshot permette di usare un file nel formato di BinarySnapshot senza caricarlo: il file viene mappato in memoria e all'apertura
+ *  vengono solo verificati i prefissi di lunghezza e costruite due tabelle compatte con la posizione di ciascuna stringa e di ciascun record.
+ *  Il costo dell'apertura dipende quindi dal numero di record e non dalla dimensione del file, e la memoria residente cresce solo con le
+ *  pagine del file effettivamente lette.
+ *
+ *  I media vengono materializzati (decodificati in oggetti AbstractMedia) solo al primo accesso, e conservati per gli accessi successivi.
+ *  La ricerca viene invece eseguita direttamente sui byte mappati, leggendo solo i campi richiesti dai filtri, senza materializzare i media.
+ *
+ *  Per avere identificatori stabili senza materializzare i media, all'apertura viene riservato un intervallo di identificatori univoci
+ *  (uno per record): il record in posizione 'i' corrisponde sempre al media con identificatore 'getFirstUniqueID() + i'.
+ *
+ *  MappedSnapshot e' in sola lettura e non e' protetto da accessi concorrenti (la materializzazione usa il contatore statico degli identificatori).
+ */
+
+namespace Model {
+namespace Library {
+
+class MappedSnapshot {
+
+public:
+
+    // === COSTRUTTORE / DISTRUTTORE ===
+
+    MappedSnapshot();
+    ~MappedSnapshot();
+
+    MappedSnapshot(const MappedSnapshot&) = delete;
+    MappedSnapshot& operator=(const MappedSnapshot&) = delete;
+
+
+    // === APERTURA ===
+
+    /**
+     * @brief open : apre e mappa in memoria un file snapshot, costruendo le tabelle delle posizioni di stringhe e record
+     * @param filename : file da aprire
+     * @throws std::runtime_error : se il file non puo' essere aperto o mappato, oppure non e' uno snapshot valido
+     */
+    void open(const QString& filename);
+
+    /** @brief close : rilascia i media materializzati e la mappatura del file */
+    void close();
+
+    bool isOpen() const;
+
+
+    // === GETTER ===
+
+    unsigned int getRecordCount() const;
+    unsigned int getSkippedRecordCount() const;
+    unsigned int getMaterializedCount() const;
+    unsigned int getFirstUniqueID() const;
+
+    /** @brief getMappedData : contenuto del file mappato (valido fino alla chiusura) */
+    const char* getMappedData() const;
+    std::size_t getMappedSize() const;
+
+    /**
+     * @brief getUniqueIDAt : restituisce l'identificatore univoco del media in una posizione, senza materializzarlo
+     * @param ind : posizione del record
+     * @return unsigned int : identificatore univoco
+     */
+    unsigned int getUniqueIDAt(unsigned int ind) const;
+
+    /**
+     * @brief getIndexByID : restituisce la posizione del record con un dato identificatore univoco
+     * @param id : identificatore univoco
+     * @return unsigned int : posizione del record, altrimenti il numero di record
+     */
+    unsigned int getIndexByID(unsigned int id) const;
+
+
+    // === MATERIALIZZAZIONE ===
+
+    /**
+     * @brief getMediaAt : restituisce il media in una posizione, materializzandolo al primo accesso
+     * @param ind : posizione del record
+     * @return std::shared_ptr<AbstractMedia> : media (sempre lo stesso oggetto per la stessa posizione), 'nullptr' se la posizione non e' valida
+     * @throws std::runtime_error : se il record e' troncato o il media decodificato non e' valido
+     */
+    std::shared_ptr<Media::AbstractMedia> getMediaAt(unsigned int ind) const;
+
+    /**
+     * @brief decodeMediaAt : decodifica il media in una posizione senza conservarlo (usato per le letture in blocco)
+     * @param ind : posizione del record
+     * @return std::shared_ptr<AbstractMedia> : media materializzato se presente, altrimenti una nuova copia decodificata con lo stesso identificatore
+     * @throws std::runtime_error : se il record e' troncato o il media decodificato non e' valido
+     */
+    std::shared_ptr<Media::AbstractMedia> decodeMediaAt(unsigned int ind) const;
+
+
+    // === RICERCA ===
+
+    /**
+     * @brief searchRecords : effettua una ricerca direttamente sui record mappati, con gli stessi criteri di SearchVisitor
+     * @param query : filtri di ricerca
+     * @param cancelled : flag di annullamento (opzionale), se impostato la ricerca si interrompe restituendo risultati parziali
+     * @return std::vector<unsigned int> : identificatori univoci dei media trovati, nell'ordine del file
+     * @details i campi testuali vengono confrontati una sola volta per stringa distinta della tabella; i record troncati non vengono trovati
+     */
+    std::vector<unsigned int> searchRecords(const SearchQuery& query, const std::atomic<bool>* cancelled = nullptr) const;
+
+
+private:
+
+    QFile file;                                                                             // file mappato
+    const char* mappedData;                                                                 // inizio della mappatura
+    std::size_t mappedSize;                                                                 // lunghezza della mappatura
+    std::vector<std::uint64_t> stringOffsets;                                               // posizione di ciascuna stringa della tabella
+    std::vector<std::uint64_t> recordOffsets;                                               // posizione di ciascun record (di tipo noto)
+    unsigned int skippedRecords;                                                            // record di tipo sconosciuto
+    unsigned int firstUniqueID;                                                             // identificatore riservato al primo record
+    mutable std::unordered_map<unsigned int, std::shared_ptr<Media::AbstractMedia>> materialized;  // posizione -> media materializzato
+
+    /**
+     * @brief decodeRecordAt : decodifica il record in una posizione, assegnando al media l'identificatore riservato, e lo valida con MediaValidator
+     * @param ind : posizione del record
+     * @return std::shared_ptr<AbstractMedia> : nuovo media decodificato
+     * @throws std::runtime_error : se il record e' troncato o il media decodificato non e' valido
+     */
+    std::shared_ptr<Media::AbstractMedia> decodeRecordAt(unsigned int ind) const;
+
+    /**
+     * @brief getTableString : restituisce una stringa della tabella del file
+     * @param index : indice della stringa
+     * @return std::string : copia della stringa
+     */
+    std::string getTableString(std::uint32_t index) const;
+};
+
+}
+}
+
+#endif // MODEL_LIBRARY_MAPPED_SNAPSHOT_H
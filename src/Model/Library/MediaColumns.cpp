@@ -0,0 +1,356 @@
+#include "MediaColumns.h"
+#include "Model/Visitors/ColumnVisitor.h"
+
+#include <vector>
+#include <memory>
+#include <limits>
+
+
+namespace Model {
+namespace Library {
+
+
+// === AGGIORNAMENTO ===
+
+void MediaColumns::rebuildColumns(const std::vector<std::shared_ptr<Media::AbstractMedia>>& media) {
+
+    clearColumns();
+    for (const auto& m : media) {
+        if (m) {
+            appendRow(*m);
+        }
+    }
+}
+
+void MediaColumns::appendRow(const Media::AbstractMedia& media) {
+
+    Row row = readRow(media);
+    uniqueIDs.push_back(row.uniqueID);
+    typeTags.push_back(row.typeTag);
+    ratings.push_back(row.rating);
+    fileSizes.push_back(row.fileSize);
+    years.push_back(row.year);
+    lengths.push_back(row.length);
+    bitRates.push_back(row.bitRate);
+    widths.push_back(row.width);
+    heights.push_back(row.height);
+    sampleRates.push_back(row.sampleRate);
+    bitDepths.push_back(row.bitDepth);
+    channels.push_back(row.channels);
+    frameRates.push_back(row.frameRate);
+    flags.push_back(row.flags);
+}
+
+void MediaColumns::insertRow(unsigned int pos, const Media::AbstractMedia& media) {
+
+    if (pos >= getRowCount()) {
+        appendRow(media);
+        return;
+    }
+
+    Row row = readRow(media);
+    uniqueIDs.insert(uniqueIDs.begin() + pos, row.uniqueID);
+    typeTags.insert(typeTags.begin() + pos, row.typeTag);
+    ratings.insert(ratings.begin() + pos, row.rating);
+    fileSizes.insert(fileSizes.begin() + pos, row.fileSize);
+    years.insert(years.begin() + pos, row.year);
+    lengths.insert(lengths.begin() + pos, row.length);
+    bitRates.insert(bitRates.begin() + pos, row.bitRate);
+    widths.insert(widths.begin() + pos, row.width);
+    heights.insert(heights.begin() + pos, row.height);
+    sampleRates.insert(sampleRates.begin() + pos, row.sampleRate);
+    bitDepths.insert(bitDepths.begin() + pos, row.bitDepth);
+    channels.insert(channels.begin() + pos, row.channels);
+    frameRates.insert(frameRates.begin() + pos, row.frameRate);
+    flags.insert(flags.begin() + pos, row.flags);
+}
+
+void MediaColumns::updateRow(unsigned int pos, const Media::AbstractMedia& media) {
+
+    if (pos >= getRowCount()) return;
+
+    Row row = readRow(media);
+    uniqueIDs[pos] = row.uniqueID;
+    typeTags[pos] = row.typeTag;
+    ratings[pos] = row.rating;
+    fileSizes[pos] = row.fileSize;
+    years[pos] = row.year;
+    lengths[pos] = row.length;
+    bitRates[pos] = row.bitRate;
+    widths[pos] = row.width;
+    heights[pos] = row.height;
+    sampleRates[pos] = row.sampleRate;
+    bitDepths[pos] = row.bitDepth;
+    channels[pos] = row.channels;
+    frameRates[pos] = row.frameRate;
+    flags[pos] = row.flags;
+}
+
+void MediaColumns::eraseRow(unsigned int pos) {
+
+    if (pos >= getRowCount()) return;
+
+    uniqueIDs.erase(uniqueIDs.begin() + pos);
+    typeTags.erase(typeTags.begin() + pos);
+    ratings.erase(ratings.begin() + pos);
+    fileSizes.erase(fileSizes.begin() + pos);
+    years.erase(years.begin() + pos);
+    lengths.erase(lengths.begin() + pos);
+    bitRates.erase(bitRates.begin() + pos);
+    widths.erase(widths.begin() + pos);
+    heights.erase(heights.begin() + pos);
+    sampleRates.erase(sampleRates.begin() + pos);
+    bitDepths.erase(bitDepths.begin() + pos);
+    channels.erase(channels.begin() + pos);
+    frameRates.erase(frameRates.begin() + pos);
+    flags.erase(flags.begin() + pos);
+}
+
+void MediaColumns::insertRows(const std::vector<unsigned int>& positions, const std::vector<const Media::AbstractMedia*>& media) {
+
+    if (positions.empty() || positions.size() != media.size()) return;
+
+    std::vector<Row> rows;
+    rows.reserve(media.size());
+    for (const Media::AbstractMedia* m : media) {
+        rows.push_back(m ? readRow(*m) : Row());
+    }
+    mergeColumn(uniqueIDs, positions, rows, &Row::uniqueID);
+    mergeColumn(typeTags, positions, rows, &Row::typeTag);
+    mergeColumn(ratings, positions, rows, &Row::rating);
+    mergeColumn(fileSizes, positions, rows, &Row::fileSize);
+    mergeColumn(years, positions, rows, &Row::year);
+    mergeColumn(lengths, positions, rows, &Row::length);
+    mergeColumn(bitRates, positions, rows, &Row::bitRate);
+    mergeColumn(widths, positions, rows, &Row::width);
+    mergeColumn(heights, positions, rows, &Row::height);
+    mergeColumn(sampleRates, positions, rows, &Row::sampleRate);
+    mergeColumn(bitDepths, positions, rows, &Row::bitDepth);
+    mergeColumn(channels, positions, rows, &Row::channels);
+    mergeColumn(frameRates, positions, rows, &Row::frameRate);
+    mergeColumn(flags, positions, rows, &Row::flags);
+}
+
+void MediaColumns::eraseRows(const std::vector<unsigned int>& positions) {
+
+    if (positions.empty()) return;
+
+    compactColumn(uniqueIDs, positions);
+    compactColumn(typeTags, positions);
+    compactColumn(ratings, positions);
+    compactColumn(fileSizes, positions);
+    compactColumn(years, positions);
+    compactColumn(lengths, positions);
+    compactColumn(bitRates, positions);
+    compactColumn(widths, positions);
+    compactColumn(heights, positions);
+    compactColumn(sampleRates, positions);
+    compactColumn(bitDepths, positions);
+    compactColumn(channels, positions);
+    compactColumn(frameRates, positions);
+    compactColumn(flags, positions);
+}
+
+void MediaColumns::clearColumns() {
+
+    uniqueIDs.clear();
+    typeTags.clear();
+    ratings.clear();
+    fileSizes.clear();
+    years.clear();
+    lengths.clear();
+    bitRates.clear();
+    widths.clear();
+    heights.clear();
+    sampleRates.clear();
+    bitDepths.clear();
+    channels.clear();
+    frameRates.clear();
+    flags.clear();
+}
+
+
+// === GETTER ===
+
+unsigned int MediaColumns::getRowCount() const { return uniqueIDs.size(); }
+const std::vector<unsigned int>& MediaColumns::getUniqueIDs() const { return uniqueIDs; }
+const std::vector<MediaColumns::TypeTag>& MediaColumns::getTypeTags() const { return typeTags; }
+const std::vector<unsigned int>& MediaColumns::getRatings() const { return ratings; }
+const std::vector<float>& MediaColumns::getFileSizes() const { return fileSizes; }
+const std::vector<unsigned int>& MediaColumns::getYears() const { return years; }
+const std::vector<unsigned int>& MediaColumns::getLengths() const { return lengths; }
+const std::vector<unsigned int>& MediaColumns::getBitRates() const { return bitRates; }
+const std::vector<int>& MediaColumns::getWidths() const { return widths; }
+const std::vector<int>& MediaColumns::getHeights() const { return heights; }
+const std::vector<float>& MediaColumns::getSampleRates() const { return sampleRates; }
+const std::vector<unsigned int>& MediaColumns::getBitDepths() const { return bitDepths; }
+const std::vector<unsigned int>& MediaColumns::getChannels() const { return channels; }
+const std::vector<unsigned int>& MediaColumns::getFrameRates() const { return frameRates; }
+const std::vector<std::uint8_t>& MediaColumns::getFlags() const { return flags; }
+
+
+// === FILTRI NUMERICI ===
+
+void MediaColumns::selectBitmap(const SearchQuery& query, FilterKernels::Bitmap& bits) const {
+
+    // maschere dei tipi che possiedono ciascun attributo
+    const std::uint8_t allTypes = 0xF;
+    const std::uint8_t withYear = (1u << static_cast<unsigned int>(TypeTag::Audio)) | (1u << static_cast<unsigned int>(TypeTag::Video)) |
+                                  (1u << static_cast<unsigned int>(TypeTag::EBook));
+    const std::uint8_t withLength = withYear;
+    const std::uint8_t withBitRate = 1u << static_cast<unsigned int>(TypeTag::Audio);
+    const std::uint8_t withResolution = (1u << static_cast<unsigned int>(TypeTag::Video)) | (1u << static_cast<unsigned int>(TypeTag::Image));
+
+    FilterKernels::selectTags(reinterpret_cast<const std::uint8_t*>(typeTags.data()), getRowCount(), typeMask(query), bits);
+
+    andRangeFilter(bits, ratings, query.getMinimumMediaRating(), query.getMaximumMediaRating(), allTypes);
+    andRangeFilter(bits, fileSizes, query.getMinimumFileSize(), query.getMaximumFileSize(), allTypes);
+    andRangeFilter(bits, years, query.getMinimumReleaseYear(), query.getMaximumReleaseYear(), withYear);
+    andRangeFilter(bits, lengths, query.getMinimumLength(), query.getMaximumLength(), withLength);
+    andRangeFilter(bits, bitRates, query.getMinimumBitRate(), query.getMaximumBitRate(), withBitRate);
+    andRangeFilter(bits, heights, static_cast<int>(query.getMinimumResolution()), static_cast<int>(query.getMaximumResolution()), withResolution);
+}
+
+void MediaColumns::selectRows(const SearchQuery& query, std::vector<unsigned int>& positions) const {
+
+    positions.clear();
+    FilterKernels::Bitmap bits;
+    selectBitmap(query, bits);
+    positions.reserve(FilterKernels::countSelected(bits));
+    FilterKernels::collectPositions(bits, positions);
+}
+
+bool MediaColumns::rowMatches(unsigned int pos, const SearchQuery& query) const {
+
+    if (pos >= getRowCount()) return false;
+
+    TypeTag tag = typeTags[pos];
+    if (!typeFilterMatches(query, tag)) return false;
+    if (!SearchQuery::checkRange(ratings[pos], query.getMinimumMediaRating(), query.getMaximumMediaRating())) return false;
+    if (!SearchQuery::checkRange(fileSizes[pos], query.getMinimumFileSize(), query.getMaximumFileSize())) return false;
+
+    if (tag != TypeTag::Image) {
+        if (!SearchQuery::checkRange(years[pos], query.getMinimumReleaseYear(), query.getMaximumReleaseYear())) return false;
+        if (!SearchQuery::checkRange(lengths[pos], query.getMinimumLength(), query.getMaximumLength())) return false;
+    }
+    if (tag == TypeTag::Audio) {
+        if (!SearchQuery::checkRange(bitRates[pos], query.getMinimumBitRate(), query.getMaximumBitRate())) return false;
+    }
+    if (tag == TypeTag::Video || tag == TypeTag::Image) {
+        if (!SearchQuery::checkRange(heights[pos], static_cast<int>(query.getMinimumResolution()), static_cast<int>(query.getMaximumResolution()))) return false;
+    }
+    return true;
+}
+
+
+
+// === SCORE ===
+
+void MediaColumns::scoreRows(unsigned int first, unsigned int last, float* scores) const {
+
+    if (last > getRowCount()) last = getRowCount();
+    if (first >= last) return;
+
+    ScoreKernels::ScoreInputs in;
+    in.typeTags = reinterpret_cast<const std::uint8_t*>(typeTags.data());
+    in.ratings = ratings.data();
+    in.bitRates = bitRates.data();
+    in.sampleRates = sampleRates.data();
+    in.bitDepths = bitDepths.data();
+    in.channels = channels.data();
+    in.frameRates = frameRates.data();
+    in.widths = widths.data();
+    in.heights = heights.data();
+    in.flags = flags.data();
+
+    ScoreKernels::scoreRows(in, first, last, scores);
+}
+
+
+MediaColumns::Row MediaColumns::readRow(const Media::AbstractMedia& media) {
+
+    Visitors::ColumnVisitor visitor;
+    media.accept(visitor);
+    return visitor.getRow();
+}
+
+std::uint8_t MediaColumns::typeMask(const SearchQuery& query) {
+
+    std::uint8_t mask = 0;
+    for (unsigned int t = 0; t < 4; ++t) {
+        if (typeFilterMatches(query, static_cast<TypeTag>(t))) {
+            mask |= static_cast<std::uint8_t>(1u << t);
+        }
+    }
+    return mask;
+}
+
+template <typename T>
+void MediaColumns::andRangeFilter(FilterKernels::Bitmap& bits, const std::vector<T>& column, T minValue, T maxValue, std::uint8_t applicableTypes) const {
+
+    // filtro non impostato
+    if (minValue == T() && maxValue == T()) return;
+
+    // un estremo a 0 equivale all'intervallo aperto
+    const T lowest = std::numeric_limits<T>::has_infinity ? -std::numeric_limits<T>::infinity() : std::numeric_limits<T>::lowest();
+    const T highest = std::numeric_limits<T>::has_infinity ? std::numeric_limits<T>::infinity() : std::numeric_limits<T>::max();
+    T lower = minValue != T() ? minValue : lowest;
+    T upper = maxValue != T() ? maxValue : highest;
+
+    FilterKernels::Bitmap range;
+    FilterKernels::selectRange(column.data(), getRowCount(), lower, upper, range);
+
+    // le righe dei tipi che non possiedono l'attributo restano selezionate
+    if (applicableTypes != 0xF) {
+        FilterKernels::Bitmap notApplicable;
+        FilterKernels::selectTags(reinterpret_cast<const std::uint8_t*>(typeTags.data()), getRowCount(),
+                                  static_cast<std::uint8_t>(~applicableTypes & 0xF), notApplicable);
+        FilterKernels::orBitmaps(range, notApplicable);
+    }
+    FilterKernels::andBitmaps(bits, range);
+}
+
+bool MediaColumns::typeFilterMatches(const SearchQuery& query, TypeTag tag) {
+
+    static const char* typeNames[] = { "AUDIO", "VIDEO", "EBOOK", "IMAGE" };
+
+    return !query.hasMediaTypeSet() || SearchQuery::checkExactMatch(query.getMediaType(), typeNames[static_cast<unsigned int>(tag)]);
+}
+
+template <typename T>
+void MediaColumns::mergeColumn(std::vector<T>& column, const std::vector<unsigned int>& positions, const std::vector<Row>& rows, T Row::* field) {
+
+    // le righe esistenti vengono spostate dal fondo, ciascuna una sola volta, lasciando spazio alle nuove
+    std::size_t oldSize = column.size();
+    column.resize(oldSize + positions.size());
+    std::size_t source = oldSize;
+    for (std::size_t target = column.size(), next = positions.size(); next > 0; ) {
+        --target;
+        if (target == positions[next - 1]) {
+            --next;
+            column[target] = rows[next].*field;
+        }
+        else {
+            column[target] = column[--source];
+        }
+    }
+}
+
+template <typename T>
+void MediaColumns::compactColumn(std::vector<T>& column, const std::vector<unsigned int>& positions) {
+
+    std::size_t target = positions.front();
+    std::size_t next = 0;
+    for (std::size_t source = positions.front(); source < column.size(); ++source) {
+        if (next < positions.size() && positions[next] == source) {
+            ++next;
+        }
+        else {
+            column[target++] = column[source];
+        }
+    }
+    column.resize(target);
+}
+
+}
+}
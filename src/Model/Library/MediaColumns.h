@@ -0,0 +1,249 @@
+#ifndef MODEL_LIBRARY_MEDIA_COLUMNS_H
+#define MODEL_LIBRARY_MEDIA_COLUMNS_H
+
+#include "Model/Media/AbstractMedia.h"
+#include "Model/Library/SearchQuery.h"
+#include "Model/Library/FilterKernels.h"
+#include "Model/Library/ScoreKernels.h"
+
+#include <vector>
+#include <memory>
+#include <cstdint>
+
+/** @brief MediaColumns
+ *
+ *  MediaColumns e' una rappresentazione "colonnare" (struct-of-arrays) degli attributi numerici dei media della libreria.
+ *  Ogni attributo e' memorizzato in un vettore contiguo, e la riga 'i' di ogni colonna corrisponde al media in posizione 'i' della libreria.
+ *
+ *  Serve per valutare i filtri numerici (es. rating minimo/massimo) e, in generale, calcoli su molti media come semplici cicli su memoria
+ *  contigua, evitando per ogni media l'accesso tramite puntatore e la chiamata virtuale 'accept'.
+ *  I filtri ad intervallo di SearchQuery vengono valutati dai kernel vettorizzati di FilterKernels, che producono una bitmap di selezione per
+ *  ogni predicato; le bitmap vengono poi combinate con AND. Gli score di qualita' vengono calcolati in blocco dai kernel di ScoreKernels.
+ *
+ *  Le colonne vengono mantenute dalla classe Library (se lo snapshot colonnare e' attivo) ad ogni modifica della libreria.
+ *  I valori sono letti tramite il visitor ColumnVisitor; gli attributi non applicabili ad un tipo (es. la durata di una Image) valgono 0.
+ *
+ *  Colonne:
+ *  - 'uniqueIDs' : identificatore univoco
+ *  - 'typeTags' : tipo concreto del media (TypeTag)
+ *  - 'ratings' : recensione
+ *  - 'fileSizes' : dimensione del file
+ *  - 'years' : anno di uscita (Audio, EBook) o di creazione (Video)
+ *  - 'lengths' : durata in minuti (Audio, Video) o in pagine (EBook)
+ *  - 'bitRates' : bitrate (Audio)
+ *  - 'widths', 'heights' : risoluzione (Video, Image)
+ *  - 'sampleRates', 'channels' : samplerate e canali (Audio)
+ *  - 'bitDepths' : bitdepth (Audio, Image)
+ *  - 'frameRates' : framerate (Video)
+ *  - 'flags' : supporto HDR (Video) e compressione (Image), bit ScoreKernels::FLAG_HDR e ScoreKernels::FLAG_COMPRESSED
+ */
+
+namespace Model {
+namespace Library {
+
+class MediaColumns {
+
+public:
+
+    // === TIPI ===
+
+    /** @brief TypeTag : tipo concreto del media di una riga */
+    enum class TypeTag : std::uint8_t { Audio = 0, Video, EBook, Image };
+
+    /** @brief Row : valori di una singola riga, letti da un media */
+    struct Row {
+        unsigned int uniqueID = 0;
+        TypeTag typeTag = TypeTag::Audio;
+        unsigned int rating = 0;
+        float fileSize = 0.f;
+        unsigned int year = 0;
+        unsigned int length = 0;
+        unsigned int bitRate = 0;
+        int width = 0;
+        int height = 0;
+        float sampleRate = 0.f;
+        unsigned int bitDepth = 0;
+        unsigned int channels = 0;
+        unsigned int frameRate = 0;
+        std::uint8_t flags = 0;
+    };
+
+
+    // === AGGIORNAMENTO ===
+
+    /**
+     * @brief rebuildColumns : ricostruisce tutte le colonne a partire dai media della libreria
+     * @param media : media della libreria, nell'ordine della libreria
+     */
+    void rebuildColumns(const std::vector<std::shared_ptr<Media::AbstractMedia>>& media);
+
+    /**
+     * @brief appendRow : aggiunge in coda la riga di un media
+     * @param media : media inserito in fondo alla libreria
+     */
+    void appendRow(const Media::AbstractMedia& media);
+
+    /**
+     * @brief insertRow : inserisce la riga di un media in una data posizione, le righe successive scalano di uno
+     * @param pos : posizione del media inserito
+     * @param media : media inserito
+     */
+    void insertRow(unsigned int pos, const Media::AbstractMedia& media);
+
+    /**
+     * @brief updateRow : aggiorna la riga di un media (dopo una modifica)
+     * @param pos : posizione del media nella libreria
+     * @param media : media modificato
+     */
+    void updateRow(unsigned int pos, const Media::AbstractMedia& media);
+
+    /**
+     * @brief eraseRow : rimuove la riga in una data posizione, le righe successive scalano di uno
+     * @param pos : posizione del media rimosso
+     */
+    void eraseRow(unsigned int pos);
+
+    /**
+     * @brief insertRows : inserisce le righe di piu' media nelle rispettive posizioni, spostando ogni riga esistente una sola volta
+     * @param positions : posizioni finali dei media inseriti, in ordine strettamente crescente
+     * @param media : media inseriti, nello stesso ordine delle posizioni
+     */
+    void insertRows(const std::vector<unsigned int>& positions, const std::vector<const Media::AbstractMedia*>& media);
+
+    /**
+     * @brief eraseRows : rimuove le righe in piu' posizioni con un'unica compattazione stabile delle colonne
+     * @param positions : posizioni dei media rimossi, in ordine strettamente crescente
+     */
+    void eraseRows(const std::vector<unsigned int>& positions);
+
+    /**
+     * @brief clearColumns : svuota tutte le colonne
+     */
+    void clearColumns();
+
+
+    // === GETTER ===
+
+    unsigned int getRowCount() const;
+    const std::vector<unsigned int>& getUniqueIDs() const;
+    const std::vector<TypeTag>& getTypeTags() const;
+    const std::vector<unsigned int>& getRatings() const;
+    const std::vector<float>& getFileSizes() const;
+    const std::vector<unsigned int>& getYears() const;
+    const std::vector<unsigned int>& getLengths() const;
+    const std::vector<unsigned int>& getBitRates() const;
+    const std::vector<int>& getWidths() const;
+    const std::vector<int>& getHeights() const;
+    const std::vector<float>& getSampleRates() const;
+    const std::vector<unsigned int>& getBitDepths() const;
+    const std::vector<unsigned int>& getChannels() const;
+    const std::vector<unsigned int>& getFrameRates() const;
+    const std::vector<std::uint8_t>& getFlags() const;
+
+
+    // === FILTRI NUMERICI ===
+
+    /**
+     * @brief selectBitmap : calcola la bitmap delle righe che soddisfano i filtri numerici e di tipo di un query (ignorando i filtri testuali)
+     * @param query : filtri di ricerca
+     * @param bits : bitmap di selezione risultato
+     */
+    void selectBitmap(const SearchQuery& query, FilterKernels::Bitmap& bits) const;
+
+    /**
+     * @brief selectRows : seleziona le righe che soddisfano i filtri numerici e di tipo di un query (ignorando i filtri testuali)
+     * @param query : filtri di ricerca
+     * @param positions : vettore in cui salvare le posizioni selezionate, in ordine crescente
+     */
+    void selectRows(const SearchQuery& query, std::vector<unsigned int>& positions) const;
+
+    /**
+     * @brief rowMatches : verifica se una singola riga soddisfa i filtri numerici e di tipo di un query
+     * @param pos : posizione della riga
+     * @param query : filtri di ricerca
+     * @return bool : true se la riga soddisfa i filtri, false altrimenti
+     */
+    bool rowMatches(unsigned int pos, const SearchQuery& query) const;
+
+
+    // === SCORE ===
+
+    /**
+     * @brief scoreRows : calcola in blocco lo score di qualita' (come ScoreVisitor) delle righe in un intervallo
+     * @param first : prima riga
+     * @param last : riga successiva all'ultima (limitata al numero di righe)
+     * @param scores : array di almeno 'last - first' elementi, lo score della riga 'i' viene scritto in 'scores[i - first]'
+     */
+    void scoreRows(unsigned int first, unsigned int last, float* scores) const;
+
+    /**
+     * @brief readRow : legge i valori delle colonne da un media, tramite ColumnVisitor
+     * @param media : media da leggere
+     * @return Row : valori della riga
+     */
+    static Row readRow(const Media::AbstractMedia& media);
+
+private:
+
+    std::vector<unsigned int> uniqueIDs;
+    std::vector<TypeTag> typeTags;
+    std::vector<unsigned int> ratings;
+    std::vector<float> fileSizes;
+    std::vector<unsigned int> years;
+    std::vector<unsigned int> lengths;
+    std::vector<unsigned int> bitRates;
+    std::vector<int> widths;
+    std::vector<int> heights;
+    std::vector<float> sampleRates;
+    std::vector<unsigned int> bitDepths;
+    std::vector<unsigned int> channels;
+    std::vector<unsigned int> frameRates;
+    std::vector<std::uint8_t> flags;
+
+    /**
+     * @brief typeFilterMatches : verifica se il filtro sul tipo del query ammette un dato tipo (match esatto, come SearchVisitor)
+     * @param query : filtri di ricerca
+     * @param tag : tipo concreto
+     * @return bool : true se il tipo e' ammesso, false altrimenti
+     */
+    static bool typeFilterMatches(const SearchQuery& query, TypeTag tag);
+
+    /**
+     * @brief typeMask : restituisce la maschera (bit 't' per il tag 't') dei tipi ammessi dal filtro sul tipo del query
+     */
+    static std::uint8_t typeMask(const SearchQuery& query);
+
+    /**
+     * @brief andRangeFilter : interseca la selezione con un filtro ad intervallo, applicato solo ai tipi che possiedono l'attributo
+     * @param bits : selezione corrente
+     * @param column : colonna dell'attributo
+     * @param minValue : estremo inferiore (0 se non impostato)
+     * @param maxValue : estremo superiore (0 se non impostato)
+     * @param applicableTypes : maschera dei tipi che possiedono l'attributo (le righe degli altri tipi restano selezionate)
+     */
+    template <typename T>
+    void andRangeFilter(FilterKernels::Bitmap& bits, const std::vector<T>& column, T minValue, T maxValue, std::uint8_t applicableTypes) const;
+
+    /**
+     * @brief mergeColumn : inserisce in una colonna i valori di un campo delle nuove righe, nelle rispettive posizioni finali
+     * @param column : colonna da aggiornare
+     * @param positions : posizioni finali delle nuove righe, in ordine strettamente crescente
+     * @param rows : nuove righe
+     * @param field : campo di Row corrispondente alla colonna
+     */
+    template <typename T>
+    static void mergeColumn(std::vector<T>& column, const std::vector<unsigned int>& positions, const std::vector<Row>& rows, T Row::* field);
+
+    /**
+     * @brief compactColumn : rimuove da una colonna i valori in alcune posizioni, mantenendo l'ordine degli altri
+     * @param column : colonna da aggiornare
+     * @param positions : posizioni da rimuovere, in ordine strettamente crescente
+     */
+    template <typename T>
+    static void compactColumn(std::vector<T>& column, const std::vector<unsigned int>& positions);
+};
+
+}
+}
+
+#endif // MODEL_LIBRARY_MEDIA_COLUMNS_H
@@ -35,6 +35,21 @@ std::shared_ptr<Media::AbstractMedia> MediaFactory::createMedia(
     }
 }
 
+std::shared_ptr<Media::AbstractMedia> MediaFactory::createMedia(const Builders::IBuilder& builder) {
+
+    try {
+        return builder.buildMedia();
+    }
+    catch (const Model::Visitors::MediaValidatorException& e) {
+        throw Model::Visitors::MediaValidatorException("Failed to create media: " + std::string(e.what()));
+    }
+}
+
+bool MediaFactory::isSupportedType(const std::string& type) {
+
+    return type == "AUDIO" || type == "EBOOK" || type == "VIDEO" || type == "IMAGE";
+}
+
 
 std::shared_ptr<Media::AbstractMedia> MediaFactory::createAudio
     (const std::unordered_map<std::string, std::string>& audioAttributes)
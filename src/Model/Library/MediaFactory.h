@@ -2,6 +2,7 @@
 #define MODEL_LIBRARY_MEDIA_FACTORY_H
 
 #include "Model/Media/AbstractMedia.h"
+#include "Model/Builders/IBuilder.h"
 
 #include <string>
 #include <unordered_map>
@@ -16,6 +17,9 @@
  *  del tipo std::unordered_map<std::string, std::string>, che associa i nomi degli attributi ai rispettivi valori (che variano in base al tipo da creare).
  *  La costruzione poi avviene mediante metodi helper privati, che si occupano della creazione dei tipi specifici di media, utilizzando i loro builder corrispondenti.
  *
+ *  Per la creazione programmatica (ad esempio l'inserimento di molti media in blocco) e' disponibile anche l'overload di 'createMedia' che riceve direttamente un builder
+ *  gia' configurato con i setter tipizzati: in questo modo gli attributi non passano per la mappa di stringhe e non devono essere riconvertiti.
+ *
  *  Il metodo 'buildMedia' restituisce uno smart pointer del tipo std::shared_ptr al media creato.
  *  Se si verifica un'errore durante la fase di costruzione, questo viene segnalato mediante il lancio di eccezioni del tipo std::runtime_error (tipo di media non valido) oppure
  *  del tipo MediaValidatorException (che contiene un messaggio descrittivo con gli errori rilevati).
@@ -41,6 +45,22 @@ public:
      */
     std::shared_ptr<Model::Media::AbstractMedia> createMedia(const std::string& type, const std::unordered_map<std::string, std::string>& attr);
 
+    /**
+     * @brief createMedia : crea un nuovo media a partire da un builder gia' configurato (attributi tipizzati, senza conversioni da stringa)
+     * @param builder : builder concreto (AudioBuilder, VideoBuilder, ...) con gli attributi del media da creare
+     * @return std::shared_ptr<AbstractMedia> : smart pointer al media creato
+     *
+     * @throws MediaValidatorException se il media costruito non e' valido (con messaggio con l'errore passato dal builder specifico)
+     */
+    std::shared_ptr<Model::Media::AbstractMedia> createMedia(const Builders::IBuilder& builder);
+
+    /**
+     * @brief isSupportedType : verifica se un tipo di media e' tra quelli creati da 'createMedia'
+     * @param type : tipo di media
+     * @return bool : true se 'createMedia' costruisce un media del tipo dato, false se solleva l'eccezione per tipo non valido
+     */
+    static bool isSupportedType(const std::string& type);
+
 
 private:
 
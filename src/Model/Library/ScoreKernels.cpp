@@ -0,0 +1,119 @@
+#include "ScoreKernels.h"
+#include "Model/Media/AbstractMedia.h"
+
+#include <cstdint>
+
+
+namespace Model {
+namespace Library {
+
+namespace {
+
+// righe elaborate da tutti i kernel prima di passare al blocco successivo
+const unsigned int SCORE_BLOCK_ROWS = 2048;
+
+// tag dei tipi, come in MediaColumns::TypeTag
+const std::uint8_t TAG_AUDIO = 0;
+const std::uint8_t TAG_VIDEO = 1;
+const std::uint8_t TAG_EBOOK = 2;
+const std::uint8_t TAG_IMAGE = 3;
+
+/**
+ * @brief normalizeClamped : equivalente senza salti di ScoreVisitor::normalizeValue
+ * @details per 'val' tra 'min' e 'max' il risultato e' lo stesso, fuori dall'intervallo il valore viene limitato a 0 o 1
+ */
+inline float normalizeClamped(float val, float min, float max) {
+    float norm = (val - min) / (max - min);
+    norm = norm < 0.f ? 0.f : norm;
+    return norm > 1.f ? 1.f : norm;
+}
+
+inline float normalizedRating(unsigned int rating) {
+    return normalizeClamped(static_cast<float>(rating),
+                            static_cast<float>(Media::AbstractMedia::MIN_MEDIA_RATING),
+                            static_cast<float>(Media::AbstractMedia::MAX_MEDIA_RATING));
+}
+
+}
+
+const std::uint8_t ScoreKernels::FLAG_HDR = 1u << 0;
+const std::uint8_t ScoreKernels::FLAG_COMPRESSED = 1u << 1;
+
+
+// === KERNEL ===
+
+void ScoreKernels::scoreRows(const ScoreInputs& in, unsigned int first, unsigned int last, float* scores) {
+
+    for (unsigned int block = first; block < last; block += SCORE_BLOCK_ROWS) {
+        unsigned int end = last - block < SCORE_BLOCK_ROWS ? last : block + SCORE_BLOCK_ROWS;
+        float* out = scores + (block - first);
+        scoreAudioRows(in, block, end, out);
+        scoreVideoRows(in, block, end, out);
+        scoreEBookRows(in, block, end, out);
+        scoreImageRows(in, block, end, out);
+    }
+}
+
+void ScoreKernels::scoreAudioRows(const ScoreInputs& in, unsigned int first, unsigned int last, float* scores) {
+
+    for (unsigned int i = first; i < last; ++i) {
+        float valueRating = normalizedRating(in.ratings[i]);
+
+        float valueBitrate = normalizeClamped(static_cast<float>(in.bitRates[i]), 96.0f, 256.0f);
+        float valueSamplerate = normalizeClamped(in.sampleRates[i], 22.0f, 44.1f);
+        float valueBitdepth = normalizeClamped(static_cast<float>(in.bitDepths[i]), 8.0f, 16.0f);
+        float valueAudioChannels = in.channels[i] >= 2 ? 1.0f : 0.0f;
+
+        float valueAudioQuality = (0.5f * valueBitrate) + (0.30f * valueSamplerate) + (0.10f * valueBitdepth) + (0.10f * valueAudioChannels);
+        float score = ((0.4f * valueRating) + (0.60f * valueAudioQuality)) * 100.0f;
+
+        float* out = scores + (i - first);
+        *out = in.typeTags[i] == TAG_AUDIO ? score : *out;
+    }
+}
+
+void ScoreKernels::scoreVideoRows(const ScoreInputs& in, unsigned int first, unsigned int last, float* scores) {
+
+    for (unsigned int i = first; i < last; ++i) {
+        float valueRating = normalizedRating(in.ratings[i]);
+
+        int height = in.heights[i];
+        float valueResolution = height < 480 ? 0.0f : (height < 720 ? 0.4f : (height < 1080 ? 0.7f : (height < 1440 ? 0.9f : 1.0f)));
+        float valueFramerate = in.frameRates[i] < 24 ? 0.0f : (in.frameRates[i] < 30 ? 0.8f : 1.0f);
+        float valueHDRSupport = (in.flags[i] & FLAG_HDR) ? 1.0f : 0.5f;
+
+        float score = ((0.35f * valueRating) + (0.45f * valueResolution) + (0.05f * valueFramerate) + (0.15f * valueHDRSupport)) * 100.f;
+
+        float* out = scores + (i - first);
+        *out = in.typeTags[i] == TAG_VIDEO ? score : *out;
+    }
+}
+
+void ScoreKernels::scoreEBookRows(const ScoreInputs& in, unsigned int first, unsigned int last, float* scores) {
+
+    for (unsigned int i = first; i < last; ++i) {
+        float* out = scores + (i - first);
+        *out = in.typeTags[i] == TAG_EBOOK ? static_cast<float>(in.ratings[i]) : *out;
+    }
+}
+
+void ScoreKernels::scoreImageRows(const ScoreInputs& in, unsigned int first, unsigned int last, float* scores) {
+
+    for (unsigned int i = first; i < last; ++i) {
+        float valueRating = normalizedRating(in.ratings[i]);
+
+        // stesso calcolo di Image::getMegaPixels
+        float megaPixels = static_cast<float>(in.widths[i] * in.heights[i]) / 1000000.f;
+        float valueMegaPixels = megaPixels < 6.0f ? 0.6f : (megaPixels < 12.0f ? 0.8f : 1.0f);
+        float valueCompressed = (in.flags[i] & FLAG_COMPRESSED) ? 0.5f : 1.0f;
+        float valueBitdepth = in.bitDepths[i] <= 8 ? 0.6f : normalizeClamped(static_cast<float>(in.bitDepths[i]), 8.0f, 16.0f);
+
+        float score = ((0.3f * valueRating) + (0.4f * valueMegaPixels) + (0.15f * valueCompressed) + (0.15f * valueBitdepth)) * 100.f;
+
+        float* out = scores + (i - first);
+        *out = in.typeTags[i] == TAG_IMAGE ? score : *out;
+    }
+}
+
+}
+}
@@ -0,0 +1,84 @@
+#ifndef MODEL_LIBRARY_SCORE_KERNELS_H
+#define MODEL_LIBRARY_SCORE_KERNELS_H
+
+#include <cstdint>
+
+/** @brief ScoreKernels
+ *
+ *  ScoreKernels raccoglie i "kernel" utilizzati per calcolare in blocco gli score di qualita' dei media a partire dalle colonne di MediaColumns.
+ *
+ *  Ogni kernel calcola lo score di un tipo di media per tutte le righe di un intervallo, con la stessa formula (pesi, soglie e ordine delle operazioni)
+ *  di ScoreVisitor, ma senza salti: le soglie sono espresse come selezioni e le normalizzazioni come 'clamp' nel range [0,1].
+ *  In questo modo i cicli operano su memoria contigua e possono essere vettorizzati dal compilatore.
+ *  Lo score viene scritto solo nelle righe del tipo corrispondente, le altre righe restano invariate.
+ *
+ *  Le righe vengono elaborate a blocchi, applicando a ciascun blocco i kernel di tutti i tipi, per mantenere i dati in cache.
+ */
+
+namespace Model {
+namespace Library {
+
+class ScoreKernels {
+
+public:
+
+    // === COSTANTI STATICHE ===
+
+    static const std::uint8_t FLAG_HDR;          // bit della colonna 'flags' : supporto HDR (Video)
+    static const std::uint8_t FLAG_COMPRESSED;   // bit della colonna 'flags' : immagine compressa (Image)
+
+    /** @brief ScoreInputs : puntatori alle colonne lette dai kernel (tutte con lo stesso numero di righe) */
+    struct ScoreInputs {
+        const std::uint8_t* typeTags;     // tipo concreto (0 Audio, 1 Video, 2 EBook, 3 Image)
+        const unsigned int* ratings;      // recensione
+        const unsigned int* bitRates;     // bitrate (Audio)
+        const float* sampleRates;         // samplerate (Audio)
+        const unsigned int* bitDepths;    // bitdepth (Audio, Image)
+        const unsigned int* channels;     // canali audio (Audio)
+        const unsigned int* frameRates;   // framerate (Video)
+        const int* widths;                // larghezza (Video, Image)
+        const int* heights;               // altezza (Video, Image)
+        const std::uint8_t* flags;        // FLAG_HDR, FLAG_COMPRESSED
+    };
+
+
+    // === KERNEL ===
+
+    /**
+     * @brief scoreRows : calcola lo score (nel range [0,100]) di tutte le righe in un intervallo
+     * @param in : colonne di input
+     * @param first : prima riga
+     * @param last : riga successiva all'ultima
+     * @param scores : array di output, lo score della riga 'i' viene scritto in 'scores[i - first]'
+     */
+    static void scoreRows(const ScoreInputs& in, unsigned int first, unsigned int last, float* scores);
+
+    /**
+     * @brief scoreAudioRows : calcola lo score delle righe Audio di un intervallo
+     * @details score dato da rating (40%) e qualita' audio (60%), a sua volta data da bitrate (50%), samplerate (30%), bitdepth (10%), canali (10%)
+     */
+    static void scoreAudioRows(const ScoreInputs& in, unsigned int first, unsigned int last, float* scores);
+
+    /**
+     * @brief scoreVideoRows : calcola lo score delle righe Video di un intervallo
+     * @details score dato da rating (35%), risoluzione (45%), framerate (5%), supporto HDR (15%)
+     */
+    static void scoreVideoRows(const ScoreInputs& in, unsigned int first, unsigned int last, float* scores);
+
+    /**
+     * @brief scoreEBookRows : calcola lo score delle righe EBook di un intervallo
+     * @details score dato dal rating (100%, non normalizzato)
+     */
+    static void scoreEBookRows(const ScoreInputs& in, unsigned int first, unsigned int last, float* scores);
+
+    /**
+     * @brief scoreImageRows : calcola lo score delle righe Image di un intervallo
+     * @details score dato da rating (30%), megapixel (40%), compressione (15%), bitdepth (15%)
+     */
+    static void scoreImageRows(const ScoreInputs& in, unsigned int first, unsigned int last, float* scores);
+};
+
+}
+}
+
+#endif // MODEL_LIBRARY_SCORE_KERNELS_H
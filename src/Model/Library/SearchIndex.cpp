@@ -0,0 +1,503 @@
+#include "SearchIndex.h"
+#include "Model/Visitors/IndexVisitor.h"
+
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <iterator>
+#include <unordered_set>
+#include <limits>
+
+
+namespace Model {
+namespace Library {
+
+
+// === AGGIORNAMENTO INDICE ===
+
+void SearchIndex::insertMedia(const Media::AbstractMedia& media) {
+
+    Visitors::IndexVisitor visitor;
+    media.accept(visitor);
+
+    TypeIndex& typeIndex = typeIndexes[static_cast<unsigned int>(visitor.getIndexedType())];
+    addPosting(typeIndex.members, media.getUniqueID());
+
+    for (const auto& field : visitor.getIndexedFields()) {
+        FieldIndex& fieldIndex = typeIndex.fields[static_cast<unsigned int>(field.first)];
+        std::string folded = foldString(*field.second);
+        for (const auto& token : tokenize(folded)) {
+            addPosting(fieldIndex.tokenPostings[token], media.getUniqueID());
+        }
+        for (std::uint32_t trigram : trigrams(folded)) {
+            addPosting(fieldIndex.trigramPostings[trigram], media.getUniqueID());
+        }
+    }
+}
+
+void SearchIndex::removeMedia(const Media::AbstractMedia& media) {
+
+    Visitors::IndexVisitor visitor;
+    media.accept(visitor);
+
+    TypeIndex& typeIndex = typeIndexes[static_cast<unsigned int>(visitor.getIndexedType())];
+    removePosting(typeIndex.members, media.getUniqueID());
+
+    for (const auto& field : visitor.getIndexedFields()) {
+        FieldIndex& fieldIndex = typeIndex.fields[static_cast<unsigned int>(field.first)];
+        std::string folded = foldString(*field.second);
+        for (const auto& token : tokenize(folded)) {
+            auto found = fieldIndex.tokenPostings.find(token);
+            if (found != fieldIndex.tokenPostings.end()) {
+                removePosting(found->second, media.getUniqueID());
+                // i token non piu' presenti vengono eliminati dal vocabolario
+                if (found->second.empty()) {
+                    fieldIndex.tokenPostings.erase(found);
+                }
+            }
+        }
+        for (std::uint32_t trigram : trigrams(folded)) {
+            auto found = fieldIndex.trigramPostings.find(trigram);
+            if (found != fieldIndex.trigramPostings.end()) {
+                removePosting(found->second, media.getUniqueID());
+                if (found->second.empty()) {
+                    fieldIndex.trigramPostings.erase(found);
+                }
+            }
+        }
+    }
+}
+
+void SearchIndex::insertMultipleMedia(const std::vector<const Media::AbstractMedia*>& media) {
+
+    // ogni posting list viene unita una sola volta con i nuovi identificatori ordinati, invece di un inserimento ordinato per ciascuno
+    for (auto& postings : collectPostings(media)) {
+        PostingList& list = *postings.first;
+        std::vector<unsigned int>& ids = postings.second;
+        if (!std::is_sorted(ids.begin(), ids.end())) {
+            std::sort(ids.begin(), ids.end());
+        }
+        std::size_t middle = list.size();
+        list.insert(list.end(), ids.begin(), ids.end());
+        std::inplace_merge(list.begin(), list.begin() + middle, list.end());
+        list.erase(std::unique(list.begin(), list.end()), list.end());
+    }
+}
+
+void SearchIndex::removeMultipleMedia(const std::vector<const Media::AbstractMedia*>& media) {
+
+    // oltre questa frazione (1/N) dei media indicizzati, un passaggio sull'intero vocabolario costa meno che ricalcolare token e trigrammi di ogni media rimosso
+    static const std::size_t FULL_SCAN_REMOVAL_DIVISOR = 40;
+
+    if (media.empty()) return;
+
+    // identificatori rimossi, come bitmap sull'intervallo [minID, maxID]
+    unsigned int minID = std::numeric_limits<unsigned int>::max();
+    unsigned int maxID = 0;
+    for (const Media::AbstractMedia* current : media) {
+        if (!current) continue;
+        minID = std::min(minID, current->getUniqueID());
+        maxID = std::max(maxID, current->getUniqueID());
+    }
+    if (minID > maxID) return;
+    std::vector<char> removedIDs(static_cast<std::size_t>(maxID - minID) + 1, 0);
+    for (const Media::AbstractMedia* current : media) {
+        if (current) removedIDs[current->getUniqueID() - minID] = 1;
+    }
+
+    // toglie da una posting list (ordinata) tutti gli identificatori rimossi, partendo dal primo non inferiore a 'minID'
+    auto compactList = [&](PostingList& list) {
+        auto first = std::lower_bound(list.begin(), list.end(), minID);
+        if (first == list.end() || *first > maxID) return list.empty();
+        list.erase(std::remove_if(first, list.end(), [&](unsigned int id) {
+            return id <= maxID && removedIDs[id - minID];
+        }), list.end());
+        return list.empty();
+    };
+
+    std::size_t indexedCount = 0;
+    for (const auto& typeIndex : typeIndexes) {
+        indexedCount += typeIndex.members.size();
+    }
+
+    if (media.size() * FULL_SCAN_REMOVAL_DIVISOR >= indexedCount) {
+        // rimozione estesa: ogni posting list del vocabolario viene compattata in un unico passaggio lineare, senza visitare i media
+        for (auto& typeIndex : typeIndexes) {
+            compactList(typeIndex.members);
+            for (auto& fieldIndex : typeIndex.fields) {
+                for (auto it = fieldIndex.tokenPostings.begin(); it != fieldIndex.tokenPostings.end(); ) {
+                    it = compactList(it->second) ? fieldIndex.tokenPostings.erase(it) : std::next(it);
+                }
+                for (auto it = fieldIndex.trigramPostings.begin(); it != fieldIndex.trigramPostings.end(); ) {
+                    it = compactList(it->second) ? fieldIndex.trigramPostings.erase(it) : std::next(it);
+                }
+            }
+        }
+        return;
+    }
+
+    // rimozione limitata: ogni posting list interessata viene compattata una sola volta, al primo media che la contiene
+    std::unordered_set<const PostingList*> compacted;
+    auto compact = [&](PostingList& list) {
+        if (!compacted.insert(&list).second) return false;
+        return compactList(list);
+    };
+
+    for (const Media::AbstractMedia* current : media) {
+        if (!current) continue;
+
+        Visitors::IndexVisitor visitor;
+        current->accept(visitor);
+        TypeIndex& typeIndex = typeIndexes[static_cast<unsigned int>(visitor.getIndexedType())];
+        compact(typeIndex.members);
+
+        for (const auto& field : visitor.getIndexedFields()) {
+            FieldIndex& fieldIndex = typeIndex.fields[static_cast<unsigned int>(field.first)];
+            std::string folded = foldString(*field.second);
+            for (const auto& token : tokenize(folded)) {
+                auto found = fieldIndex.tokenPostings.find(token);
+                // i token non piu' presenti vengono eliminati dal vocabolario
+                if (found != fieldIndex.tokenPostings.end() && compact(found->second)) {
+                    fieldIndex.tokenPostings.erase(found);
+                }
+            }
+            for (std::uint32_t trigram : trigrams(folded)) {
+                auto found = fieldIndex.trigramPostings.find(trigram);
+                if (found != fieldIndex.trigramPostings.end() && compact(found->second)) {
+                    fieldIndex.trigramPostings.erase(found);
+                }
+            }
+        }
+    }
+}
+
+void SearchIndex::clearIndex() {
+
+    for (auto& typeIndex : typeIndexes) {
+        typeIndex.members.clear();
+        for (auto& fieldIndex : typeIndex.fields) {
+            fieldIndex.tokenPostings.clear();
+            fieldIndex.trigramPostings.clear();
+        }
+    }
+}
+
+
+// === RICERCA ===
+
+bool SearchIndex::findCandidates(const SearchQuery& query, std::vector<unsigned int>& candidates) const {
+
+    static const char* typeNames[] = { "AUDIO", "VIDEO", "EBOOK", "IMAGE" };
+
+    candidates.clear();
+    bool narrowed = query.hasMediaTypeSet();
+
+    for (unsigned int t = 0; t < static_cast<unsigned int>(IndexedType::Count); ++t) {
+
+        // il filtro sul tipo richiede un match esatto, come in SearchVisitor
+        if (query.hasMediaTypeSet() && !SearchQuery::checkExactMatch(query.getMediaType(), typeNames[t])) {
+            continue;
+        }
+
+        const TypeIndex& typeIndex = typeIndexes[t];
+        PostingList typeCandidates;
+        bool typeNarrowed = false;
+
+        for (const auto& filter : collectTypeFilters(static_cast<IndexedType>(t), query)) {
+
+            PostingList matches;
+            if (!matchField(typeIndex.fields[static_cast<unsigned int>(filter.first)], filter.second, matches)) {
+                continue;
+            }
+            if (!typeNarrowed) {
+                typeCandidates = std::move(matches);
+                typeNarrowed = true;
+            }
+            else {
+                intersectPostings(typeCandidates, matches);
+            }
+            if (typeCandidates.empty()) {
+                break;
+            }
+        }
+
+        // se nessun filtro si applica al tipo, tutti i suoi media sono candidati
+        if (typeNarrowed) {
+            narrowed = true;
+            candidates.insert(candidates.end(), typeCandidates.begin(), typeCandidates.end());
+        }
+        else {
+            candidates.insert(candidates.end(), typeIndex.members.begin(), typeIndex.members.end());
+        }
+    }
+
+    if (!narrowed) {
+        candidates.clear();
+    }
+    return narrowed;
+}
+
+
+// === HELPER STATICI ===
+
+std::string SearchIndex::foldString(const std::string& str) {
+
+    std::string folded(str);
+    for (auto& c : folded) {
+        c = SearchQuery::foldCase(c);
+    }
+    return folded;
+}
+
+bool SearchIndex::isSeparator(char c) {
+
+    unsigned char uc = static_cast<unsigned char>(c);
+    // i byte non ASCII (es. UTF-8) vengono considerati parte dei token
+    return uc < 128 && !std::isalnum(uc);
+}
+
+bool SearchIndex::isIndexedAttribute(const std::string& name) {
+
+    // attributi letti da IndexVisitor (vedi IndexedField)
+    return name == "name" || name == "uploader" || name == "format" || name == "genre" || name == "artist" || name == "director" ||
+           name == "author" || name == "publisher" || name == "imageCreator" || name == "location";
+}
+
+
+// === HELPER PRIVATI ===
+
+std::vector<SearchIndex::FieldFilter> SearchIndex::collectTypeFilters(IndexedType type, const SearchQuery& query) {
+
+    std::vector<FieldFilter> filters;
+    auto addFilter = [&filters](IndexedField field, const std::string& value) {
+        if (!value.empty()) {
+            filters.emplace_back(field, foldString(value));
+        }
+    };
+
+    // filtri comuni (vedi SearchVisitor::checkCommonMatches)
+    addFilter(IndexedField::Name, query.getMediaName());
+    addFilter(IndexedField::Uploader, query.getMediaUploader());
+    addFilter(IndexedField::Format, query.getMediaFormat());
+
+    // filtri specifici (vedi SearchVisitor::checkAudioMatches, ecc.)
+    switch (type) {
+    case IndexedType::Audio:
+        addFilter(IndexedField::Artist, query.getAudioArtist());
+        addFilter(IndexedField::Genre, query.getMediaGenre());
+        break;
+    case IndexedType::Video:
+        addFilter(IndexedField::Director, query.getVideoDirector());
+        addFilter(IndexedField::Genre, query.getMediaGenre());
+        break;
+    case IndexedType::EBook:
+        addFilter(IndexedField::Author, query.getEBookAuthor());
+        addFilter(IndexedField::Publisher, query.getEBookPublisher());
+        break;
+    case IndexedType::Image:
+        addFilter(IndexedField::Creator, query.getImageCreator());
+        addFilter(IndexedField::Location, query.getImageLocation());
+        break;
+    default:
+        break;
+    }
+    return filters;
+}
+
+bool SearchIndex::matchField(const FieldIndex& field, const std::string& foldedQuery, PostingList& matches) {
+
+    // con almeno tre caratteri si usano i trigrammi, altrimenti il vocabolario dei token
+    if (foldedQuery.size() >= 3) {
+        matchTrigrams(field, foldedQuery, matches);
+        return true;
+    }
+    return matchTokens(field, foldedQuery, matches);
+}
+
+void SearchIndex::matchTrigrams(const FieldIndex& field, const std::string& foldedQuery, PostingList& matches) {
+
+    std::vector<const PostingList*> postings;
+    for (std::uint32_t trigram : trigrams(foldedQuery)) {
+        auto found = field.trigramPostings.find(trigram);
+        // un trigramma assente dall'indice esclude ogni media
+        if (found == field.trigramPostings.end()) {
+            matches.clear();
+            return;
+        }
+        postings.push_back(&found->second);
+    }
+
+    // si interseca partendo dalla lista piu' corta, cosi' il costo dipende dal numero di risultati
+    std::sort(postings.begin(), postings.end(), [](const PostingList* a, const PostingList* b) {
+        return a->size() < b->size();
+    });
+    matches = *postings.front();
+    for (unsigned int i = 1; i < postings.size() && !matches.empty(); ++i) {
+        intersectPostings(matches, *postings[i]);
+    }
+}
+
+bool SearchIndex::matchTokens(const FieldIndex& field, const std::string& foldedQuery, PostingList& matches) {
+
+    bool narrowed = false;
+    unsigned int i = 0;
+
+    while (i < foldedQuery.size()) {
+
+        // salta i separatori e individua il prossimo frammento del filtro
+        while (i < foldedQuery.size() && isSeparator(foldedQuery[i])) ++i;
+        unsigned int start = i;
+        while (i < foldedQuery.size() && !isSeparator(foldedQuery[i])) ++i;
+        if (start == i) break;
+
+        std::string piece = foldedQuery.substr(start, i - start);
+        // un frammento delimitato da separatori nel filtro deve esserlo anche nel testo
+        bool boundedLeft = start > 0;
+        bool boundedRight = i < foldedQuery.size();
+
+        PostingList pieceMatches;
+        if (boundedLeft && boundedRight) {
+            auto found = field.tokenPostings.find(piece);
+            if (found != field.tokenPostings.end()) {
+                pieceMatches = found->second;
+            }
+        }
+        else {
+            for (const auto& entry : field.tokenPostings) {
+
+                const std::string& token = entry.first;
+                bool tokenMatches = false;
+                if (boundedLeft) {
+                    tokenMatches = token.compare(0, piece.size(), piece) == 0;
+                }
+                else if (boundedRight) {
+                    tokenMatches = token.size() >= piece.size() && token.compare(token.size() - piece.size(), piece.size(), piece) == 0;
+                }
+                else {
+                    tokenMatches = token.find(piece) != std::string::npos;
+                }
+                if (tokenMatches) {
+                    pieceMatches.insert(pieceMatches.end(), entry.second.begin(), entry.second.end());
+                }
+            }
+            std::sort(pieceMatches.begin(), pieceMatches.end());
+            pieceMatches.erase(std::unique(pieceMatches.begin(), pieceMatches.end()), pieceMatches.end());
+        }
+
+        if (!narrowed) {
+            matches = std::move(pieceMatches);
+            narrowed = true;
+        }
+        else {
+            intersectPostings(matches, pieceMatches);
+        }
+        if (matches.empty()) {
+            break;
+        }
+    }
+    return narrowed;
+}
+
+std::vector<std::string> SearchIndex::tokenize(const std::string& folded) {
+
+    std::vector<std::string> tokens;
+    unsigned int i = 0;
+    while (i < folded.size()) {
+        while (i < folded.size() && isSeparator(folded[i])) ++i;
+        unsigned int start = i;
+        while (i < folded.size() && !isSeparator(folded[i])) ++i;
+        if (start < i) {
+            tokens.push_back(folded.substr(start, i - start));
+        }
+    }
+    std::sort(tokens.begin(), tokens.end());
+    tokens.erase(std::unique(tokens.begin(), tokens.end()), tokens.end());
+    return tokens;
+}
+
+std::vector<std::uint32_t> SearchIndex::trigrams(const std::string& folded) {
+
+    std::vector<std::uint32_t> result;
+    if (folded.size() < 3) {
+        return result;
+    }
+    result.reserve(folded.size() - 2);
+    for (unsigned int i = 0; i + 2 < folded.size(); ++i) {
+        result.push_back((static_cast<std::uint32_t>(static_cast<unsigned char>(folded[i])) << 16) |
+                         (static_cast<std::uint32_t>(static_cast<unsigned char>(folded[i + 1])) << 8) |
+                          static_cast<std::uint32_t>(static_cast<unsigned char>(folded[i + 2])));
+    }
+    std::sort(result.begin(), result.end());
+    result.erase(std::unique(result.begin(), result.end()), result.end());
+    return result;
+}
+
+void SearchIndex::addPosting(PostingList& list, unsigned int id) {
+
+    // gli identificatori crescono nel tempo, per cui l'inserimento avviene quasi sempre in coda
+    if (list.empty() || list.back() < id) {
+        list.push_back(id);
+        return;
+    }
+    auto it = std::lower_bound(list.begin(), list.end(), id);
+    if (it == list.end() || *it != id) {
+        list.insert(it, id);
+    }
+}
+
+void SearchIndex::removePosting(PostingList& list, unsigned int id) {
+
+    auto it = std::lower_bound(list.begin(), list.end(), id);
+    if (it != list.end() && *it == id) {
+        list.erase(it);
+    }
+}
+
+std::unordered_map<SearchIndex::PostingList*, std::vector<unsigned int>> SearchIndex::collectPostings(const std::vector<const Media::AbstractMedia*>& media) {
+
+    std::unordered_map<PostingList*, std::vector<unsigned int>> collected;
+    for (const Media::AbstractMedia* current : media) {
+        if (!current) continue;
+
+        Visitors::IndexVisitor visitor;
+        current->accept(visitor);
+        unsigned int id = current->getUniqueID();
+
+        TypeIndex& typeIndex = typeIndexes[static_cast<unsigned int>(visitor.getIndexedType())];
+        collected[&typeIndex.members].push_back(id);
+
+        for (const auto& field : visitor.getIndexedFields()) {
+            FieldIndex& fieldIndex = typeIndex.fields[static_cast<unsigned int>(field.first)];
+            std::string folded = foldString(*field.second);
+            for (const auto& token : tokenize(folded)) {
+                collected[&fieldIndex.tokenPostings[token]].push_back(id);
+            }
+            for (std::uint32_t trigram : trigrams(folded)) {
+                collected[&fieldIndex.trigramPostings[trigram]].push_back(id);
+            }
+        }
+    }
+    return collected;
+}
+
+void SearchIndex::intersectPostings(PostingList& result, const PostingList& other) {
+
+    PostingList intersection;
+
+    // se l'altra lista e' molto piu' lunga conviene cercare ogni elemento per bisezione
+    if (result.size() * 16 < other.size()) {
+        auto from = other.begin();
+        for (unsigned int id : result) {
+            from = std::lower_bound(from, other.end(), id);
+            if (from == other.end()) break;
+            if (*from == id) intersection.push_back(id);
+        }
+    }
+    else {
+        std::set_intersection(result.begin(), result.end(), other.begin(), other.end(), std::back_inserter(intersection));
+    }
+    result = std::move(intersection);
+}
+
+}
+}
@@ -0,0 +1,212 @@
+#ifndef MODEL_LIBRARY_SEARCH_INDEX_H
+#define MODEL_LIBRARY_SEARCH_INDEX_H
+
+#include "Model/Media/AbstractMedia.h"
+#include "Model/Library/SearchQuery.h"
+
+#include <string>
+#include <vector>
+#include <array>
+#include <cstdint>
+#include <utility>
+#include <unordered_map>
+
+/** @brief SearchIndex
+ *
+ *  SearchIndex e' un indice invertito, mantenuto dalla classe Library, che permette di restringere l'operazione di ricerca ai soli
+ *  media "candidati" senza dover visitare l'intera libreria.
+ *
+ *  L'indice e' partizionato per tipo concreto di media (Audio, Video, EBook, Image) e, per ogni tipo, per campo testuale.
+ *  Vengono indicizzati solamente i campi su cui SearchVisitor applica effettivamente un match parziale (nome, uploader, formato,
+ *  genere, artista, regista, autore, editore, creatore, luogo): i filtri 'album', 'category' e 'quality' sono ignorati dalla ricerca
+ *  e quindi indicizzarli occuperebbe solo memoria.
+ *
+ *  Per ogni campo, il testo viene ridotto in minuscolo (con lo stesso 'SearchQuery::foldCase' usato da 'checkPartialMatch') e
+ *  indicizzato in due modi, entrambi basati su liste ordinate di identificatori univoci (posting list):
+ *  - trigrammi: ogni sequenza di tre caratteri consecutivi del testo. Un filtro di almeno tre caratteri puo' essere sottostringa
+ *    del testo solo se il testo contiene tutti i suoi trigrammi, per cui i candidati si ottengono intersecando le posting list
+ *    dei trigrammi del filtro (partendo dalla piu' corta);
+ *  - token alfanumerici: usati per i filtri piu' corti di tre caratteri, per cui non esistono trigrammi. Un frammento senza
+ *    separatori e' sempre contenuto in un singolo token, e i candidati si ottengono unendo le posting list dei token che lo
+ *    contengono (scorrendo il solo vocabolario del campo, non la libreria).
+ *
+ *  L'indice restituisce sempre un sovrainsieme dei risultati: ogni candidato viene poi verificato da SearchVisitor, per cui i
+ *  risultati della ricerca restano identici a quelli della scansione completa.
+ *  Rispetta inoltre la semantica di SearchVisitor per i filtri specifici: ad esempio il filtro 'artista' restringe solo i media Audio,
+ *  mentre i media degli altri tipi restano tutti candidati.
+ *
+ *  L'indice va aggiornato ad ogni modifica della libreria (inserimento, rimozione, modifica, svuotamento e caricamento);
+ *  la rimozione utilizza i valori attuali dei campi del media, quindi va chiamata prima di modificarlo.
+ */
+
+namespace Model {
+namespace Library {
+
+class SearchIndex {
+
+public:
+
+    // === TIPI E CAMPI INDICIZZATI ===
+
+    /** @brief IndexedType : tipi concreti di media, usati per partizionare l'indice */
+    enum class IndexedType : unsigned int { Audio = 0, Video, EBook, Image, Count };
+
+    /** @brief IndexedField : campi testuali indicizzati */
+    enum class IndexedField : unsigned int {
+        Name = 0, Uploader, Format, Genre, Artist, Director, Author, Publisher, Creator, Location, Count
+    };
+
+
+    // === AGGIORNAMENTO INDICE ===
+
+    /**
+     * @brief insertMedia : indicizza i campi testuali di un media
+     * @param media : riferimento costante al media da indicizzare
+     */
+    void insertMedia(const Media::AbstractMedia& media);
+
+    /**
+     * @brief removeMedia : rimuove un media dall'indice (da chiamare prima di modificarne i campi)
+     * @param media : riferimento costante al media da rimuovere
+     */
+    void removeMedia(const Media::AbstractMedia& media);
+
+    /**
+     * @brief insertMultipleMedia : indicizza piu' media insieme, aggiornando ogni posting list interessata una sola volta
+     * @param media : media da indicizzare
+     */
+    void insertMultipleMedia(const std::vector<const Media::AbstractMedia*>& media);
+
+    /**
+     * @brief removeMultipleMedia : rimuove piu' media dall'indice insieme, compattando ogni posting list interessata una sola volta
+     *                              (per rimozioni estese, con un unico passaggio su tutto il vocabolario invece che sui campi di ciascun media)
+     * @param media : media da rimuovere (da chiamare prima di modificarne i campi)
+     */
+    void removeMultipleMedia(const std::vector<const Media::AbstractMedia*>& media);
+
+    /**
+     * @brief clearIndex : svuota completamente l'indice
+     */
+    void clearIndex();
+
+
+    // === RICERCA ===
+
+    /**
+     * @brief findCandidates : determina i media candidati per una ricerca
+     * @param query : filtri di ricerca
+     * @param candidates : vettore in cui vengono salvati gli identificatori dei candidati (senza un ordine particolare)
+     * @return bool : true se l'indice e' riuscito a restringere la ricerca, false se il query non ha filtri indicizzabili (serve scansione completa)
+     */
+    bool findCandidates(const SearchQuery& query, std::vector<unsigned int>& candidates) const;
+
+
+    // === HELPER STATICI ===
+
+    /**
+     * @brief foldString : riduce in minuscolo una stringa, carattere per carattere, come fatto da 'SearchQuery::checkPartialMatch'
+     * @param str : stringa da convertire
+     * @return std::string : stringa convertita
+     */
+    static std::string foldString(const std::string& str);
+
+    /**
+     * @brief isSeparator : verifica se un carattere separa due token (caratteri ASCII non alfanumerici)
+     * @param c : carattere da verificare
+     * @return bool : true se separatore, false altrimenti
+     */
+    static bool isSeparator(char c);
+
+    /**
+     * @brief isIndexedAttribute : verifica se un attributo (con i nomi usati da MediaEditor) corrisponde a un campo indicizzato
+     * @param name : nome dell'attributo
+     * @return bool : true se la modifica dell'attributo richiede di aggiornare l'indice, false altrimenti
+     */
+    static bool isIndexedAttribute(const std::string& name);
+
+private:
+
+    using PostingList = std::vector<unsigned int>;                   // lista ordinata di identificatori univoci
+    using FieldFilter = std::pair<IndexedField, std::string>;        // filtro testuale (campo, valore ridotto in minuscolo)
+
+    /** @brief FieldIndex : indice di un singolo campo testuale */
+    struct FieldIndex {
+        std::unordered_map<std::string, PostingList> tokenPostings;    // token -> media che lo contengono
+        std::unordered_map<std::uint32_t, PostingList> trigramPostings; // trigramma -> media che lo contengono
+    };
+
+    /** @brief TypeIndex : indice di un singolo tipo concreto di media */
+    struct TypeIndex {
+        PostingList members;                                                               // tutti i media del tipo
+        std::array<FieldIndex, static_cast<unsigned int>(IndexedField::Count)> fields;     // indici dei campi
+    };
+
+    std::array<TypeIndex, static_cast<unsigned int>(IndexedType::Count)> typeIndexes;     // indice partizionato per tipo
+
+
+    // === HELPER PRIVATI ===
+
+    /**
+     * @brief collectTypeFilters : raccoglie i filtri testuali che SearchVisitor applica ad un tipo di media
+     * @param type : tipo di media
+     * @param query : filtri di ricerca
+     * @return std::vector<FieldFilter> : filtri non vuoti, gia' ridotti in minuscolo
+     */
+    static std::vector<FieldFilter> collectTypeFilters(IndexedType type, const SearchQuery& query);
+
+    /**
+     * @brief matchField : determina i media di un campo che possono contenere il filtro come sottostringa
+     * @param field : indice del campo
+     * @param foldedQuery : filtro ridotto in minuscolo
+     * @param matches : posting list (ordinata) dei media trovati
+     * @return bool : true se il filtro restringe la ricerca, false se e' composto da soli separatori
+     */
+    static bool matchField(const FieldIndex& field, const std::string& foldedQuery, PostingList& matches);
+
+    /**
+     * @brief matchTrigrams : determina i media di un campo che contengono tutti i trigrammi di un filtro (di almeno tre caratteri)
+     * @param field : indice del campo
+     * @param foldedQuery : filtro ridotto in minuscolo
+     * @param matches : posting list (ordinata) dei media trovati
+     */
+    static void matchTrigrams(const FieldIndex& field, const std::string& foldedQuery, PostingList& matches);
+
+    /**
+     * @brief matchTokens : determina i media di un campo che hanno token compatibili con i frammenti del filtro
+     * @param field : indice del campo
+     * @param foldedQuery : filtro ridotto in minuscolo
+     * @param matches : posting list (ordinata) dei media trovati
+     * @return bool : true se il filtro restringe la ricerca, false se e' composto da soli separatori
+     */
+    static bool matchTokens(const FieldIndex& field, const std::string& foldedQuery, PostingList& matches);
+
+    /**
+     * @brief tokenize : divide una stringa (gia' ridotta in minuscolo) nei suoi token distinti
+     * @param folded : stringa da dividere
+     * @return std::vector<std::string> : token distinti, ordinati
+     */
+    static std::vector<std::string> tokenize(const std::string& folded);
+
+    /**
+     * @brief trigrams : calcola i trigrammi distinti di una stringa (gia' ridotta in minuscolo)
+     * @param folded : stringa da cui estrarre i trigrammi
+     * @return std::vector<std::uint32_t> : trigrammi distinti (tre byte compattati in un intero), ordinati
+     */
+    static std::vector<std::uint32_t> trigrams(const std::string& folded);
+
+    static void addPosting(PostingList& list, unsigned int id);
+    static void removePosting(PostingList& list, unsigned int id);
+    static void intersectPostings(PostingList& result, const PostingList& other);
+
+    /**
+     * @brief collectPostings : raccoglie, per ogni posting list dei campi di piu' media (creandola se manca), gli identificatori da aggiungere
+     * @param media : media da indicizzare
+     * @return std::unordered_map : posting list -> identificatori, nell'ordine dei media
+     */
+    std::unordered_map<PostingList*, std::vector<unsigned int>> collectPostings(const std::vector<const Media::AbstractMedia*>& media);
+};
+
+}
+}
+
+#endif // MODEL_LIBRARY_SEARCH_INDEX_H
@@ -26,6 +26,12 @@
  *  Entrambi trattano il possibile match come "case-insensitive".
  *  Ad esempio, il match esatto e' solitamente fatto per 'mediaType', mentre il match parziale e' applicato ad esempio per 'mediaName'.
  *
+ *  I filtri ad intervallo (rating, dimensione, anno, durata, bitrate, risoluzione) hanno estremi inclusi, e un estremo a 0 non viene applicato.
+ *  Come per i filtri testuali specifici (es. 'audioArtist'), un filtro su un attributo che un tipo di media non possiede viene ignorato per quel tipo:
+ *  - anno di uscita/creazione e durata: Audio, Video, EBook (la durata di un EBook e' in pagine)
+ *  - bitrate: Audio
+ *  - risoluzione (verticale, es. 1080): Video, Image
+ *
  */
 
 namespace Model {
@@ -37,6 +43,15 @@ public:
 
     // === HELPER STATICI PER RICERCA ===
 
+    /**
+     * @brief foldCase : metodo helper statico, riduce un carattere in minuscolo (usato da tutti i confronti case-insensitive e da SearchIndex)
+     * @param c : carattere da convertire
+     * @return char : carattere convertito
+     */
+    static char foldCase(char c) {
+        return static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    }
+
     /**
      * @brief checkExactMatchCaseInsensitive : metodo helper statico, verifica se due stringhe sono esattamente uguali, ignorando maiuscole/minuscole (case-insensitive)
      * @param searchField : stringa rappresentante il campo di un media in cui cercare il match esatto
@@ -49,7 +64,7 @@ public:
 
         for (unsigned int i = 0; i < searchField.size(); ++i) {
 
-            if (std::tolower(searchField[i]) != std::tolower(queryValue[i])) {
+            if (foldCase(searchField[i]) != foldCase(queryValue[i])) {
                 return false;
             }
         }
@@ -68,19 +83,33 @@ public:
         if (queryValue.size() > searchField.size()) return false;
 
         for (unsigned int i = 0; i <= searchField.size() - queryValue.size(); ++i) {
-            unsigned int count = 0;
-            for (unsigned int j = 0; j < queryValue.size(); ++j) {
-                if (std::tolower(searchField[i+j]) == std::tolower(queryValue[j])) {
-                    ++count;
-                }
+            unsigned int j = 0;
+            // si interrompe al primo carattere diverso
+            while (j < queryValue.size() && foldCase(searchField[i+j]) == foldCase(queryValue[j])) {
+                ++j;
             }
-            if (count == queryValue.size()) {
+            if (j == queryValue.size()) {
                 return true;
             }
         }
         return false;
     }
 
+    /**
+     * @brief checkRange : metodo helper statico, verifica se un valore rientra in un intervallo (estremi inclusi, un estremo a 0 non viene applicato)
+     * @param value : valore da verificare
+     * @param minValue : estremo inferiore (0 se non impostato)
+     * @param maxValue : estremo superiore (0 se non impostato)
+     * @return bool : true se il valore rientra nell'intervallo, false altrimenti
+     */
+    template <typename T>
+    static bool checkRange(T value, T minValue, T maxValue) {
+
+        if (minValue != T() && value < minValue) return false;
+        if (maxValue != T() && value > maxValue) return false;
+        return true;
+    }
+
     // === GETTER FILTRI RICERCA ===
 
     // filtri comuni
@@ -94,6 +123,18 @@ public:
     unsigned int getMinimumMediaRating() const { return minimumMediaRating; }
     unsigned int getMaximumMediaRating() const { return maximumMediaRating; }
 
+    // filtri ad intervallo
+    float getMinimumFileSize() const { return minimumFileSize; }
+    float getMaximumFileSize() const { return maximumFileSize; }
+    unsigned int getMinimumReleaseYear() const { return minimumReleaseYear; }
+    unsigned int getMaximumReleaseYear() const { return maximumReleaseYear; }
+    unsigned int getMinimumLength() const { return minimumLength; }
+    unsigned int getMaximumLength() const { return maximumLength; }
+    unsigned int getMinimumBitRate() const { return minimumBitRate; }
+    unsigned int getMaximumBitRate() const { return maximumBitRate; }
+    unsigned int getMinimumResolution() const { return minimumResolution; }
+    unsigned int getMaximumResolution() const { return maximumResolution; }
+
     // filtri Audio
     const std::string& getAudioArtist() const { return audioArtist; }
     const std::string& getAudioAlbum() const { return audioAlbum; }
@@ -124,6 +165,18 @@ public:
     void setMinimumMediaRating(unsigned int minRtg) { minimumMediaRating = minRtg; }
     void setMaximumMediaRating(unsigned int maxRtg) { maximumMediaRating = maxRtg; }
 
+    // filtri ad intervallo
+    void setMinimumFileSize(float minSize) { minimumFileSize = minSize; }
+    void setMaximumFileSize(float maxSize) { maximumFileSize = maxSize; }
+    void setMinimumReleaseYear(unsigned int minYear) { minimumReleaseYear = minYear; }
+    void setMaximumReleaseYear(unsigned int maxYear) { maximumReleaseYear = maxYear; }
+    void setMinimumLength(unsigned int minLen) { minimumLength = minLen; }
+    void setMaximumLength(unsigned int maxLen) { maximumLength = maxLen; }
+    void setMinimumBitRate(unsigned int minBr) { minimumBitRate = minBr; }
+    void setMaximumBitRate(unsigned int maxBr) { maximumBitRate = maxBr; }
+    void setMinimumResolution(unsigned int minRes) { minimumResolution = minRes; }
+    void setMaximumResolution(unsigned int maxRes) { maximumResolution = maxRes; }
+
     // filtri Audio
     void setAudioArtist(const std::string& art) { audioArtist = art; }
     void setAudioAlbum(const std::string& alb) { audioAlbum = alb; }
@@ -154,6 +207,8 @@ public:
         mediaID = 0;
         mediaName = "", mediaUploader = "", mediaFormat = "", mediaType = "", mediaGenre = "", mediaCategory = "";
         minimumMediaRating = 0, maximumMediaRating = 0;
+        minimumFileSize = 0.f, maximumFileSize = 0.f, minimumReleaseYear = 0, maximumReleaseYear = 0;
+        minimumLength = 0, maximumLength = 0, minimumBitRate = 0, maximumBitRate = 0, minimumResolution = 0, maximumResolution = 0;
         audioArtist = "", audioAlbum = "", videoDirector = ""; videoQuality = "";
         ebookAuthor = "", ebooPublisher = "", imageCreator = "", imageLocation = "";
         const_cast<SearchQuery*>(this)->searchResults.clear(); }
@@ -164,6 +219,25 @@ public:
     bool searchResultIsEmpty() const { return searchResults.empty(); }
     bool hasMediaTypeSet() const { return !mediaType.empty(); }
 
+    /** @brief hasTextFilters : verifica se e' impostato almeno uno dei filtri testuali applicati da SearchVisitor */
+    bool hasTextFilters() const {
+        return !mediaName.empty() || !mediaUploader.empty() || !mediaFormat.empty() || !mediaGenre.empty() ||
+               !audioArtist.empty() || !videoDirector.empty() || !ebookAuthor.empty() || !ebooPublisher.empty() ||
+               !imageCreator.empty() || !imageLocation.empty();
+    }
+
+    /** @brief hasRangeFilters : verifica se e' impostato almeno uno dei filtri ad intervallo (escluso il rating) */
+    bool hasRangeFilters() const {
+        return minimumFileSize != 0.f || maximumFileSize != 0.f || minimumReleaseYear != 0 || maximumReleaseYear != 0 ||
+               minimumLength != 0 || maximumLength != 0 || minimumBitRate != 0 || maximumBitRate != 0 ||
+               minimumResolution != 0 || maximumResolution != 0;
+    }
+
+    /** @brief hasFilters : verifica se e' impostato almeno un filtro (se nessun filtro e' impostato, la ricerca trova tutti i media) */
+    bool hasFilters() const {
+        return mediaID != 0 || hasMediaTypeSet() || hasTextFilters() || hasRangeFilters() || minimumMediaRating != 0 || maximumMediaRating != 0;
+    }
+
 
     // === HELPER PER MOSTRARE FILTRI RICERCA ===
 
@@ -182,6 +256,17 @@ public:
         if (!getMediaGenre().empty()) filters += "Genre: " + getMediaGenre() + " | ";
         if (!getMediaCategory().empty()) filters += "Category: " + getMediaCategory() + " | ";
         if (getMinimumMediaRating() != 0) filters += "Min Rating: " + std::to_string(getMinimumMediaRating()) + "/100 | ";
+        if (getMaximumMediaRating() != 0) filters += "Max Rating: " + std::to_string(getMaximumMediaRating()) + "/100 | ";
+        if (getMinimumFileSize() != 0.f) filters += "Min Size: " + std::to_string(getMinimumFileSize()) + " MB | ";
+        if (getMaximumFileSize() != 0.f) filters += "Max Size: " + std::to_string(getMaximumFileSize()) + " MB | ";
+        if (getMinimumReleaseYear() != 0) filters += "Min Year: " + std::to_string(getMinimumReleaseYear()) + " | ";
+        if (getMaximumReleaseYear() != 0) filters += "Max Year: " + std::to_string(getMaximumReleaseYear()) + " | ";
+        if (getMinimumLength() != 0) filters += "Min Length: " + std::to_string(getMinimumLength()) + " | ";
+        if (getMaximumLength() != 0) filters += "Max Length: " + std::to_string(getMaximumLength()) + " | ";
+        if (getMinimumBitRate() != 0) filters += "Min Bitrate: " + std::to_string(getMinimumBitRate()) + " kbps | ";
+        if (getMaximumBitRate() != 0) filters += "Max Bitrate: " + std::to_string(getMaximumBitRate()) + " kbps | ";
+        if (getMinimumResolution() != 0) filters += "Min Resolution: " + std::to_string(getMinimumResolution()) + "p | ";
+        if (getMaximumResolution() != 0) filters += "Max Resolution: " + std::to_string(getMaximumResolution()) + "p | ";
         if (!getAudioArtist().empty()) filters += "Artist: " + getAudioArtist() + " | ";
         if (!getAudioAlbum().empty()) filters += "Album: " + getAudioAlbum() + " | ";
         if (!getVideoDirector().empty()) filters += "Director: " + getVideoDirector() + " | ";
@@ -211,6 +296,19 @@ private:
     std::string mediaGenre = "";
     std::string mediaCategory = "";
 
+    // === FILTRI AD INTERVALLO ===
+
+    float minimumFileSize = 0.f;
+    float maximumFileSize = 0.f;
+    unsigned int minimumReleaseYear = 0;
+    unsigned int maximumReleaseYear = 0;
+    unsigned int minimumLength = 0;
+    unsigned int maximumLength = 0;
+    unsigned int minimumBitRate = 0;
+    unsigned int maximumBitRate = 0;
+    unsigned int minimumResolution = 0;
+    unsigned int maximumResolution = 0;
+
     // === FILTRI SPECIFICI ===
 
     // filtri Audio
@@ -0,0 +1,59 @@
+#ifndef MODEL_LOGGERS_I_BUFFER_LOGGER_H
+#define MODEL_LOGGERS_I_BUFFER_LOGGER_H
+
+#include "IMediaLogger.h"
+
+#include <mutex>
+#include <string>
+#include <vector>
+
+/** @brief IBufferLogger
+ *
+ *  IBufferLogger e' una sottoclasse concreta di IMediaLogger.
+ *  Va a ridefinire il metodo virtuale puro 'logMessage' per conservare i messaggi in memoria, protetti da un mutex, in modo da poter essere
+ *  usato da un thread secondario (ad esempio durante un caricamento in background). I messaggi vengono poi inoltrati, nello stesso ordine,
+ *  al logger concreto della libreria con 'flushTo'.
+ */
+
+namespace Model {
+namespace Loggers {
+
+class IBufferLogger : public IMediaLogger {
+public:
+
+    /**
+     * @brief logMessage : virtuale puro ereditato da IMediaLogger, aggiunge il messaggio al buffer
+     * @param msg : messaggio da "loggare"
+     */
+    void logMessage(const std::string& msg) override {
+        std::lock_guard<std::mutex> lock(bufferMutex);
+        messages.push_back(msg);
+    }
+
+    /**
+     * @brief flushTo : inoltra i messaggi conservati a un altro logger, svuotando il buffer
+     * @param logger : logger a cui inoltrare i messaggi (se 'nullptr' i messaggi vengono solo scartati)
+     */
+    void flushTo(IMediaLogger* logger) {
+        std::vector<std::string> pending;
+        {
+            std::lock_guard<std::mutex> lock(bufferMutex);
+            pending.swap(messages);
+        }
+        if (logger) {
+            for (const auto& msg : pending) {
+                logger->logMessage(msg);
+            }
+        }
+    }
+
+private:
+
+    std::mutex bufferMutex;               // protegge 'messages'
+    std::vector<std::string> messages;    // messaggi non ancora inoltrati
+};
+
+}
+}
+
+#endif // MODEL_LOGGERS_I_BUFFER_LOGGER_H
@@ -10,17 +10,32 @@ const float AbstractFile::MIN_FILE_SIZE = 0.0001;
 const float AbstractFile::MAX_FILE_SIZE = 12000.000;
 
 unsigned int AbstractFile::uniqueIDCounter = 1;
+thread_local const AbstractFile::ReservedUniqueID* AbstractFile::reservedUniqueID = nullptr;
 const std::string AbstractFile::defaultPath = "Home";
 const float AbstractFile::defaultSize = 5.0;
 
-unsigned int AbstractFile::incrementUniqueIDCounter() { return uniqueIDCounter++; }
+unsigned int AbstractFile::incrementUniqueIDCounter() {
+    if (reservedUniqueID) {
+        return reservedUniqueID->reservedID;
+    }
+    return uniqueIDCounter++;
+}
 
 void AbstractFile::setCurrentUniqueID(unsigned int currID) {
-    if (currID > uniqueIDCounter) {
+    if (!reservedUniqueID && currID > uniqueIDCounter) {
         uniqueIDCounter = currID;
     }
 }
 
+AbstractFile::ReservedUniqueID::ReservedUniqueID(unsigned int id)
+    : reservedID(id),
+    previous(reservedUniqueID)
+{
+    reservedUniqueID = this;
+}
+
+AbstractFile::ReservedUniqueID::~ReservedUniqueID() { reservedUniqueID = previous; }
+
 AbstractFile::AbstractFile()
     : uniqueID(incrementUniqueIDCounter()),
     filePath(defaultPath),
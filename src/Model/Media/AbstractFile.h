@@ -15,6 +15,8 @@
  *  L'identificatore di ciascun media e' considerato univoco e immutabile, e viene salvato in un contatore statico 'uniqueIDCounter' che viene
  *  incrementato ad ogni invocazione del costruttore di AbstractMedia. Inoltre, e' possible "settarlo" tramite il metodo statico 'setCurrentUniqueID'.
  *  Questo torna utile, ad esempio, per impostarlo in base all'ultimo valore usato in una esecuzione precedente della libreria virtuale.
+ *  Il contatore non e' protetto da accessi concorrenti: i thread che costruiscono media in parallelo devono usare identificatori riservati
+ *  in anticipo, tramite 'ReservedUniqueID'.
  *
  *  NOTA: L'identificatore del media e' considerato univoco per ogni sessione di esecuzione. Quando viene salvato su file un media, non viene salvato il suo
  *  identificatore. Quindi, quando viene nuovamente caricato da file il media in una nuova sessione, gli viene dato un nuovo identificatore pur avendo gli
@@ -76,6 +78,30 @@ public:
     static void setCurrentUniqueID(unsigned int currID);
 
 
+    // === IDENTIFICATORI RISERVATI ===
+
+    /** @brief ReservedUniqueID
+     *
+     *  Finche' esiste un oggetto ReservedUniqueID, i media costruiti dal thread corrente ricevono l'identificatore riservato invece del valore
+     *  del contatore statico, e 'setCurrentUniqueID' non ha effetto per quel thread. Il contatore statico non viene quindi ne' letto ne' modificato,
+     *  e il chiamante e' responsabile sia dell'unicita' dell'identificatore che dell'aggiornamento del contatore.
+     */
+    class ReservedUniqueID {
+    public:
+        /** @param id : identificatore da assegnare ai media costruiti dal thread corrente */
+        explicit ReservedUniqueID(unsigned int id);
+        ~ReservedUniqueID();
+
+        ReservedUniqueID(const ReservedUniqueID&) = delete;
+        ReservedUniqueID& operator=(const ReservedUniqueID&) = delete;
+
+    private:
+        friend class AbstractFile;
+        unsigned int reservedID;
+        const ReservedUniqueID* previous;    // riserva sostituita (per riserve annidate)
+    };
+
+
     // === METODI VIRTUALI PURI ===
 
     /**
@@ -124,6 +150,10 @@ protected:
      * @return unsigned int : contatore dell'identificatore univoco, incrementato di 1
      */
     static unsigned int incrementUniqueIDCounter();
+
+private:
+
+    static thread_local const ReservedUniqueID* reservedUniqueID;    // riserva attiva nel thread corrente, 'nullptr' se assente
 };
 
 }
@@ -75,6 +75,7 @@ Audio& Audio::operator=(const Audio& audio) {
         AbstractMedia::operator=(audio);
         this->artist = audio.artist;
         this->genre = audio.genre;
+        this->album = audio.album;
         this->releaseYear = audio.releaseYear;
         this->lengthInMinutes = audio.lengthInMinutes;
         this->bitRate = audio.bitRate;
@@ -0,0 +1,137 @@
+#include "AttributeReader.h"
+#include "Model/Media/Audio.h"
+#include "Model/Media/EBook.h"
+#include "Model/Media/Video.h"
+#include "Model/Media/Image.h"
+
+#include <algorithm>
+#include <charconv>
+
+namespace Model {
+namespace Visitors {
+
+namespace {
+
+// rappresentazione piu' breve che rilegge lo stesso float (con std::stof, come in MediaEditor)
+std::string floatToString(float value) {
+
+    char digits[32];
+    auto result = std::to_chars(digits, digits + sizeof(digits), value);
+    return std::string(digits, result.ptr);
+}
+
+std::string boolToString(bool value) { return value ? "true" : "false"; }
+
+}
+
+AttributeReader::AttributeReader(const std::vector<std::string>& names)
+    : attributeNames(names) {}
+
+
+// === GETTER ===
+
+const std::unordered_map<std::string, std::string>& AttributeReader::getValues() const { return values; }
+
+std::size_t AttributeReader::estimateMemoryUsage(const Media::AbstractMedia& media) {
+
+    AttributeReader reader;
+    media.accept(reader);
+
+    // l'oggetto piu' grande tra i tipi di media, piu' il contenuto delle stringhe (i valori numerici sono gia' contati nell'oggetto)
+    std::size_t memory = std::max({ sizeof(Media::Audio), sizeof(Media::Video), sizeof(Media::EBook), sizeof(Media::Image) });
+    for (const auto& value : reader.getValues()) {
+        memory += value.second.size();
+    }
+    return memory;
+}
+
+
+// === RIDEFINIZIONE VIRTUALI PURI IConstVisitor ===
+
+void AttributeReader::visit(const Media::Audio& audio) const {
+
+    readCommonValues(audio);
+    readValue("artist", audio.getArtist());
+    readValue("genre", audio.getGenre());
+    readValue("album", audio.getAlbum());
+    readValue("releaseYear", std::to_string(audio.getReleaseYear()));
+    readValue("length", std::to_string(audio.getMediaLength()));
+    readValue("bitrate", std::to_string(audio.getBitRate()));
+    readValue("samplerate", floatToString(audio.getSampleRate()));
+    readValue("bitdepth", std::to_string(audio.getBitDepth()));
+    readValue("channels", std::to_string(audio.getAudioChannels()));
+    readValue("collaborators", audio.getCollaborators());
+}
+
+void AttributeReader::visit(const Media::Video& video) const {
+
+    readCommonValues(video);
+    readValue("director", video.getDirector());
+    readValue("genre", video.getGenre());
+    readValue("releaseYear", std::to_string(video.getCreationYear()));
+    readValue("length", std::to_string(video.getMediaLength()));
+    readValue("framerate", std::to_string(video.getFrameRate()));
+    readValue("width", std::to_string(video.getResolution().first));
+    readValue("height", std::to_string(video.getResolution().second));
+    readValue("colordepth", std::to_string(video.getVideoColorDepth()));
+    readValue("subtitles", video.getSubtitles());
+    readValue("language", video.getLanguage());
+}
+
+void AttributeReader::visit(const Media::EBook& ebook) const {
+
+    readCommonValues(ebook);
+    readValue("author", ebook.getAuthor());
+    readValue("publisher", ebook.getPublisher());
+    readValue("releaseYear", std::to_string(ebook.getReleaseYear()));
+    readValue("isbn", ebook.getISBN());
+    readValue("length", std::to_string(ebook.getMediaLength()));
+    readValue("category", ebook.getCategory());
+    readValue("language", ebook.getLanguage());
+    readValue("coverPath", ebook.getCoverImagePath());
+    readValue("hasImages", boolToString(ebook.hasImages()));
+}
+
+void AttributeReader::visit(const Media::Image& image) const {
+
+    readCommonValues(image);
+    readValue("dateCreated", image.getDateCreated());
+    readValue("imageCreator", image.getImageCreator());
+    readValue("imageCategory", image.getImageCategory());
+    readValue("resolutionWidth", std::to_string(image.getResolution().first));
+    readValue("resolutionHeight", std::to_string(image.getResolution().second));
+    readValue("aspectWidth", std::to_string(image.getImageAspectRatio().first));
+    readValue("aspectHeight", std::to_string(image.getImageAspectRatio().second));
+    readValue("bitdepth", std::to_string(image.getImageBitDepth()));
+    readValue("compressed", boolToString(image.isCompressed()));
+    readValue("location", image.getLocationTaken());
+}
+
+
+// === HELPER ===
+
+void AttributeReader::readCommonValues(const Media::AbstractMedia& media) const {
+
+    values.clear();
+    readValue("path", media.getFilePath());
+    readValue("size", floatToString(media.getFileSize()));
+    readValue("name", media.getMediaName());
+    readValue("uploader", media.getMediaUploader());
+    readValue("format", media.getMediaFormat());
+    readValue("rating", std::to_string(media.getMediaRating()));
+}
+
+bool AttributeReader::isRequested(const std::string& name) const {
+
+    return attributeNames.empty() || std::find(attributeNames.begin(), attributeNames.end(), name) != attributeNames.end();
+}
+
+void AttributeReader::readValue(const std::string& name, const std::string& value) const {
+
+    if (isRequested(name)) {
+        values[name] = value;
+    }
+}
+
+}
+}
@@ -0,0 +1,93 @@
+#ifndef MODEL_VISITORS_ATTRIBUTE_READER_H
+#define MODEL_VISITORS_ATTRIBUTE_READER_H
+
+#include "IConstVisitor.h"
+
+#include <unordered_map>
+#include <string>
+#include <vector>
+#include <cstddef>
+
+/** @brief AttributeReader
+ *
+ *  AttributeReader e' una sottoclasse concreta che deriva pubblicamente da IConstVisitor.
+ *  Legge i valori attuali di un insieme di attributi di un media, come coppie (nome attributo, valore attributo) con gli stessi nomi utilizzati da MediaEditor
+ *  (cioe' i nomi definiti nei vettori costanti statici dei builder concreti).
+ *
+ *  I valori sono scritti nello stesso formato letto da MediaEditor, in modo che riapplicandoli si ottenga esattamente lo stato letto:
+ *  i float vengono scritti con la rappresentazione piu' breve che rilegge lo stesso valore, i bool come "true"/"false".
+ *  Viene utilizzata da EditCommand per salvare il valore precedente dei soli campi modificati, invece di una copia dell'intero media.
+ *
+ *  Gli attributi richiesti che non appartengono al tipo visitato vengono ignorati. Se non viene richiesto alcun attributo, vengono letti tutti.
+ */
+
+namespace Model {
+namespace Visitors {
+
+class AttributeReader : public IConstVisitor {
+
+public:
+
+    // === COSTRUTTORE ===
+
+    /**
+     * @brief AttributeReader : costruttore, imposta gli attributi da leggere
+     * @param names : nomi degli attributi da leggere (con valore di default vuoto, cioe' tutti gli attributi)
+     */
+    explicit AttributeReader(const std::vector<std::string>& names = {});
+
+
+    // === GETTER ===
+
+    /** @brief getValues : restituisce i valori letti dall'ultimo media visitato, come coppie (nome attributo, valore attributo) */
+    const std::unordered_map<std::string, std::string>& getValues() const;
+
+    /**
+     * @brief estimateMemoryUsage : stima (approssimata) della memoria occupata da un media, cioe' l'oggetto e il contenuto dei suoi attributi
+     * @param media : media di cui stimare la memoria
+     * @return std::size_t : memoria stimata (in byte)
+     */
+    static std::size_t estimateMemoryUsage(const Media::AbstractMedia& media);
+
+
+    // === RIDEFINIZIONE VIRTUALI PURI IConstVisitor ===
+
+    /** @brief legge gli attributi richiesti di un media Audio */
+    void visit(const Media::Audio& audio) const override;
+    /** @brief legge gli attributi richiesti di un media EBook */
+    void visit(const Media::EBook& ebook) const override;
+    /** @brief legge gli attributi richiesti di un media Video */
+    void visit(const Media::Video& video) const override;
+    /** @brief legge gli attributi richiesti di un media Image */
+    void visit(const Media::Image& image) const override;
+
+private:
+
+    std::vector<std::string> attributeNames;                        // attributi da leggere (vuoto: tutti)
+    mutable std::unordered_map<std::string, std::string> values;    // valori letti dall'ultimo media visitato
+
+    /**
+     * @brief readCommonValues : svuota i valori e legge gli attributi comuni a tutti i media
+     * @param media : media visitato
+     */
+    void readCommonValues(const Media::AbstractMedia& media) const;
+
+    /**
+     * @brief isRequested : verifica se un attributo e' tra quelli da leggere
+     * @param name : nome dell'attributo
+     * @return bool : true se l'attributo va letto
+     */
+    bool isRequested(const std::string& name) const;
+
+    /**
+     * @brief readValue : salva il valore di un attributo, se richiesto
+     * @param name : nome dell'attributo
+     * @param value : valore dell'attributo (nel formato letto da MediaEditor)
+     */
+    void readValue(const std::string& name, const std::string& value) const;
+};
+
+}
+}
+
+#endif // MODEL_VISITORS_ATTRIBUTE_READER_H
@@ -0,0 +1,63 @@
+#include "ColumnVisitor.h"
+#include "Model/Media/Audio.h"
+#include "Model/Media/EBook.h"
+#include "Model/Media/Video.h"
+#include "Model/Media/Image.h"
+
+
+namespace Model {
+namespace Visitors {
+
+const Library::MediaColumns::Row& ColumnVisitor::getRow() const { return row; }
+
+
+void ColumnVisitor::visit(const Media::Audio& audio) const {
+
+    readCommonValues(audio, Library::MediaColumns::TypeTag::Audio);
+    row.year = audio.getReleaseYear();
+    row.length = audio.getMediaLength();
+    row.bitRate = audio.getBitRate();
+    row.sampleRate = audio.getSampleRate();
+    row.bitDepth = audio.getBitDepth();
+    row.channels = audio.getAudioChannels();
+}
+
+void ColumnVisitor::visit(const Media::Video& video) const {
+
+    readCommonValues(video, Library::MediaColumns::TypeTag::Video);
+    row.year = video.getCreationYear();
+    row.length = video.getMediaLength();
+    row.width = video.getResolution().first;
+    row.height = video.getResolution().second;
+    row.frameRate = video.getFrameRate();
+    row.flags = video.supportsHDR() ? Library::ScoreKernels::FLAG_HDR : 0;
+}
+
+void ColumnVisitor::visit(const Media::EBook& ebook) const {
+
+    readCommonValues(ebook, Library::MediaColumns::TypeTag::EBook);
+    row.year = ebook.getReleaseYear();
+    row.length = ebook.getMediaLength();
+}
+
+void ColumnVisitor::visit(const Media::Image& image) const {
+
+    readCommonValues(image, Library::MediaColumns::TypeTag::Image);
+    row.width = image.getResolution().first;
+    row.height = image.getResolution().second;
+    row.bitDepth = image.getImageBitDepth();
+    row.flags = image.isCompressed() ? Library::ScoreKernels::FLAG_COMPRESSED : 0;
+}
+
+
+void ColumnVisitor::readCommonValues(const Media::AbstractMedia& media, Library::MediaColumns::TypeTag tag) const {
+
+    row = Library::MediaColumns::Row();
+    row.uniqueID = media.getUniqueID();
+    row.typeTag = tag;
+    row.rating = media.getMediaRating();
+    row.fileSize = media.getFileSize();
+}
+
+}
+}
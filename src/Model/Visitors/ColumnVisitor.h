@@ -0,0 +1,54 @@
+#ifndef MODEL_VISITORS_COLUMN_VISITOR_H
+#define MODEL_VISITORS_COLUMN_VISITOR_H
+
+#include "IConstVisitor.h"
+#include "Model/Library/MediaColumns.h"
+
+/** @brief ColumnVisitor
+ *
+ *  ColumnVisitor e' una sottoclasse concreta che deriva pubblicamente da IConstVisitor.
+ *  Viene utilizzata da MediaColumns per leggere, in base al tipo concreto del media, i valori numerici di una riga dello snapshot colonnare.
+ *
+ *  Dopo la visita, il campo 'row' contiene i valori letti; gli attributi non applicabili al tipo visitato restano a 0.
+ */
+
+namespace Model {
+namespace Visitors {
+
+class ColumnVisitor : public IConstVisitor {
+
+public:
+
+    // === GETTER ===
+
+    /** @brief getRow : restituisce i valori letti dall'ultimo media visitato */
+    const Library::MediaColumns::Row& getRow() const;
+
+
+    // === RIDEFINIZIONE VIRTUALI PURI IConstVisitor ===
+
+    /** @brief legge i valori numerici di un media Audio */
+    void visit(const Media::Audio& audio) const override;
+    /** @brief legge i valori numerici di un media EBook */
+    void visit(const Media::EBook& ebook) const override;
+    /** @brief legge i valori numerici di un media Video */
+    void visit(const Media::Video& video) const override;
+    /** @brief legge i valori numerici di un media Image */
+    void visit(const Media::Image& image) const override;
+
+private:
+
+    /**
+     * @brief readCommonValues : reimposta la riga e legge i valori comuni a tutti i media
+     * @param media : media visitato
+     * @param tag : tipo concreto del media visitato
+     */
+    void readCommonValues(const Media::AbstractMedia& media, Library::MediaColumns::TypeTag tag) const;
+
+    mutable Library::MediaColumns::Row row;    // valori dell'ultimo media visitato
+};
+
+}
+}
+
+#endif // MODEL_VISITORS_COLUMN_VISITOR_H
@@ -0,0 +1,59 @@
+#include "IndexVisitor.h"
+#include "Model/Media/Audio.h"
+#include "Model/Media/EBook.h"
+#include "Model/Media/Video.h"
+#include "Model/Media/Image.h"
+
+
+namespace Model {
+namespace Visitors {
+
+IndexVisitor::IndexVisitor()
+    : indexedType(IndexedType::Audio)
+{}
+
+IndexVisitor::IndexedType IndexVisitor::getIndexedType() const { return indexedType; }
+
+const std::vector<std::pair<IndexVisitor::IndexedField, const std::string*>>& IndexVisitor::getIndexedFields() const { return indexedFields; }
+
+
+void IndexVisitor::visit(const Media::Audio& audio) const {
+
+    collectCommonFields(audio, IndexedType::Audio);
+    indexedFields.emplace_back(IndexedField::Artist, &audio.getArtist());
+    indexedFields.emplace_back(IndexedField::Genre, &audio.getGenre());
+}
+
+void IndexVisitor::visit(const Media::Video& video) const {
+
+    collectCommonFields(video, IndexedType::Video);
+    indexedFields.emplace_back(IndexedField::Director, &video.getDirector());
+    indexedFields.emplace_back(IndexedField::Genre, &video.getGenre());
+}
+
+void IndexVisitor::visit(const Media::EBook& ebook) const {
+
+    collectCommonFields(ebook, IndexedType::EBook);
+    indexedFields.emplace_back(IndexedField::Author, &ebook.getAuthor());
+    indexedFields.emplace_back(IndexedField::Publisher, &ebook.getPublisher());
+}
+
+void IndexVisitor::visit(const Media::Image& image) const {
+
+    collectCommonFields(image, IndexedType::Image);
+    indexedFields.emplace_back(IndexedField::Creator, &image.getImageCreator());
+    indexedFields.emplace_back(IndexedField::Location, &image.getLocationTaken());
+}
+
+
+void IndexVisitor::collectCommonFields(const Media::AbstractMedia& media, IndexedType type) const {
+
+    indexedType = type;
+    indexedFields.clear();
+    indexedFields.emplace_back(IndexedField::Name, &media.getMediaName());
+    indexedFields.emplace_back(IndexedField::Uploader, &media.getMediaUploader());
+    indexedFields.emplace_back(IndexedField::Format, &media.getMediaFormat());
+}
+
+}
+}
@@ -0,0 +1,75 @@
+#ifndef MODEL_VISITORS_INDEX_VISITOR_H
+#define MODEL_VISITORS_INDEX_VISITOR_H
+
+#include "IConstVisitor.h"
+#include "Model/Library/SearchIndex.h"
+
+#include <string>
+#include <vector>
+#include <utility>
+
+/** @brief IndexVisitor
+ *
+ *  IndexVisitor e' una sottoclasse concreta che deriva pubblicamente da IConstVisitor.
+ *  Viene utilizzata da SearchIndex per raccogliere, in base al tipo concreto del media, i campi testuali da indicizzare.
+ *
+ *  Dopo la visita, 'indexedType' contiene il tipo concreto del media e 'indexedFields' le coppie (campo, valore).
+ *  I valori sono puntatori ai campi del media visitato, e restano validi solo finche' il media non viene modificato o distrutto.
+ */
+
+namespace Model {
+namespace Visitors {
+
+class IndexVisitor : public IConstVisitor {
+
+public:
+
+    using IndexedField = Library::SearchIndex::IndexedField;
+    using IndexedType = Library::SearchIndex::IndexedType;
+
+
+    // === COSTRUTTORE DI DEFAULT ===
+
+    /**
+     * @brief IndexVisitor : costruttore di default, inizializza campi privati
+     */
+    IndexVisitor();
+
+
+    // === GETTER ===
+
+    /** @brief getIndexedType : restituisce il tipo concreto dell'ultimo media visitato */
+    IndexedType getIndexedType() const;
+
+    /** @brief getIndexedFields : restituisce i campi testuali dell'ultimo media visitato */
+    const std::vector<std::pair<IndexedField, const std::string*>>& getIndexedFields() const;
+
+
+    // === RIDEFINIZIONE VIRTUALI PURI IConstVisitor ===
+
+    /** @brief raccoglie i campi indicizzati di un media Audio */
+    void visit(const Media::Audio& audio) const override;
+    /** @brief raccoglie i campi indicizzati di un media EBook */
+    void visit(const Media::EBook& ebook) const override;
+    /** @brief raccoglie i campi indicizzati di un media Video */
+    void visit(const Media::Video& video) const override;
+    /** @brief raccoglie i campi indicizzati di un media Image */
+    void visit(const Media::Image& image) const override;
+
+private:
+
+    /**
+     * @brief collectCommonFields : reimposta il visitor e raccoglie i campi comuni a tutti i media
+     * @param media : media visitato
+     * @param type : tipo concreto del media visitato
+     */
+    void collectCommonFields(const Media::AbstractMedia& media, IndexedType type) const;
+
+    mutable IndexedType indexedType;                                             // tipo dell'ultimo media visitato
+    mutable std::vector<std::pair<IndexedField, const std::string*>> indexedFields; // campi dell'ultimo media visitato
+};
+
+}
+}
+
+#endif // MODEL_VISITORS_INDEX_VISITOR_H
@@ -0,0 +1,174 @@
+#include "JsonRecordDecoder.h"
+#include "Model/Media/Audio.h"
+#include "Model/Media/EBook.h"
+#include "Model/Media/Video.h"
+#include "Model/Media/Image.h"
+
+
+namespace Model {
+namespace Visitors {
+
+JsonRecordDecoder::JsonRecordDecoder(const Library::JsonRecord& jsonRecord)
+    : record(jsonRecord)
+{}
+
+
+void JsonRecordDecoder::visit(Media::Audio& audio) {
+
+    readCommonFields(audio);
+    if (record.isString("artist")) {
+        audio.setArtist(record.toString("artist"));
+    }
+    if (record.isString("genre")) {
+        audio.setGenre(record.toString("genre"));
+    }
+    if (record.isString("album")) {
+        audio.setAlbum(record.toString("album"));
+    }
+    if (record.isDouble("releaseYear")) {
+        audio.setReleaseYear(static_cast<unsigned int>(record.toInt("releaseYear")));
+    }
+    if (record.isDouble("length")) {
+        audio.setMediaLength(static_cast<unsigned int>(record.toInt("length")));
+    }
+    if (record.isDouble("bitrate")) {
+        audio.setBitRate(static_cast<unsigned int>(record.toInt("bitrate")));
+    }
+    if (record.isDouble("samplerate")) {
+        audio.setSampleRate(static_cast<float>(record.toDouble("samplerate")));
+    }
+    if (record.isDouble("bitdepth")) {
+        audio.setBitDepth(static_cast<unsigned int>(record.toInt("bitdepth")));
+    }
+    if (record.isDouble("channels")) {
+        audio.setAudioChannels(static_cast<unsigned int>(record.toInt("channels")));
+    }
+    if (record.isString("collaborators")) {
+        audio.setCollaborators(record.toString("collaborators"));
+    }
+}
+
+void JsonRecordDecoder::visit(Media::Video& video) {
+
+    readCommonFields(video);
+    if (record.isString("director")) {
+        video.setDirector(record.toString("director"));
+    }
+    if (record.isString("genre")) {
+        video.setGenre(record.toString("genre"));
+    }
+    if (record.isDouble("releaseYear")) {
+        video.setCreationYear(static_cast<unsigned int>(record.toInt("releaseYear")));
+    }
+    if (record.isDouble("length")) {
+        video.setMediaLength(static_cast<unsigned int>(record.toInt("length")));
+    }
+    if (record.isDouble("framerate")) {
+        video.setFrameRate(static_cast<unsigned int>(record.toInt("framerate")));
+    }
+    if (record.isDouble("width") && record.isDouble("height")) {
+        video.setResolution({ record.toInt("width"), record.toInt("height") });
+    }
+    if (record.isDouble("colordepth")) {
+        video.setVideoColorDepth(static_cast<unsigned int>(record.toInt("colordepth")));
+    }
+    if (record.isString("subtitles")) {
+        video.setSubtitles(record.toString("subtitles"));
+    }
+    if (record.isString("language")) {
+        video.setLanguage(record.toString("language"));
+    }
+}
+
+void JsonRecordDecoder::visit(Media::EBook& ebook) {
+
+    readCommonFields(ebook);
+    if (record.isString("author")) {
+        ebook.setAuthor(record.toString("author"));
+    }
+    if (record.isString("publisher")) {
+        ebook.setPublisher(record.toString("publisher"));
+    }
+    if (record.isDouble("releaseYear")) {
+        ebook.setReleaseYear(static_cast<unsigned int>(record.toInt("releaseYear")));
+    }
+    if (record.isString("isbn")) {
+        ebook.setISBN(record.toString("isbn"));
+    }
+    if (record.isDouble("length")) {
+        ebook.setMediaLength(static_cast<unsigned int>(record.toInt("length")));
+    }
+    if (record.isString("category")) {
+        ebook.setCategory(record.toString("category"));
+    }
+    if (record.isString("language")) {
+        ebook.setLanguage(record.toString("language"));
+    }
+    if (record.isString("coverPath")) {
+        ebook.setCoverImagePath(record.toString("coverPath"));
+    }
+    if (record.isBool("hasImages")) {
+        ebook.setImages(record.toBool("hasImages"));
+    }
+}
+
+void JsonRecordDecoder::visit(Media::Image& image) {
+
+    readCommonFields(image);
+    if (record.isString("dateCreated")) {
+        image.setDateCreated(record.toString("dateCreated"));
+    }
+    if (record.isString("imageCreator")) {
+        image.setImageCreator(record.toString("imageCreator"));
+    }
+    if (record.isString("imageCategory")) {
+        image.setImageCategory(record.toString("imageCategory"));
+    }
+    if (record.isDouble("resolutionWidth") && record.isDouble("resolutionHeight")) {
+        image.setResolution({ record.toInt("resolutionWidth"), record.toInt("resolutionHeight") });
+    }
+    if (record.isDouble("aspectWidth") && record.isDouble("aspectHeight")) {
+        image.setImageAspectRatio({ record.toInt("aspectWidth"), record.toInt("aspectHeight") });
+    }
+    if (record.isDouble("bitdepth")) {
+        image.setImageBitDepth(static_cast<unsigned int>(record.toInt("bitdepth")));
+    }
+    if (record.isBool("compressed")) {
+        image.setImageCompression(record.toBool("compressed"));
+    }
+    if (record.isString("location")) {
+        image.setImageLocationTaken(record.toString("location"));
+    }
+}
+
+
+void JsonRecordDecoder::readCommonFields(Media::AbstractMedia& media) {
+
+    // campi ereditati da AbstractFile
+    if (record.isDouble("uniqueID")) {
+        Media::AbstractFile::setCurrentUniqueID(static_cast<unsigned int>(record.toInt("uniqueID")));
+    }
+    if (record.isString("path")) {
+        media.setFilePath(record.toString("path"));
+    }
+    if (record.isDouble("size")) {
+        media.setFileSize(static_cast<float>(record.toDouble("size")));
+    }
+
+    // campi ereditati da AbstractMedia
+    if (record.isString("name")) {
+        media.setMediaName(record.toString("name"));
+    }
+    if (record.isString("uploader")) {
+        media.setMediaUploader(record.toString("uploader"));
+    }
+    if (record.isString("format")) {
+        media.setMediaFormat(record.toString("format"));
+    }
+    if (record.isDouble("rating")) {
+        media.setMediaRating(static_cast<unsigned int>(record.toInt("rating")));
+    }
+}
+
+}
+}
@@ -0,0 +1,57 @@
+#ifndef MODEL_VISITORS_JSON_RECORD_DECODER_H
+#define MODEL_VISITORS_JSON_RECORD_DECODER_H
+
+#include "IVisitor.h"
+#include "Model/Library/JsonStreamReader.h"
+
+/** @brief JsonRecordDecoder
+ *
+ *  JsonRecordDecoder e' una sottoclasse concreta che deriva pubblicamente da IVisitor.
+ *  Viene utilizzata dal caricamento in streaming di Library per impostare gli attributi di un media, appena creato, a partire da un JsonRecord
+ *  letto da file, senza passare da un QJsonObject.
+ *
+ *  Chiavi, controlli sul tipo e conversioni sono gli stessi di 'fromJson' di ciascun media: i campi mancanti o di tipo errato vengono ignorati.
+ */
+
+namespace Model {
+namespace Visitors {
+
+class JsonRecordDecoder : public IVisitor {
+
+public:
+
+    // === COSTRUTTORE ===
+
+    /**
+     * @brief JsonRecordDecoder : costruttore
+     * @param jsonRecord : record con i campi del media
+     */
+    explicit JsonRecordDecoder(const Library::JsonRecord& jsonRecord);
+
+
+    // === RIDEFINIZIONE VIRTUALI PURI IVisitor ===
+
+    /** @brief legge gli attributi di un media Audio */
+    void visit(Media::Audio& audio) override;
+    /** @brief legge gli attributi di un media EBook */
+    void visit(Media::EBook& ebook) override;
+    /** @brief legge gli attributi di un media Video */
+    void visit(Media::Video& video) override;
+    /** @brief legge gli attributi di un media Image */
+    void visit(Media::Image& image) override;
+
+private:
+
+    const Library::JsonRecord& record;
+
+    /**
+     * @brief readCommonFields : legge i campi comuni a tutti i media
+     * @param media : media da impostare
+     */
+    void readCommonFields(Media::AbstractMedia& media);
+};
+
+}
+}
+
+#endif // MODEL_VISITORS_JSON_RECORD_DECODER_H
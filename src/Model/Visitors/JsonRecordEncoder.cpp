@@ -0,0 +1,138 @@
+#include "JsonRecordEncoder.h"
+#include "Model/Media/Audio.h"
+#include "Model/Media/EBook.h"
+#include "Model/Media/Video.h"
+#include "Model/Media/Image.h"
+
+
+namespace Model {
+namespace Visitors {
+
+JsonRecordEncoder::JsonRecordEncoder(Library::JsonStreamWriter& jsonWriter)
+    : writer(jsonWriter)
+{}
+
+// i valori interi sono convertiti come in 'toJson' (static_cast<int>), i float vengono scritti come double
+
+void JsonRecordEncoder::visit(const Media::Audio& audio) const {
+
+    writer.beginObject();
+    writeString("album", audio.getAlbum());
+    writeString("artist", audio.getArtist());
+    writeInt("bitdepth", static_cast<int>(audio.getBitDepth()));
+    writeInt("bitrate", static_cast<int>(audio.getBitRate()));
+    writeInt("channels", static_cast<int>(audio.getAudioChannels()));
+    writeString("collaborators", audio.getCollaborators());
+    writeString("format", audio.getMediaFormat());
+    writeString("genre", audio.getGenre());
+    writeInt("length", static_cast<int>(audio.getMediaLength()));
+    writeString("mediaType", "AUDIO");
+    writeString("name", audio.getMediaName());
+    writeString("path", audio.getFilePath());
+    writeInt("rating", static_cast<int>(audio.getMediaRating()));
+    writeInt("releaseYear", static_cast<int>(audio.getReleaseYear()));
+    writeDouble("samplerate", audio.getSampleRate());
+    writeDouble("size", audio.getFileSize());
+    writeInt("uniqueID", static_cast<int>(audio.getUniqueID()));
+    writeString("uploader", audio.getMediaUploader());
+    writer.endObject();
+}
+
+void JsonRecordEncoder::visit(const Media::Video& video) const {
+
+    writer.beginObject();
+    writeInt("colordepth", static_cast<int>(video.getVideoColorDepth()));
+    writeString("director", video.getDirector());
+    writeString("format", video.getMediaFormat());
+    writeInt("framerate", static_cast<int>(video.getFrameRate()));
+    writeString("genre", video.getGenre());
+    writeInt("height", video.getResolution().second);
+    writeString("language", video.getLanguage());
+    writeInt("length", static_cast<int>(video.getMediaLength()));
+    writeString("mediaType", "VIDEO");
+    writeString("name", video.getMediaName());
+    writeString("path", video.getFilePath());
+    writeInt("rating", static_cast<int>(video.getMediaRating()));
+    writeInt("releaseYear", static_cast<int>(video.getCreationYear()));
+    writeDouble("size", video.getFileSize());
+    writeString("subtitles", video.getSubtitles());
+    writeInt("uniqueID", static_cast<int>(video.getUniqueID()));
+    writeString("uploader", video.getMediaUploader());
+    writeInt("width", video.getResolution().first);
+    writer.endObject();
+}
+
+void JsonRecordEncoder::visit(const Media::EBook& ebook) const {
+
+    writer.beginObject();
+    writeString("author", ebook.getAuthor());
+    writeString("category", ebook.getCategory());
+    writeString("coverPath", ebook.getCoverImagePath());
+    writeString("format", ebook.getMediaFormat());
+    writeBool("hasImages", ebook.hasImages());
+    writeString("isbn", ebook.getISBN());
+    writeString("language", ebook.getLanguage());
+    writeInt("length", static_cast<int>(ebook.getMediaLength()));
+    writeString("mediaType", "EBOOK");
+    writeString("name", ebook.getMediaName());
+    writeString("path", ebook.getFilePath());
+    writeString("publisher", ebook.getPublisher());
+    writeInt("rating", static_cast<int>(ebook.getMediaRating()));
+    writeInt("releaseYear", static_cast<int>(ebook.getReleaseYear()));
+    writeDouble("size", ebook.getFileSize());
+    writeInt("uniqueID", static_cast<int>(ebook.getUniqueID()));
+    writeString("uploader", ebook.getMediaUploader());
+    writer.endObject();
+}
+
+void JsonRecordEncoder::visit(const Media::Image& image) const {
+
+    writer.beginObject();
+    writeInt("aspectHeight", image.getImageAspectRatio().second);
+    writeInt("aspectWidth", image.getImageAspectRatio().first);
+    writeInt("bitdepth", static_cast<int>(image.getImageBitDepth()));
+    writeBool("compressed", image.isCompressed());
+    writeString("dateCreated", image.getDateCreated());
+    writeString("format", image.getMediaFormat());
+    writeString("imageCategory", image.getImageCategory());
+    writeString("imageCreator", image.getImageCreator());
+    writeString("location", image.getLocationTaken());
+    writeString("mediaType", "IMAGE");
+    writeString("name", image.getMediaName());
+    writeString("path", image.getFilePath());
+    writeInt("rating", static_cast<int>(image.getMediaRating()));
+    writeInt("resolutionHeight", image.getResolution().second);
+    writeInt("resolutionWidth", image.getResolution().first);
+    writeDouble("size", image.getFileSize());
+    writeInt("uniqueID", static_cast<int>(image.getUniqueID()));
+    writeString("uploader", image.getMediaUploader());
+    writer.endObject();
+}
+
+
+void JsonRecordEncoder::writeString(const char* key, const std::string& value) const {
+
+    writer.writeKey(key);
+    writer.writeString(value);
+}
+
+void JsonRecordEncoder::writeInt(const char* key, long long value) const {
+
+    writer.writeKey(key);
+    writer.writeInt(value);
+}
+
+void JsonRecordEncoder::writeDouble(const char* key, double value) const {
+
+    writer.writeKey(key);
+    writer.writeDouble(value);
+}
+
+void JsonRecordEncoder::writeBool(const char* key, bool value) const {
+
+    writer.writeKey(key);
+    writer.writeBool(value);
+}
+
+}
+}
@@ -0,0 +1,57 @@
+#ifndef MODEL_VISITORS_JSON_RECORD_ENCODER_H
+#define MODEL_VISITORS_JSON_RECORD_ENCODER_H
+
+#include "IConstVisitor.h"
+#include "Model/Library/JsonStreamWriter.h"
+
+/** @brief JsonRecordEncoder
+ *
+ *  JsonRecordEncoder e' una sottoclasse concreta che deriva pubblicamente da IConstVisitor.
+ *  Viene utilizzata dal salvataggio in streaming di Library per scrivere l'oggetto JSON di un media direttamente su un JsonStreamWriter,
+ *  senza passare da un QJsonObject.
+ *
+ *  Chiavi e valori sono gli stessi di 'toJson' di ciascun media. Le chiavi vengono scritte in ordine alfabetico, come avviene per QJsonObject,
+ *  in modo che il file prodotto sia identico a quello ottenuto con QJsonDocument.
+ */
+
+namespace Model {
+namespace Visitors {
+
+class JsonRecordEncoder : public IConstVisitor {
+
+public:
+
+    // === COSTRUTTORE ===
+
+    /**
+     * @brief JsonRecordEncoder : costruttore
+     * @param jsonWriter : writer su cui scrivere gli oggetti JSON
+     */
+    explicit JsonRecordEncoder(Library::JsonStreamWriter& jsonWriter);
+
+
+    // === RIDEFINIZIONE VIRTUALI PURI IConstVisitor ===
+
+    /** @brief scrive l'oggetto JSON di un media Audio */
+    void visit(const Media::Audio& audio) const override;
+    /** @brief scrive l'oggetto JSON di un media EBook */
+    void visit(const Media::EBook& ebook) const override;
+    /** @brief scrive l'oggetto JSON di un media Video */
+    void visit(const Media::Video& video) const override;
+    /** @brief scrive l'oggetto JSON di un media Image */
+    void visit(const Media::Image& image) const override;
+
+private:
+
+    Library::JsonStreamWriter& writer;
+
+    void writeString(const char* key, const std::string& value) const;
+    void writeInt(const char* key, long long value) const;
+    void writeDouble(const char* key, double value) const;
+    void writeBool(const char* key, bool value) const;
+};
+
+}
+}
+
+#endif // MODEL_VISITORS_JSON_RECORD_ENCODER_H
@@ -97,6 +97,10 @@ bool SearchVisitor::checkCommonMatches(const Media::AbstractMedia& media) const
         }
     }
 
+    if (!Library::SearchQuery::checkRange(media.getFileSize(), searchQuery.getMinimumFileSize(), searchQuery.getMaximumFileSize())) {
+        return false;
+    }
+
     return true;
 }
 
@@ -122,6 +126,12 @@ bool SearchVisitor::checkAudioMatches(const Media::Audio& audio) const {
         return false;
     }
 
+    if (!Library::SearchQuery::checkRange(audio.getReleaseYear(), searchQuery.getMinimumReleaseYear(), searchQuery.getMaximumReleaseYear())
+        || !Library::SearchQuery::checkRange(audio.getMediaLength(), searchQuery.getMinimumLength(), searchQuery.getMaximumLength())
+        || !Library::SearchQuery::checkRange(audio.getBitRate(), searchQuery.getMinimumBitRate(), searchQuery.getMaximumBitRate())) {
+        return false;
+    }
+
     return true;
 }
 
@@ -146,6 +156,14 @@ bool SearchVisitor::checkVideoMatches(const Media::Video& video) const {
         return false;
     }
 
+    if (!Library::SearchQuery::checkRange(video.getCreationYear(), searchQuery.getMinimumReleaseYear(), searchQuery.getMaximumReleaseYear())
+        || !Library::SearchQuery::checkRange(video.getMediaLength(), searchQuery.getMinimumLength(), searchQuery.getMaximumLength())
+        || !Library::SearchQuery::checkRange(video.getResolution().second,
+                                             static_cast<int>(searchQuery.getMinimumResolution()),
+                                             static_cast<int>(searchQuery.getMaximumResolution()))) {
+        return false;
+    }
+
     return true;
 }
 
@@ -170,6 +188,11 @@ bool SearchVisitor::checkEBookMatches(const Media::EBook& ebook) const {
         return false;
     }
 
+    if (!Library::SearchQuery::checkRange(ebook.getReleaseYear(), searchQuery.getMinimumReleaseYear(), searchQuery.getMaximumReleaseYear())
+        || !Library::SearchQuery::checkRange(ebook.getMediaLength(), searchQuery.getMinimumLength(), searchQuery.getMaximumLength())) {
+        return false;
+    }
+
     return true;
 }
 
@@ -194,6 +217,12 @@ bool SearchVisitor::checkImageMatches(const Media::Image& image) const {
         return false;
     }
 
+    if (!Library::SearchQuery::checkRange(image.getResolution().second,
+                                          static_cast<int>(searchQuery.getMinimumResolution()),
+                                          static_cast<int>(searchQuery.getMaximumResolution()))) {
+        return false;
+    }
+
     return true;
 }
 
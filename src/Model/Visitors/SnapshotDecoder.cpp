@@ -0,0 +1,91 @@
+#include "SnapshotDecoder.h"
+#include "Model/Media/Audio.h"
+#include "Model/Media/EBook.h"
+#include "Model/Media/Video.h"
+#include "Model/Media/Image.h"
+
+
+namespace Model {
+namespace Visitors {
+
+SnapshotDecoder::SnapshotDecoder(Library::BinarySnapshot::RecordReader& recordReader)
+    : reader(recordReader)
+{}
+
+
+void SnapshotDecoder::visit(Media::Audio& audio) {
+
+    readCommonFields(audio);
+    audio.setArtist(reader.readString());
+    audio.setGenre(reader.readString());
+    audio.setAlbum(reader.readString());
+    audio.setReleaseYear(reader.readU32());
+    audio.setMediaLength(reader.readU32());
+    audio.setBitRate(reader.readU32());
+    audio.setSampleRate(reader.readF32());
+    audio.setBitDepth(reader.readU32());
+    audio.setAudioChannels(reader.readU32());
+    audio.setCollaborators(reader.readString());
+}
+
+void SnapshotDecoder::visit(Media::Video& video) {
+
+    readCommonFields(video);
+    video.setDirector(reader.readString());
+    video.setGenre(reader.readString());
+    video.setCreationYear(reader.readU32());
+    video.setMediaLength(reader.readU32());
+    video.setFrameRate(reader.readU32());
+    int width = reader.readI32();
+    int height = reader.readI32();
+    video.setResolution({ width, height });
+    video.setVideoColorDepth(reader.readU32());
+    video.setSubtitles(reader.readString());
+    video.setLanguage(reader.readString());
+}
+
+void SnapshotDecoder::visit(Media::EBook& ebook) {
+
+    readCommonFields(ebook);
+    ebook.setAuthor(reader.readString());
+    ebook.setPublisher(reader.readString());
+    ebook.setReleaseYear(reader.readU32());
+    ebook.setISBN(reader.readString());
+    ebook.setMediaLength(reader.readU32());
+    ebook.setCategory(reader.readString());
+    ebook.setLanguage(reader.readString());
+    ebook.setCoverImagePath(reader.readString());
+    ebook.setImages(reader.readU8() != 0);
+}
+
+void SnapshotDecoder::visit(Media::Image& image) {
+
+    readCommonFields(image);
+    image.setDateCreated(reader.readString());
+    image.setImageCreator(reader.readString());
+    image.setImageCategory(reader.readString());
+    int width = reader.readI32();
+    int height = reader.readI32();
+    image.setResolution({ width, height });
+    int aspectWidth = reader.readI32();
+    int aspectHeight = reader.readI32();
+    image.setImageAspectRatio({ aspectWidth, aspectHeight });
+    image.setImageBitDepth(reader.readU32());
+    image.setImageCompression(reader.readU8() != 0);
+    image.setImageLocationTaken(reader.readString());
+}
+
+
+void SnapshotDecoder::readCommonFields(Media::AbstractMedia& media) {
+
+    Media::AbstractFile::setCurrentUniqueID(reader.readU32());
+    media.setFilePath(reader.readString());
+    media.setFileSize(reader.readF32());
+    media.setMediaName(reader.readString());
+    media.setMediaUploader(reader.readString());
+    media.setMediaFormat(reader.readString());
+    media.setMediaRating(reader.readU32());
+}
+
+}
+}
@@ -0,0 +1,57 @@
+#ifndef MODEL_VISITORS_SNAPSHOT_DECODER_H
+#define MODEL_VISITORS_SNAPSHOT_DECODER_H
+
+#include "IVisitor.h"
+#include "Model/Library/BinarySnapshot.h"
+
+/** @brief SnapshotDecoder
+ *
+ *  SnapshotDecoder e' una sottoclasse concreta che deriva pubblicamente da IVisitor.
+ *  Viene utilizzata da BinarySnapshot per impostare gli attributi di un media, appena creato, a partire dal contenuto di un record del formato binario.
+ *
+ *  I campi vengono letti nello stesso ordine in cui sono scritti da SnapshotEncoder. Come in 'fromJson', l'identificatore salvato viene usato solo
+ *  per aggiornare il contatore degli identificatori univoci. Se il record e' troncato, il RecordReader solleva un'eccezione std::runtime_error.
+ */
+
+namespace Model {
+namespace Visitors {
+
+class SnapshotDecoder : public IVisitor {
+
+public:
+
+    // === COSTRUTTORE ===
+
+    /**
+     * @brief SnapshotDecoder : costruttore
+     * @param recordReader : reader posizionato all'inizio del contenuto del record
+     */
+    explicit SnapshotDecoder(Library::BinarySnapshot::RecordReader& recordReader);
+
+
+    // === RIDEFINIZIONE VIRTUALI PURI IVisitor ===
+
+    /** @brief legge gli attributi di un media Audio */
+    void visit(Media::Audio& audio) override;
+    /** @brief legge gli attributi di un media EBook */
+    void visit(Media::EBook& ebook) override;
+    /** @brief legge gli attributi di un media Video */
+    void visit(Media::Video& video) override;
+    /** @brief legge gli attributi di un media Image */
+    void visit(Media::Image& image) override;
+
+private:
+
+    Library::BinarySnapshot::RecordReader& reader;
+
+    /**
+     * @brief readCommonFields : legge i campi comuni a tutti i media
+     * @param media : media da impostare
+     */
+    void readCommonFields(Media::AbstractMedia& media);
+};
+
+}
+}
+
+#endif // MODEL_VISITORS_SNAPSHOT_DECODER_H
@@ -0,0 +1,93 @@
+#include "SnapshotEncoder.h"
+#include "Model/Media/Audio.h"
+#include "Model/Media/EBook.h"
+#include "Model/Media/Video.h"
+#include "Model/Media/Image.h"
+
+
+namespace Model {
+namespace Visitors {
+
+SnapshotEncoder::SnapshotEncoder(Library::BinarySnapshot::RecordWriter& recordWriter)
+    : writer(recordWriter)
+{}
+
+
+void SnapshotEncoder::visit(const Media::Audio& audio) const {
+
+    writeCommonFields(audio, Library::BinarySnapshot::RecordType::Audio);
+    writer.writeString(audio.getArtist());
+    writer.writeString(audio.getGenre());
+    writer.writeString(audio.getAlbum());
+    writer.writeU32(audio.getReleaseYear());
+    writer.writeU32(audio.getMediaLength());
+    writer.writeU32(audio.getBitRate());
+    writer.writeF32(audio.getSampleRate());
+    writer.writeU32(audio.getBitDepth());
+    writer.writeU32(audio.getAudioChannels());
+    writer.writeString(audio.getCollaborators());
+    writer.endRecord();
+}
+
+void SnapshotEncoder::visit(const Media::Video& video) const {
+
+    writeCommonFields(video, Library::BinarySnapshot::RecordType::Video);
+    writer.writeString(video.getDirector());
+    writer.writeString(video.getGenre());
+    writer.writeU32(video.getCreationYear());
+    writer.writeU32(video.getMediaLength());
+    writer.writeU32(video.getFrameRate());
+    writer.writeI32(video.getResolution().first);
+    writer.writeI32(video.getResolution().second);
+    writer.writeU32(video.getVideoColorDepth());
+    writer.writeString(video.getSubtitles());
+    writer.writeString(video.getLanguage());
+    writer.endRecord();
+}
+
+void SnapshotEncoder::visit(const Media::EBook& ebook) const {
+
+    writeCommonFields(ebook, Library::BinarySnapshot::RecordType::EBook);
+    writer.writeString(ebook.getAuthor());
+    writer.writeString(ebook.getPublisher());
+    writer.writeU32(ebook.getReleaseYear());
+    writer.writeString(ebook.getISBN());
+    writer.writeU32(ebook.getMediaLength());
+    writer.writeString(ebook.getCategory());
+    writer.writeString(ebook.getLanguage());
+    writer.writeString(ebook.getCoverImagePath());
+    writer.writeU8(ebook.hasImages() ? 1 : 0);
+    writer.endRecord();
+}
+
+void SnapshotEncoder::visit(const Media::Image& image) const {
+
+    writeCommonFields(image, Library::BinarySnapshot::RecordType::Image);
+    writer.writeString(image.getDateCreated());
+    writer.writeString(image.getImageCreator());
+    writer.writeString(image.getImageCategory());
+    writer.writeI32(image.getResolution().first);
+    writer.writeI32(image.getResolution().second);
+    writer.writeI32(image.getImageAspectRatio().first);
+    writer.writeI32(image.getImageAspectRatio().second);
+    writer.writeU32(image.getImageBitDepth());
+    writer.writeU8(image.isCompressed() ? 1 : 0);
+    writer.writeString(image.getLocationTaken());
+    writer.endRecord();
+}
+
+
+void SnapshotEncoder::writeCommonFields(const Media::AbstractMedia& media, Library::BinarySnapshot::RecordType type) const {
+
+    writer.beginRecord(type);
+    writer.writeU32(media.getUniqueID());
+    writer.writeString(media.getFilePath());
+    writer.writeF32(media.getFileSize());
+    writer.writeString(media.getMediaName());
+    writer.writeString(media.getMediaUploader());
+    writer.writeString(media.getMediaFormat());
+    writer.writeU32(media.getMediaRating());
+}
+
+}
+}
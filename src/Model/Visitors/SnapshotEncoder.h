@@ -0,0 +1,58 @@
+#ifndef MODEL_VISITORS_SNAPSHOT_ENCODER_H
+#define MODEL_VISITORS_SNAPSHOT_ENCODER_H
+
+#include "IConstVisitor.h"
+#include "Model/Library/BinarySnapshot.h"
+
+/** @brief SnapshotEncoder
+ *
+ *  SnapshotEncoder e' una sottoclasse concreta che deriva pubblicamente da IConstVisitor.
+ *  Viene utilizzata da BinarySnapshot per scrivere, in base al tipo concreto del media, un record del formato binario.
+ *
+ *  Ogni record contiene prima i campi comuni (identificatore, path, dimensione, nome, uploader, formato, rating) e poi i campi del tipo,
+ *  nello stesso ordine delle chiavi usate da 'toJson'. L'ordine deve corrispondere a quello letto da SnapshotDecoder.
+ */
+
+namespace Model {
+namespace Visitors {
+
+class SnapshotEncoder : public IConstVisitor {
+
+public:
+
+    // === COSTRUTTORE ===
+
+    /**
+     * @brief SnapshotEncoder : costruttore
+     * @param recordWriter : writer su cui scrivere i record
+     */
+    explicit SnapshotEncoder(Library::BinarySnapshot::RecordWriter& recordWriter);
+
+
+    // === RIDEFINIZIONE VIRTUALI PURI IConstVisitor ===
+
+    /** @brief scrive il record di un media Audio */
+    void visit(const Media::Audio& audio) const override;
+    /** @brief scrive il record di un media EBook */
+    void visit(const Media::EBook& ebook) const override;
+    /** @brief scrive il record di un media Video */
+    void visit(const Media::Video& video) const override;
+    /** @brief scrive il record di un media Image */
+    void visit(const Media::Image& image) const override;
+
+private:
+
+    Library::BinarySnapshot::RecordWriter& writer;
+
+    /**
+     * @brief writeCommonFields : inizia il record e scrive i campi comuni a tutti i media
+     * @param media : media visitato
+     * @param type : tipo del record
+     */
+    void writeCommonFields(const Media::AbstractMedia& media, Library::BinarySnapshot::RecordType type) const;
+};
+
+}
+}
+
+#endif // MODEL_VISITORS_SNAPSHOT_ENCODER_H
@@ -0,0 +1,84 @@
+#include "ConciseDelegate.h"
+#include "MediaListModel.h"
+
+#include <QApplication>
+#include <QStyle>
+#include <QStyleOptionButton>
+#include <QFontMetrics>
+#include <QString>
+
+#include <algorithm>
+
+namespace View {
+namespace Viewer {
+
+namespace {
+
+// stessi margini e spaziatura del vecchio layout di ConciseViewer
+const int HORIZONTAL_MARGIN = 4;
+const int VERTICAL_MARGIN = 2;
+const int SPACING = 8;
+
+}
+
+ConciseDelegate::ConciseDelegate(QObject* parent)
+    : QStyledItemDelegate(parent)
+{}
+
+void ConciseDelegate::paint(QPainter* painter, const QStyleOptionViewItem& option, const QModelIndex& index) const {
+
+    QStyleOptionViewItem opt(option);
+    initStyleOption(&opt, index);
+    QStyle* style = opt.widget ? opt.widget->style() : QApplication::style();
+
+    // sfondo della riga (evidenziato se selezionata), senza testo
+    opt.text.clear();
+    style->drawControl(QStyle::CE_ItemViewItem, &opt, painter, opt.widget);
+
+    QRect area = opt.rect.adjusted(HORIZONTAL_MARGIN, VERTICAL_MARGIN, -HORIZONTAL_MARGIN, -VERTICAL_MARGIN);
+    bool selected = opt.state.testFlag(QStyle::State_Selected);
+
+    // indicatore di selezione
+    QStyleOptionButton radio;
+    int indicatorWidth = style->pixelMetric(QStyle::PM_ExclusiveIndicatorWidth, nullptr, opt.widget);
+    int indicatorHeight = style->pixelMetric(QStyle::PM_ExclusiveIndicatorHeight, nullptr, opt.widget);
+    radio.rect = QRect(area.left(), area.top() + (area.height() - indicatorHeight) / 2, indicatorWidth, indicatorHeight);
+    radio.state = QStyle::State_Enabled | (selected ? QStyle::State_On : QStyle::State_Off);
+    style->drawPrimitive(QStyle::PE_IndicatorRadioButton, &radio, painter, opt.widget);
+    area.setLeft(radio.rect.right() + 1 + SPACING);
+
+    // campi di testo, da sinistra a destra (il nome viene troncato se non c'e' spazio)
+    const QString fields[] = {
+        QString::number(index.data(MediaListModel::MediaIndexRole).toInt()),
+        "[ID: " + QString::number(index.data(MediaListModel::MediaIDRole).toInt()) + "]",
+        index.data(MediaListModel::MediaTypeRole).toString(),
+        index.data(MediaListModel::MediaNameRole).toString()
+    };
+
+    painter->save();
+    painter->setFont(opt.font);
+    painter->setPen(opt.palette.color(selected ? QPalette::HighlightedText : QPalette::Text));
+    QFontMetrics metrics(opt.font);
+
+    for (const QString& field : fields) {
+        if (area.width() <= 0) break;
+        QString text = metrics.elidedText(field, Qt::ElideRight, area.width());
+        painter->drawText(area, Qt::AlignLeft | Qt::AlignVCenter, text);
+        area.setLeft(area.left() + metrics.horizontalAdvance(text) + SPACING);
+    }
+    painter->restore();
+}
+
+QSize ConciseDelegate::sizeHint(const QStyleOptionViewItem& option, const QModelIndex& index) const {
+
+    // altezza indipendente dal contenuto, cosi' la vista non deve misurare ogni riga
+    Q_UNUSED(index);
+    const QWidget* widget = option.widget;
+    QStyle* style = widget ? widget->style() : QApplication::style();
+    int indicatorHeight = style->pixelMetric(QStyle::PM_ExclusiveIndicatorHeight, nullptr, widget);
+    int height = std::max(QFontMetrics(option.font).height(), indicatorHeight) + 2 * VERTICAL_MARGIN;
+    return QSize(option.rect.width(), height);
+}
+
+}
+}
@@ -0,0 +1,54 @@
+#ifndef VIEW_VIEWER_CONCISE_DELEGATE_H
+#define VIEW_VIEWER_CONCISE_DELEGATE_H
+
+#include <QStyledItemDelegate>
+#include <QStyleOptionViewItem>
+#include <QModelIndex>
+#include <QPainter>
+#include <QSize>
+
+/** @brief ConciseDelegate
+ *
+ *  ConciseDelegate e' il delegate utilizzato per la visualizzazione compatta ("concisa") dei media nella lista del pannello sinistro (modello MediaListModel).
+ *  Per ogni riga visibile disegna, come faceva il widget ConciseViewer, un indicatore di selezione (radio button), l'indice in libreria del media,
+ *  il suo identificatore univoco, il tipo e il nome. Le righe non vengono mai create come widget: vengono solo disegnate quando sono visibili.
+ *
+ *  Tutte le righe hanno la stessa altezza, in modo che la vista possa essere usata con 'setUniformItemSizes(true)'.
+ */
+
+namespace View {
+namespace Viewer {
+
+class ConciseDelegate : public QStyledItemDelegate {
+
+    Q_OBJECT
+
+public:
+
+    /**
+     * @brief ConciseDelegate : costruttore
+     * @param parent : parent object (con valore di default 'nullptr')
+     */
+    explicit ConciseDelegate(QObject* parent = nullptr);
+
+    /**
+     * @brief paint : disegna una riga della lista (indicatore di selezione, indice, identificatore, tipo e nome del media)
+     * @param painter : painter della vista
+     * @param option : opzioni di stile della riga
+     * @param index : indice della riga nel modello
+     */
+    void paint(QPainter* painter, const QStyleOptionViewItem& option, const QModelIndex& index) const override;
+
+    /**
+     * @brief sizeHint : dimensione di una riga (uguale per tutte le righe)
+     * @param option : opzioni di stile della riga
+     * @param index : indice della riga nel modello
+     * @return QSize : dimensione della riga
+     */
+    QSize sizeHint(const QStyleOptionViewItem& option, const QModelIndex& index) const override;
+};
+
+}
+}
+
+#endif // VIEW_VIEWER_CONCISE_DELEGATE_H
@@ -0,0 +1,164 @@
+#include "MediaListModel.h"
+
+#include <QString>
+
+#include <utility>
+
+namespace View {
+namespace Viewer {
+
+MediaListModel::MediaListModel(Controller::Controller* controller, QObject* parent)
+    : QAbstractListModel(parent),
+    controller(controller),
+    showingAll(false),
+    libraryRowCount(0)
+{}
+
+
+// === QAbstractListModel ===
+
+int MediaListModel::rowCount(const QModelIndex& parent) const {
+
+    if (parent.isValid()) return 0;
+    return showingAll ? libraryRowCount : static_cast<int>(mediaIndexes.size());
+}
+
+QVariant MediaListModel::data(const QModelIndex& index, int role) const {
+
+    int ind = index.isValid() ? getMediaIndexAt(index.row()) : -1;
+    if (ind < 0) return QVariant();
+    if (role == MediaIndexRole) return ind;
+
+    // il media viene letto solo quando la riga viene richiesta (cioe' quando e' visibile)
+    auto media = controller->getMediaAtIndex(ind);
+    if (!media) return QVariant();
+
+    switch (role) {
+    case Qt::DisplayRole:
+        return QString::number(ind) + " [ID: " + QString::number(media->getUniqueID()) + "] " +
+               QString::fromStdString(media->displayStringType()) + " " + QString::fromStdString(media->getMediaName());
+    case MediaIDRole:
+        return media->getUniqueID();
+    case MediaTypeRole:
+        return QString::fromStdString(media->displayStringType());
+    case MediaNameRole:
+        return QString::fromStdString(media->getMediaName());
+    default:
+        return QVariant();
+    }
+}
+
+
+// === CONTENUTO ===
+
+void MediaListModel::showAllMedia() {
+
+    beginResetModel();
+    showingAll = true;
+    libraryRowCount = controller ? controller->getManagerSize() : 0;
+    mediaIndexes.clear();
+    endResetModel();
+}
+
+void MediaListModel::showMediaIndexes(std::vector<unsigned int> indexes) {
+
+    beginResetModel();
+    showingAll = false;
+    libraryRowCount = 0;
+    mediaIndexes = std::move(indexes);
+    endResetModel();
+}
+
+void MediaListModel::clearRows() { showMediaIndexes({}); }
+
+int MediaListModel::getMediaIndexAt(int row) const {
+
+    if (row < 0 || row >= rowCount()) return -1;
+    return showingAll ? row : static_cast<int>(mediaIndexes[row]);
+}
+
+
+// === AGGIORNAMENTI ===
+
+void MediaListModel::onMediaInserted(unsigned int ind, unsigned int id) {
+
+    Q_UNUSED(id);
+    if (showingAll) {
+        // notifica non coerente con le righe attuali (non dovrebbe accadere): rilegge la libreria
+        if (ind > static_cast<unsigned int>(libraryRowCount)) {
+            showAllMedia();
+            return;
+        }
+        beginInsertRows(QModelIndex(), ind, ind);
+        ++libraryRowCount;
+        endInsertRows();
+    }
+    else {
+        // il nuovo media non fa parte dei risultati mostrati, cambiano solo gli indici successivi
+        shiftMediaIndexes(ind, +1);
+    }
+}
+
+void MediaListModel::onMediaRemoved(unsigned int ind, unsigned int id) {
+
+    Q_UNUSED(id);
+    if (showingAll) {
+        if (ind >= static_cast<unsigned int>(libraryRowCount)) {
+            showAllMedia();
+            return;
+        }
+        // le righe successive mostrano gia' l'indice corretto (riga == indice)
+        beginRemoveRows(QModelIndex(), ind, ind);
+        --libraryRowCount;
+        endRemoveRows();
+    }
+    else {
+        for (int row = static_cast<int>(mediaIndexes.size()) - 1; row >= 0; --row) {
+            if (mediaIndexes[row] == ind) {
+                beginRemoveRows(QModelIndex(), row, row);
+                mediaIndexes.erase(mediaIndexes.begin() + row);
+                endRemoveRows();
+            }
+        }
+        shiftMediaIndexes(ind + 1, -1);
+    }
+}
+
+void MediaListModel::onMediaChanged(unsigned int ind, unsigned int id) {
+
+    Q_UNUSED(id);
+    if (showingAll) {
+        if (ind < static_cast<unsigned int>(libraryRowCount)) {
+            QModelIndex changed = index(static_cast<int>(ind));
+            emit dataChanged(changed, changed);
+        }
+    }
+    else {
+        for (std::size_t row = 0; row < mediaIndexes.size(); ++row) {
+            if (mediaIndexes[row] == ind) {
+                QModelIndex changed = index(static_cast<int>(row));
+                emit dataChanged(changed, changed);
+            }
+        }
+    }
+}
+
+void MediaListModel::shiftMediaIndexes(unsigned int from, int delta) {
+
+    int firstRow = -1;
+    int lastRow = -1;
+    for (std::size_t row = 0; row < mediaIndexes.size(); ++row) {
+        if (mediaIndexes[row] >= from) {
+            mediaIndexes[row] = static_cast<unsigned int>(static_cast<int>(mediaIndexes[row]) + delta);
+            if (firstRow < 0) firstRow = static_cast<int>(row);
+            lastRow = static_cast<int>(row);
+        }
+    }
+    // l'indice mostrato nelle righe spostate e' cambiato
+    if (firstRow >= 0) {
+        emit dataChanged(index(firstRow), index(lastRow));
+    }
+}
+
+}
+}
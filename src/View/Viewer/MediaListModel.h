@@ -0,0 +1,124 @@
+#ifndef VIEW_VIEWER_MEDIA_LIST_MODEL_H
+#define VIEW_VIEWER_MEDIA_LIST_MODEL_H
+
+#include "Controller/Controller.h"
+
+#include <QAbstractListModel>
+#include <QModelIndex>
+#include <QVariant>
+
+#include <vector>
+
+/** @brief MediaListModel
+ *
+ *  MediaListModel e' il modello (QAbstractListModel) della lista dei media mostrata nel pannello sinistro della Window, visualizzata con un QListView
+ *  e il delegate ConciseDelegate. Ogni riga corrisponde a un media della libreria, che viene letto dal Controller solo quando la riga viene disegnata:
+ *  il modello non conserva alcuna copia dei media, quindi mostrare o scorrere una libreria molto grande non richiede di visitarne tutti i media.
+ *
+ *  Il modello puo' mostrare tutti i media della libreria, oppure solo quelli in un insieme di indici (ad esempio i risultati di una ricerca).
+ *  Dopo ogni inserimento, rimozione o modifica di un media (notificati dal Controller) il modello aggiorna solo le righe interessate, tramite gli
+ *  slot 'onMediaInserted', 'onMediaRemoved' e 'onMediaChanged': la lista non viene mai ricostruita per una singola modifica.
+ */
+
+namespace View {
+namespace Viewer {
+
+class MediaListModel : public QAbstractListModel {
+
+    Q_OBJECT
+
+public:
+
+    /** @brief MediaRole : ruoli dei dati di una riga, oltre a Qt::DisplayRole */
+    enum MediaRole {
+        MediaIndexRole = Qt::UserRole + 1,    // indice del media in libreria
+        MediaIDRole,                          // identificatore univoco del media
+        MediaTypeRole,                        // tipo del media
+        MediaNameRole                         // nome del media
+    };
+
+    /**
+     * @brief MediaListModel : costruttore, il modello e' inizialmente vuoto
+     * @param controller : puntatore al Controller da cui leggere i media
+     * @param parent : parent object (con valore di default 'nullptr')
+     */
+    explicit MediaListModel(Controller::Controller* controller, QObject* parent = nullptr);
+
+
+    // === QAbstractListModel ===
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+
+
+    // === CONTENUTO ===
+
+    /**
+     * @brief showAllMedia : mostra tutti i media attualmente in libreria
+     */
+    void showAllMedia();
+
+    /**
+     * @brief showMediaIndexes : mostra solo i media ad un insieme di indici, nell'ordine dato
+     * @param indexes : indici dei media da mostrare
+     */
+    void showMediaIndexes(std::vector<unsigned int> indexes);
+
+    /**
+     * @brief clearRows : svuota il modello
+     */
+    void clearRows();
+
+    /**
+     * @brief getMediaIndexAt : restituisce l'indice in libreria del media mostrato in una riga
+     * @param row : riga del modello
+     * @return int : indice del media, -1 se la riga non e' valida
+     */
+    int getMediaIndexAt(int row) const;
+
+
+public slots:
+
+    // === AGGIORNAMENTI ===
+
+    /**
+     * @brief onMediaInserted : aggiorna il modello dopo l'inserimento di un media
+     * @param ind : posizione del media inserito
+     * @param id : identificatore univoco del media inserito
+     */
+    void onMediaInserted(unsigned int ind, unsigned int id);
+
+    /**
+     * @brief onMediaRemoved : aggiorna il modello dopo la rimozione di un media, togliendo la sua riga
+     * @param ind : posizione del media rimosso
+     * @param id : identificatore univoco del media rimosso
+     */
+    void onMediaRemoved(unsigned int ind, unsigned int id);
+
+    /**
+     * @brief onMediaChanged : aggiorna il modello dopo la modifica di un media, ridisegnando solo la sua riga
+     * @param ind : posizione del media modificato
+     * @param id : identificatore univoco del media modificato
+     */
+    void onMediaChanged(unsigned int ind, unsigned int id);
+
+
+private:
+
+    Controller::Controller* controller;     // puntatore al Controller
+    bool showingAll;                        // true se vengono mostrati tutti i media della libreria
+    int libraryRowCount;                    // numero di media della libreria all'ultimo 'showAllMedia'
+    std::vector<unsigned int> mediaIndexes; // indici dei media mostrati (se non vengono mostrati tutti)
+
+    /**
+     * @brief shiftMediaIndexes : sposta di 'delta' gli indici mostrati maggiori o uguali a 'from', aggiornando le righe interessate
+     * @param from : primo indice da spostare
+     * @param delta : spostamento (+1 dopo un inserimento, -1 dopo una rimozione)
+     */
+    void shiftMediaIndexes(unsigned int from, int delta);
+};
+
+}
+}
+
+#endif // VIEW_VIEWER_MEDIA_LIST_MODEL_H
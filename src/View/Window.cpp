@@ -5,7 +5,7 @@
 #include "View/Viewer/VideoViewer.h"
 #include "View/Viewer/EBookViewer.h"
 #include "View/Viewer/ImageViewer.h"
-#include "View/Viewer/ConciseViewer.h"
+#include "View/Viewer/ConciseDelegate.h"
 
 #include "View/Creator/TypeSelectorWidget.h"
 #include "View/Creator/MediaCreatorFactory.h"
@@ -30,6 +30,8 @@
 #include <QFile>
 #include <QKeySequence>
 
+#include <algorithm>
+
 namespace View {
 
 
@@ -47,6 +49,12 @@ Window::Window(QWidget* parent)
     // setup dei keyboard shortcut e tooltip
     setShortcutsAndToolTips();
 
+    // barra di avanzamento per caricamento/salvataggio, visibile solo durante l'operazione
+    libraryIOProgressBar = new QProgressBar(this);
+    libraryIOProgressBar->setMaximumWidth(200);
+    libraryIOProgressBar->setVisible(false);
+    statusBar()->addPermanentWidget(libraryIOProgressBar);
+
     statusBar()->showMessage("Setup completed", 3000);
 }
 
@@ -169,19 +177,39 @@ void Window::setupLeftPanel() {
     searchBar->setPlaceholderText("Search media name...");
     searchButton = new QPushButton("Search By Name");
     searchButton->setToolTip("Ricerca media solamente per nome");
+    liveSearchCheckBox = new QCheckBox("Live");
+    liveSearchCheckBox->setChecked(true);
+    liveSearchCheckBox->setToolTip("Ricerca per nome mentre si scrive");
     searchBarLayout->addWidget(searchBar);
     searchBarLayout->addWidget(searchButton);
+    searchBarLayout->addWidget(liveSearchCheckBox);
     leftPanelLayout->addWidget(searchBarContainer);
 
     // setup zona lista dei media
-    mediaLibraryList = new QListWidget(leftPanel);
+    mediaLibraryList = new QListView(leftPanel);
     mediaLibraryList->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
+    // righe tutte della stessa altezza: la vista non deve misurare ogni riga
+    mediaLibraryList->setUniformItemSizes(true);
+    mediaLibraryList->setSelectionMode(QAbstractItemView::SingleSelection);
+    mediaLibraryList->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    mediaLibraryList->setItemDelegate(new View::Viewer::ConciseDelegate(mediaLibraryList));
     leftPanelLayout->addWidget(mediaLibraryList);
 
     connect(searchButton, &QPushButton::clicked,
             this, &Window::onSearchMediaByName);
 
-    mediaListButtonGroup = nullptr;
+    // ricerca "live": parte solo dopo una breve pausa nella scrittura
+    liveSearchTimer = new QTimer(this);
+    liveSearchTimer->setSingleShot(true);
+    liveSearchTimer->setInterval(250);
+    connect(searchBar, &QLineEdit::textChanged,
+            this, &Window::onSearchTextChanged);
+    connect(liveSearchTimer, &QTimer::timeout,
+            this, &Window::onLiveSearchTimeout);
+    connect(liveSearchCheckBox, &QCheckBox::toggled,
+            this, &Window::onLiveSearchToggled);
+
+    mediaListModel = nullptr;
 
     leftPanel->setLayout(leftPanelLayout);
 }
@@ -228,6 +256,23 @@ void Window::setController(Controller::Controller* c) {
     connect(controller, &Controller::Controller::errorOccurred,
             this, &Window::showStatusBarMessage);
 
+    // modello della lista dei media, che legge i media dal Controller
+    mediaListModel = new View::Viewer::MediaListModel(controller, this);
+    mediaLibraryList->setModel(mediaListModel);
+    connect(mediaLibraryList->selectionModel(), &QItemSelectionModel::currentChanged,
+            this, &Window::onMediaListItemSelected);
+
+    // la lista applica solo le modifiche notificate dal Controller, senza essere ricostruita
+    connect(controller, &Controller::Controller::mediaInserted,
+            mediaListModel, &View::Viewer::MediaListModel::onMediaInserted);
+    connect(controller, &Controller::Controller::mediaRemoved,
+            mediaListModel, &View::Viewer::MediaListModel::onMediaRemoved);
+    connect(controller, &Controller::Controller::mediaChanged,
+            mediaListModel, &View::Viewer::MediaListModel::onMediaChanged);
+    // dopo una modifica in blocco la lista viene riletta una sola volta
+    connect(controller, &Controller::Controller::mediaBatchChanged,
+            this, &Window::onRefreshLibraryMediaList);
+
     // connect per indice
     connect(currentIndex, &QSpinBox::valueChanged,
             controller, &Controller::Controller::onSetIndexRequest);
@@ -261,8 +306,18 @@ void Window::setController(Controller::Controller* c) {
     // connect per operazione ricerca
     connect(this, &Window::onSearchMediaByNameRequest, controller,
             &Controller::Controller::onSearchMediaByNameRequest);
+    connect(this, &Window::liveSearchRequested, controller,
+            &Controller::Controller::onLiveSearchRequest);
     connect(controller, &Controller::Controller::searchResults,
             this, &Window::showSearchResults);
+
+    // connect per caricamento/salvataggio (eseguiti dal Controller su un thread secondario)
+    connect(controller, &Controller::Controller::libraryIOProgress,
+            this, &Window::onLibraryIOProgress);
+    connect(controller, &Controller::Controller::libraryLoaded,
+            this, &Window::onLibraryLoaded);
+    connect(controller, &Controller::Controller::librarySaved,
+            this, &Window::onLibrarySaved);
 }
 
 
@@ -309,91 +364,16 @@ void Window::showStatusBarMessage(const QString& msg) {
 
 void Window::showAllLibraryMedia() {
 
-    // svuota lista corrente
-    onClearLibraryMediaList();
-
-    // crea nuovo button group, con eslusivita'
-    mediaListButtonGroup = new QButtonGroup(this);
-    // solamente un media selezionabile
-    mediaListButtonGroup->setExclusive(true);
-
-    // prendi il numero di media attuali
-    int mediaCount = controller->getManagerSize();
-
-    // per ognuno
-    for (int i = 0; i < mediaCount; ++i) {
-
-        // crea un ConciseViewer per mostrarlo
-        auto media = controller->getMediaAtIndex(i);
-        int mediaID = media->getUniqueID();
-        QString mediaType = QString::fromStdString(media->displayStringType());
-        QString mediaName = QString::fromStdString(media->getMediaName());
-
-        View::Viewer::ConciseViewer* conciseViewer = new View::Viewer::ConciseViewer(
-            i, mediaID, mediaType, mediaName, this
-        );
-
-        connect(conciseViewer, &View::Viewer::ConciseViewer::selectedMediaChanged,
-                this, &Window::onConciseViewerSelected);
-
-        // trova il QRadiButton del ConciseViewer e aggiungi al gruppo esclusivo
-        QRadioButton* mediaRadioButton = conciseViewer->findChild<QRadioButton*>();
-        if (mediaRadioButton) {
-            mediaListButtonGroup->addButton(mediaRadioButton, i);
-        }
-
-        // inserisci custom viewer widget alla lista
-        QListWidgetItem* mediaListItem = new QListWidgetItem(mediaLibraryList);
-        mediaListItem->setSizeHint(conciseViewer->sizeHint());
-        mediaLibraryList->addItem(mediaListItem);
-        mediaLibraryList->setItemWidget(mediaListItem, conciseViewer);
-    }
+    // il modello mostra tutti i media attuali, leggendoli solo per le righe visibili
+    mediaLibraryList->clearSelection();
+    mediaListModel->showAllMedia();
 }
 
 void Window::showSearchResults(const std::vector<unsigned int>& mediaIDs) {
 
-    // svuota lista corrente
-    onClearLibraryMediaList();
-
-    // crea nuovo button group, con eslusivita'
-    mediaListButtonGroup = new QButtonGroup(this);
-    // solamente un media selezionabile
-    mediaListButtonGroup->setExclusive(true);
-
-    // prendi gli indici corrispondenti dei media trovati
-    std::vector<unsigned int> resultIndexes = controller->getSearchResultIndexes(mediaIDs);
-
-    // per ognuno
-    for (unsigned int i = 0; i < mediaIDs.size(); ++i) {
-
-        // crea un ConciseViewer per mostrarlo
-        auto media = controller->getMediaByID(mediaIDs[i]);
-        if (!media) continue;
-        int mediaId = media->getUniqueID();
-        QString mediaType = QString::fromStdString(media->displayStringType());
-        QString mediaName = QString::fromStdString(media->getMediaName());
-
-        // utilizzando l'indice corrispondente trovato
-        View::Viewer::ConciseViewer* conciseViewer = new View::Viewer::ConciseViewer(
-            resultIndexes[i], mediaId, mediaType, mediaName, this
-        );
-
-        connect(conciseViewer, &View::Viewer::ConciseViewer::selectedMediaChanged,
-                this, &Window::onConciseViewerSelected);
-
-        // trova il QRadiButton del ConciseViewer e aggiungi al gruppo esclusivo
-        QRadioButton* mediaRadioButton = conciseViewer->findChild<QRadioButton*>();
-        if (mediaRadioButton) {
-            mediaListButtonGroup->addButton(mediaRadioButton, i);
-        }
-
-        // inserisci custom viewer widget alla lista
-        QListWidgetItem* mediaListItem = new QListWidgetItem(mediaLibraryList);
-        mediaListItem->setSizeHint(conciseViewer->sizeHint());
-        mediaLibraryList->addItem(mediaListItem);
-        mediaLibraryList->setItemWidget(mediaListItem, conciseViewer);
-    }
-
+    // mostra solo gli indici corrispondenti dei media trovati
+    mediaLibraryList->clearSelection();
+    mediaListModel->showMediaIndexes(controller->getSearchResultIndexes(mediaIDs));
 }
 
 
@@ -577,16 +557,17 @@ void Window::showSearchWidget(QWidget* searchWidget) {
 
 // === OPERAZIONI INDICE (SLOT) ===
 
-void Window::onConciseViewerSelected(int ind, bool select) {
+void Window::onMediaListItemSelected(const QModelIndex& current) {
 
-    // se il media e' selezionato
-    if (select) {
-        // prendi l'indice corrente
-        currentIndex->setValue(ind);
-        // richiesta al Controller di impostare come indice corrente
-        controller->onSetIndexRequest(ind);
-        showStatusBarMessage("User selected media at index " + QString::number(ind));
-    }
+    // indice in libreria del media selezionato (-1 se la riga non e' valida)
+    int ind = current.isValid() ? mediaListModel->getMediaIndexAt(current.row()) : -1;
+    if (ind < 0) return;
+
+    // prendi l'indice corrente
+    currentIndex->setValue(ind);
+    // richiesta al Controller di impostare come indice corrente
+    controller->onSetIndexRequest(ind);
+    showStatusBarMessage("User selected media at index " + QString::number(ind));
 }
 
 
@@ -632,10 +613,8 @@ void Window::onRefreshLibraryMediaList() {
 
 void Window::onClearLibraryMediaList() {
 
-    mediaLibraryList->clear();
-    if (mediaListButtonGroup) {
-        delete mediaListButtonGroup;
-        mediaListButtonGroup = nullptr;
+    if (mediaListModel) {
+        mediaListModel->clearRows();
     }
 }
 
@@ -676,7 +655,6 @@ void Window::onEditMediaSuccess(unsigned int ind) {
 
     removeRightPanelWidget();
     statusBar()->showMessage("Successfully edited media at index " + QString::number(ind), 3000);
-    onRefreshLibraryMediaList();
 }
 
 void Window::onEditMediaFailure(unsigned int ind, const QString& errorMsg) {
@@ -694,7 +672,6 @@ void Window::onRemoveMedia() {
 
     if (controller->onRemoveMediaAtIndexRequest(currInd)) {
         showStatusBarMessage("Removed media at index " + QString::number(currInd));
-        onRefreshLibraryMediaList();
     }
     else {
         showStatusBarMessage("Could not remove media at index " + QString::number(currInd));
@@ -707,14 +684,11 @@ void Window::onRemoveMedia() {
 void Window::onUndoActionTriggered() {
 
     emit undoRequested();
-    onRefreshLibraryMediaList();
-
 }
 
 void Window::onRedoActionTriggered() {
 
     emit redoRequested();
-    onRefreshLibraryMediaList();
 }
 
 void Window::onShowLastCommandInfo(const QString& info) {
@@ -755,7 +729,6 @@ void Window::onCreateMediaSuccess(const QString &msg) {
 
     removeRightPanelWidget();
     showStatusBarMessage("Creation Success: " + msg);
-    onRefreshLibraryMediaList();
 }
 
 void Window::onCreateMediaFailure(const QString& errorMsg) {
@@ -786,19 +759,47 @@ void Window::onSearchMediaByName() {
     emit onSearchMediaByNameRequest(mediaName);
 }
 
+void Window::onSearchTextChanged(const QString& text) {
+
+    Q_UNUSED(text);
+    if (liveSearchCheckBox->isChecked()) {
+        // ogni modifica riavvia l'attesa, la ricerca parte solo al termine
+        liveSearchTimer->start();
+    }
+}
+
+void Window::onLiveSearchTimeout() {
+
+    QString mediaName = searchBar->text();
+    // i risultati arrivano con il segnale 'searchResults' del Controller
+    emit liveSearchRequested(mediaName);
+    if (mediaName.isEmpty()) {
+        showAllLibraryMedia();
+    }
+}
+
+void Window::onLiveSearchToggled(bool enabled) {
+
+    if (!enabled) {
+        liveSearchTimer->stop();
+        emit liveSearchRequested(QString());
+    }
+}
+
 
 // === JSON (SLOT) ===
 
 void Window::onSaveLibraryToFile() {
 
     // apri dialog per selezionare file per il salvataggio
-    QString outputFile = QFileDialog::getSaveFileName(this, "Save Library", QDir::homePath(), "JSON Files (*.json)");
+    QString outputFile = QFileDialog::getSaveFileName(this, "Save Library", QDir::homePath(), "JSON Files (*.json);;Library Snapshot (*.vlib)");
     if (outputFile.isEmpty()) return;
 
-    if (controller->onSaveLibraryRequest(outputFile)) {
-        showStatusBarMessage("Library saved to file: " + outputFile);
-    }
-    else {
+    // il risultato arriva con il segnale 'librarySaved' del Controller
+    setLibraryIOActive(true);
+    statusBar()->showMessage("Saving library to file: " + outputFile);
+    if (!controller->onSaveLibraryRequest(outputFile)) {
+        setLibraryIOActive(false);
         QMessageBox::warning(this, "Error", "Coult not save library to file: " + outputFile);
     }
 }
@@ -806,18 +807,72 @@ void Window::onSaveLibraryToFile() {
 void Window::onLoadLibraryFromFile() {
 
     // apri dialog per selezionare file da cui caricare libreria
-    QString inputFile = QFileDialog::getOpenFileName(this, "Load Library", QDir::homePath(), "JSON Files (*.json)");
+    QString inputFile = QFileDialog::getOpenFileName(this, "Load Library", QDir::homePath(), "JSON Files (*.json);;Library Snapshot (*.vlib)");
     if (inputFile.isEmpty()) return;
 
-    if (controller->onLoadLibraryRequest(inputFile)) {
+    // il risultato arriva con il segnale 'libraryLoaded' del Controller, fino ad allora la libreria attuale resta consultabile
+    setLibraryIOActive(true);
+    statusBar()->showMessage("Loading library from file: " + inputFile);
+    if (!controller->onLoadLibraryRequest(inputFile)) {
+        setLibraryIOActive(false);
+        QMessageBox::warning(this, "Error", "Could not load library from file: " + inputFile);
+    }
+
+}
+
+void Window::onLibraryIOProgress(qint64 processed, qint64 total) {
+
+    if (total <= 0) return;
+    // scala fissa, per non superare il limite di 'int' con file molto grandi
+    libraryIOProgressBar->setRange(0, 1000);
+    libraryIOProgressBar->setValue(static_cast<int>(std::min<qint64>(processed, total) * 1000 / total));
+}
+
+void Window::onLibraryLoaded(bool success, const QString& filename) {
+
+    setLibraryIOActive(false);
+    if (success) {
         onRefreshLibraryMediaList();
         onViewLibraryMediaList();
-        showStatusBarMessage("Successfully loaded library from file: " + inputFile);
+        showStatusBarMessage("Successfully loaded library from file: " + filename);
     }
     else {
-        QMessageBox::warning(this, "Error", "Could not load library from file: " + inputFile);
+        statusBar()->clearMessage();
+        QMessageBox::warning(this, "Error", "Could not load library from file: " + filename);
     }
+}
+
+void Window::onLibrarySaved(bool success, const QString& filename) {
 
+    setLibraryIOActive(false);
+    if (success) {
+        showStatusBarMessage("Library saved to file: " + filename);
+    }
+    else {
+        statusBar()->clearMessage();
+        QMessageBox::warning(this, "Error", "Coult not save library to file: " + filename);
+    }
+}
+
+void Window::setLibraryIOActive(bool active) {
+
+    // finche' l'avanzamento non e' noto la barra mostra solo l'attivita' in corso
+    libraryIOProgressBar->setRange(0, 0);
+    libraryIOProgressBar->setVisible(active);
+
+    actionLoadLibrary->setEnabled(!active);
+    actionSaveLibrary->setEnabled(!active);
+    actionCreate->setEnabled(!active);
+    actionEdit->setEnabled(!active);
+    actionRemove->setEnabled(!active);
+    if (active) {
+        actionUndo->setEnabled(false);
+        actionRedo->setEnabled(false);
+    }
+    else {
+        // Undo/Redo tornano allo stato indicato dal Controller
+        controller->initializeCommandSignals();
+    }
 }
 
 }
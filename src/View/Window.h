@@ -2,6 +2,7 @@
 #define VIEW WINDOW_H
 
 #include "Controller/Controller.h"
+#include "View/Viewer/MediaListModel.h"
 
 #include <QMainWindow>
 #include <QVBoxLayout>
@@ -12,13 +13,15 @@
 #include <QStatusBar>
 #include <QMenuBar>
 #include <QMenu>
-#include <QListWidget>
+#include <QListView>
 #include <QMap>
 #include <QComboBox>
 #include <QSpinBox>
-#include <QButtonGroup>
 #include <QPushButton>
 #include <QLineEdit>
+#include <QCheckBox>
+#include <QTimer>
+#include <QProgressBar>
 
 /** @brief Window
  *
@@ -30,8 +33,11 @@
  *  La gestione dell'interazione tra utente e Controller avviene attravereso il sistema di segnali/slot di Qt, delegando tutte le operazioni logiche e di dati al Controller.
  *
  *  Utilizza i vari custom widget definiti nei namespace Creator, Editor, Viewer e Search per implementare le operazioni sui media, in base al loro tipo.
- *  In particolare, la lista dei media viene rappresentata come un QListWidget dei media, mostrati tramite il custom widget ConciseViewer. Ciascuno contiene un radio
- *  button per essere selezionato come media corrente, e tutti i media nella lista sono trattati come un button group esclusivo, permettendo solamente ad uno di essere selezionato.
+ *  In particolare, la lista dei media viene rappresentata come un QListView sul modello MediaListModel, le cui righe sono disegnate dal delegate ConciseDelegate.
+ *  Il modello legge i media dal Controller solo per le righe visibili, quindi anche una libreria molto grande viene mostrata e scorsa senza creare un widget per media.
+ *  La lista ammette una sola riga selezionata, che diventa il media corrente. Dopo una creazione, modifica, rimozione o undo/redo la lista non viene
+ *  ricostruita: il modello applica solo gli inserimenti, le rimozioni e le modifiche notificati dal Controller.
+ *  Con la ricerca "live" attiva, la ricerca per nome parte da sola poco dopo che l'utente ha smesso di scrivere, e viene eseguita dal Controller in background.
  *  Entrambi questi pannelli sono vengono aggiornati dinamicamente in risposta alle azioni dello user.
  *
  *  Ho deciso di centralizzare tutta logica relativa all'interfaccia in Window, cosi' mantenendo una separazione netta tra il modello logico e la vista (MVC).
@@ -75,15 +81,14 @@ public:
     // === CUSTOM WIDGETS - Pannello Sinistro ===
 
     /**
-     * @brief showAllLibraryMedia : svuota la lista dei media e ricrea il gruppo esclusivo di radio button per la selezione dei media.
-     *                              Per ogni media attualmente in libreria crea e mostra un ConcicseViewer nella lista, rendendo come
-     *                              selezionabile solo uno alla volta
+     * @brief showAllLibraryMedia : aggiorna la lista dei media per mostrare tutti i media attualmente in libreria.
+     *                              I media vengono letti dal modello della lista solo quando le rispettive righe sono visibili
      */
     void showAllLibraryMedia();
 
     /**
-     * @brief showSearchResults : mostra i media trovati in un'operazione di ricerca. Analogo a 'showAllLibraryMedia', ma usa gli indici corrispondenti
-     *                            dei media trovati (mediaIDs) nella creazione dei ConciseViewer da mostrare nella lista.
+     * @brief showSearchResults : mostra i media trovati in un'operazione di ricerca. Analogo a 'showAllLibraryMedia', ma la lista mostra solo
+     *                            gli indici corrispondenti dei media trovati (mediaIDs).
      * @param mediaIDs : identificatori univoci dei media trovati
      */
     void showSearchResults(const std::vector<unsigned int>& mediaIDs);
@@ -141,6 +146,12 @@ signals:
      */
     void onSearchMediaByNameRequest(const QString& mediaName);
 
+    /**
+     * @brief liveSearchRequested : segnala al Controller richiesta di ricerca "live" per nome (eseguita in background)
+     * @param mediaName : nome del media con cui effettuare la ricerca (vuoto per annullare la ricerca in corso)
+     */
+    void liveSearchRequested(const QString& mediaName);
+
 
 public slots:
 
@@ -148,11 +159,10 @@ public slots:
     // === OPERAZIONI INDICE (SLOT) ===
 
     /**
-     * @brief onConciseViewerSelected : gestisce richiesta di impostare come indice corrente il media selezionato nella lista dei media (lista di ConciseViewer)
-     * @param ind : indice del media da impostare come indice corrente
-     * @param select : true se il media e' selezionato, false altrimenti
+     * @brief onMediaListItemSelected : gestisce richiesta di impostare come indice corrente il media selezionato nella lista dei media
+     * @param current : riga selezionata nella lista
      */
-    void onConciseViewerSelected(int ind, bool select);
+    void onMediaListItemSelected(const QModelIndex& current);
 
 
 
@@ -288,6 +298,25 @@ public slots:
      */
     void onSearchMediaByName();
 
+    /**
+     * @brief onSearchTextChanged : gestisce la modifica del testo nella barra di ricerca, con la ricerca "live" attiva (ri)avvia l'attesa
+     *                              prima della ricerca, in modo da cercare solo quando l'utente smette di scrivere
+     * @param text : testo attuale della barra di ricerca
+     */
+    void onSearchTextChanged(const QString& text);
+
+    /**
+     * @brief onLiveSearchTimeout : al termine dell'attesa richiede al Controller la ricerca "live" del testo attuale,
+     *                              con la barra di ricerca vuota mostra di nuovo tutti i media
+     */
+    void onLiveSearchTimeout();
+
+    /**
+     * @brief onLiveSearchToggled : attiva/disattiva la ricerca "live", disattivandola annulla la ricerca in corso
+     * @param enabled : true se la ricerca "live" e' attiva
+     */
+    void onLiveSearchToggled(bool enabled);
+
 
 
     // === JSON (SLOT) ===
@@ -304,6 +333,27 @@ public slots:
      */
     void onLoadLibraryFromFile();
 
+    /**
+     * @brief onLibraryIOProgress : aggiorna la barra di avanzamento durante un caricamento/salvataggio della libreria
+     * @param processed : quantita' gia' elaborata
+     * @param total : quantita' totale
+     */
+    void onLibraryIOProgress(qint64 processed, qint64 total);
+
+    /**
+     * @brief onLibraryLoaded : gestisce la conclusione di un caricamento della libreria, aggiornando la lista dei media in caso di successo
+     * @param success : true se il caricamento ha avuto successo, false altrimenti
+     * @param filename : file da cui e' stata caricata la libreria
+     */
+    void onLibraryLoaded(bool success, const QString& filename);
+
+    /**
+     * @brief onLibrarySaved : gestisce la conclusione di un salvataggio della libreria
+     * @param success : true se il salvataggio ha avuto successo, false altrimenti
+     * @param filename : file su cui e' stata salvata la libreria
+     */
+    void onLibrarySaved(bool success, const QString& filename);
+
 
 private:
 
@@ -323,10 +373,12 @@ private:
     QHBoxLayout* searchBarLayout;  // layout barra di ricerca
     QLineEdit* searchBar;          // barra di ricerca
     QPushButton* searchButton;     // bottone ricerca
-    QListWidget* mediaLibraryList; // lista dei media in libraria (lista di ConciseViewer widget)
+    QCheckBox* liveSearchCheckBox; // attiva la ricerca "live" mentre si scrive
+    QTimer* liveSearchTimer;       // attesa dopo l'ultima modifica del testo, prima della ricerca "live"
+    QListView* mediaLibraryList;   // lista dei media in libraria (vista sul modello 'mediaListModel')
 
-    // utilizzato per selezionare media dalla lista
-    QButtonGroup* mediaListButtonGroup;
+    // modello della lista dei media, creato in 'setController'
+    View::Viewer::MediaListModel* mediaListModel;
 
     QWidget* rightPanel;       // pannello sinistro
     QVBoxLayout* rightPanelLayout;   // layout pannello sinistro
@@ -360,6 +412,15 @@ private:
     // salva il tipo di media da creare (fatto per semplicita')
     QString mediaTypeToCreate;
 
+    // avanzamento del caricamento/salvataggio della libreria (nella status bar)
+    QProgressBar* libraryIOProgressBar;
+
+    /**
+     * @brief setLibraryIOActive : mostra/nasconde la barra di avanzamento e disabilita/riabilita le azioni che modificano la libreria
+     * @param active : true all'avvio di un caricamento/salvataggio, false al termine
+     */
+    void setLibraryIOActive(bool active);
+
     /**
      * @brief setupMenus : setup dei menu "File", "Operations" e "Settings", aggiunge le azioni e le collega ai slot corrispondenti
      */
@@ -372,8 +433,8 @@ private:
 
     /**
      * @brief setupLeftPanel : setup del pannello sinistro, imposta layout sinistro, barra di ricerca e bottone per ricerca per solo nome,
-     *                         collega bottone allo slot 'searchMediaByName' e imposta a nullptr 'mediaListButtonGroup' utilizzato poi per
-     *                         selezionare un media dalla lista.
+     *                         collega bottone allo slot 'searchMediaByName' e crea la vista della lista dei media (con righe di altezza uniforme
+     *                         e selezione singola). Il modello della lista viene impostato in 'setController'.
      */
     void setupLeftPanel();
 
@@ -11,14 +11,28 @@ HEADERS += \
     Model/Builders/IBuilder.h \
     Model/Builders/ImageBuilder.h \
     Model/Builders/VideoBuilder.h \
+    Model/Library/BinarySnapshot.h \
+    Model/Library/Command/BatchCommand.h \
+    Model/Library/Command/BulkEditCommand.h \
+    Model/Library/Command/BulkRemoveCommand.h \
     Model/Library/Command/EditCommand.h \
     Model/Library/Command/IAbstractCommand.h \
     Model/Library/Command/InsertCommand.h \
     Model/Library/Command/RemoveCommand.h \
+    Model/Library/ILibraryObserver.h \
+    Model/Library/JsonStreamReader.h \
+    Model/Library/JsonStreamWriter.h \
     Model/Library/Library.h \
+    Model/Library/LibraryJournal.h \
     Model/Library/Manager.h \
+    Model/Library/MappedSnapshot.h \
+    Model/Library/FilterKernels.h \
+    Model/Library/MediaColumns.h \
     Model/Library/MediaFactory.h \
+    Model/Library/ScoreKernels.h \
+    Model/Library/SearchIndex.h \
     Model/Library/SearchQuery.h \
+    Model/Loggers/IBufferLogger.h \
     Model/Loggers/IConsoleLogger.h \
     Model/Loggers/IFileLogger.h \
     Model/Loggers/IMediaLogger.h \
@@ -31,14 +45,21 @@ HEADERS += \
     Model/Media/Video.h \
     Model/Utilities/IMediaLength.h \
     Model/Utilities/IMediaResolution.h \
+    Model/Visitors/AttributeReader.h \
+    Model/Visitors/ColumnVisitor.h \
     Model/Visitors/ConcisePrinter.h \
     Model/Visitors/DetailedPrinter.h \
     Model/Visitors/IConstVisitor.h \
     Model/Visitors/IVisitor.h \
+    Model/Visitors/IndexVisitor.h \
+    Model/Visitors/JsonRecordDecoder.h \
+    Model/Visitors/JsonRecordEncoder.h \
     Model/Visitors/MediaEditor.h \
     Model/Visitors/MediaValidator.h \
     Model/Visitors/ScoreVisitor.h \
     Model/Visitors/SearchVisitor.h \
+    Model/Visitors/SnapshotDecoder.h \
+    Model/Visitors/SnapshotEncoder.h \
     View/Creator/AudioCreator.h \
     View/Creator/EBookCreator.h \
     View/Creator/ImageCreator.h \
@@ -52,9 +73,10 @@ HEADERS += \
     View/Editor/VideoEditor.h \
     View/Search/SearchWidget.h \
     View/Viewer/AudioViewer.h \
-    View/Viewer/ConciseViewer.h \
+    View/Viewer/ConciseDelegate.h \
     View/Viewer/EBookViewer.h \
     View/Viewer/ImageViewer.h \
+    View/Viewer/MediaListModel.h \
     View/Viewer/MediaViewerFactory.h \
     View/Viewer/VideoViewer.h \
     View/Window.h
@@ -65,24 +87,43 @@ SOURCES += \
     Model/Builders/EBookBuilder.cpp \
     Model/Builders/ImageBuilder.cpp \
     Model/Builders/VideoBuilder.cpp \
+    Model/Library/BinarySnapshot.cpp \
+    Model/Library/Command/BatchCommand.cpp \
+    Model/Library/Command/BulkEditCommand.cpp \
+    Model/Library/Command/BulkRemoveCommand.cpp \
     Model/Library/Command/EditCommand.cpp \
     Model/Library/Command/InsertCommand.cpp \
     Model/Library/Command/RemoveCommand.cpp \
+    Model/Library/JsonStreamReader.cpp \
+    Model/Library/JsonStreamWriter.cpp \
     Model/Library/Library.cpp \
+    Model/Library/LibraryJournal.cpp \
     Model/Library/Manager.cpp \
+    Model/Library/MappedSnapshot.cpp \
+    Model/Library/FilterKernels.cpp \
+    Model/Library/MediaColumns.cpp \
     Model/Library/MediaFactory.cpp \
+    Model/Library/ScoreKernels.cpp \
+    Model/Library/SearchIndex.cpp \
     Model/Media/AbstractFile.cpp \
     Model/Media/AbstractMedia.cpp \
     Model/Media/Audio.cpp \
     Model/Media/EBook.cpp \
     Model/Media/Image.cpp \
     Model/Media/Video.cpp \
+    Model/Visitors/AttributeReader.cpp \
+    Model/Visitors/ColumnVisitor.cpp \
     Model/Visitors/ConcisePrinter.cpp \
     Model/Visitors/DetailedPrinter.cpp \
+    Model/Visitors/IndexVisitor.cpp \
+    Model/Visitors/JsonRecordDecoder.cpp \
+    Model/Visitors/JsonRecordEncoder.cpp \
     Model/Visitors/MediaEditor.cpp \
     Model/Visitors/MediaValidator.cpp \
     Model/Visitors/ScoreVisitor.cpp \
     Model/Visitors/SearchVisitor.cpp \
+    Model/Visitors/SnapshotDecoder.cpp \
+    Model/Visitors/SnapshotEncoder.cpp \
     View/Creator/AudioCreator.cpp \
     View/Creator/EBookCreator.cpp \
     View/Creator/ImageCreator.cpp \
@@ -96,9 +137,10 @@ SOURCES += \
     View/Editor/VideoEditor.cpp \
     View/Search/SearchWidget.cpp \
     View/Viewer/AudioViewer.cpp \
-    View/Viewer/ConciseViewer.cpp \
+    View/Viewer/ConciseDelegate.cpp \
     View/Viewer/EBookViewer.cpp \
     View/Viewer/ImageViewer.cpp \
+    View/Viewer/MediaListModel.cpp \
     View/Viewer/MediaViewerFactory.cpp \
     View/Viewer/VideoViewer.cpp \
     View/Window.cpp \